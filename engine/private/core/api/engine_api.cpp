@@ -2,7 +2,32 @@
 #include "core/api/engine_api.h"
 
 
-void create_mesh_entity(
+MeshHandle find_or_load_mesh(const char* path) {
+    auto renderer = GEngine->get_renderer();
+
+    if (!renderer->_mesh_paths.contains(path)) {
+        const MeshHandle mesh       = renderer->add_mesh(ObjectLoader::load_mesh(path));
+        renderer->_mesh_paths[path] = {mesh};
+
+        GEngine->get_asset_registry().register_mesh(mesh, path);
+    }
+
+    return renderer->_mesh_paths[path][0];
+}
+
+MaterialHandle find_material(const char* material_tag) {
+    auto renderer = GEngine->get_renderer();
+
+    if (!renderer->_material_names.contains(material_tag)) {
+        spdlog::error("Material '{}' not registered!", material_tag);
+        return {};
+    }
+
+    return renderer->_material_names[material_tag][0];
+}
+
+
+flecs::entity create_mesh_entity(
     const char* name,
     const char* path,
     const glm::vec3& position,
@@ -10,26 +35,185 @@ void create_mesh_entity(
     const glm::vec3& scale,
     const char* material_tag) {
 
-    auto renderer = GEngine->get_renderer();
+    const MeshHandle mesh         = find_or_load_mesh(path);
+    const MaterialHandle material = find_material(material_tag);
 
-    if (!renderer->_meshes.contains(path)) {
-        MeshInstance3D mesh = ObjectLoader::load_mesh(path);
-        renderer->_meshes[path] = {mesh};
+    if (material.is_null()) {
+        return flecs::entity::null();
     }
 
-    if (!renderer->_materials.contains(material_tag)) {
-        spdlog::error("Material '{}' not registered!", material_tag);
-        return;
-    }
+    auto& assets = GEngine->get_asset_registry();
+    assets.acquire(AssetId::mesh(mesh));
+    assets.acquire(AssetId::material(material));
 
-    GEngine->get_world().entity(name)
+    auto entity = GEngine->get_world().entity(name)
            .set(Transform3D{position, rotation, scale})
-           .set(MeshRef{&renderer->_meshes[path][0]})
-           .set(MaterialRef{&renderer->_materials[material_tag][0]});
+           .set(MeshRef{mesh})
+           .set(MaterialRef{material});
 
     spdlog::info("MeshInstance3D entity '{}' created with material '{}'.", name, material_tag);
+
+    return entity;
+}
+
+
+std::vector<flecs::entity_t> create_mesh_entities(
+    const char* path,
+    std::span<const Transform3D> transforms,
+    const char* material_tag,
+    bool is_static,
+    const char* name_prefix) {
+
+    const MeshHandle mesh         = find_or_load_mesh(path);
+    const MaterialHandle material = find_material(material_tag);
+
+    if (material.is_null() || transforms.empty()) {
+        return {};
+    }
+
+    auto& assets = GEngine->get_asset_registry();
+    assets.acquire(AssetId::mesh(mesh));
+    assets.acquire(AssetId::material(material));
+
+    const auto& world = GEngine->get_world();
+    const auto count  = static_cast<int32_t>(transforms.size());
+
+    // Columns are moved straight into the table (`ecs_bulk_init` moves from them), the caller's transforms are copied first.
+    // Every entity shares the same mesh and material.
+    std::vector<Transform3D> columns(transforms.begin(), transforms.end());
+    std::vector<MeshRef> meshes(count, MeshRef{mesh});
+    std::vector<MaterialRef> materials(count, MaterialRef{material});
+
+    ecs_bulk_desc_t desc{};
+    desc.count  = count;
+    desc.ids[0] = world.id<Transform3D>();
+    desc.ids[1] = world.id<MeshRef>();
+    desc.ids[2] = world.id<MaterialRef>();
+    desc.ids[3] = is_static ? world.id<Static>() : 0;
+
+    void* data[] = {columns.data(), meshes.data(), materials.data(), nullptr};
+    desc.data    = data;
+
+    const ecs_entity_t* created = ecs_bulk_init(world, &desc);
+    std::vector<flecs::entity_t> entities(created, created + count);
+
+    if (name_prefix) {
+        const ecs_entity_t scope = ecs_get_scope(world);
+        int32_t skipped          = 0;
+
+        for (int32_t i = 0; i < count; ++i) {
+            const std::string name = fmt::format("{}_{}", name_prefix, i);
+
+            // Names are unique per scope, a prefix reused across calls leaves the later entities anonymous
+            if (ecs_lookup_child(world, scope, name.c_str())) {
+                skipped++;
+                continue;
+            }
+
+            ecs_set_name(world, entities[i], name.c_str());
+        }
+
+        if (skipped > 0) {
+            spdlog::warn("create_mesh_entities - {} entities left unnamed, '{}_<index>' names already exist", skipped, name_prefix);
+        }
+    }
+
+    spdlog::info("{} MeshInstance3D entities created from '{}' with material '{}'.", count, path, material_tag);
+
+    return entities;
+}
+
+
+bool is_model_loaded(const std::string& path) {
+    const auto renderer = GEngine->get_renderer();
+    return renderer->_mesh_paths.contains(path) && renderer->_material_names.contains(path);
+}
+
+void register_model(const std::string& path, Model model) {
+    auto renderer = GEngine->get_renderer();
+    auto& assets  = GEngine->get_asset_registry();
+
+    // Parts left from an unloaded copy are still destroyed by the registry, mesh i must pair with material i
+    auto& meshes    = renderer->_mesh_paths[path];
+    auto& materials = renderer->_material_names[path];
+    meshes.clear();
+    materials.clear();
+
+    for (auto& mesh : model.meshes) {
+        meshes.push_back(renderer->add_mesh(std::move(mesh)));
+        assets.register_mesh(meshes.back(), path);
+    }
+
+    for (const auto& material : model.materials) {
+        assets.register_material(renderer->add_material(path, material));
+    }
+}
+
+ModelLoadBatch::ModelLoadBatch(std::vector<std::string> paths)
+    : _paths(std::move(paths)), _loaded(std::make_unique<std::atomic<bool>[]>(_paths.size())) {
+}
+
+bool ModelLoadBatch::is_done() const {
+    return _counter.is_done();
 }
 
+void ModelLoadBatch::wait() {
+    GEngine->get_job_system().wait(_counter);
+}
+
+const std::vector<std::string>& ModelLoadBatch::get_paths() const {
+    return _paths;
+}
+
+bool ModelLoadBatch::is_loaded(size_t index) const {
+    return index < _paths.size() && _loaded[index].load(std::memory_order_acquire);
+}
+
+std::shared_ptr<ModelLoadBatch> load_models_async(const std::vector<std::string>& paths) {
+    auto batch = std::make_shared<ModelLoadBatch>(paths);
+    auto& jobs = GEngine->get_job_system();
+
+    std::unordered_set<std::string> scheduled;
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const std::string& path = paths[i];
+
+        if (is_model_loaded(path)) {
+            batch->_loaded[i] = true;
+            continue;
+        }
+
+        // A path listed twice is imported once, its other entries are resolved after the upload
+        if (!scheduled.insert(path).second) {
+            continue;
+        }
+
+        jobs.schedule([batch, path] {
+            auto imported = std::make_shared<ImportedModel>();
+
+            if (!ObjectLoader::import_model(path, *imported)) {
+                return;
+            }
+
+            // Scheduled before this job finishes, the counter can't reach zero in between
+            GEngine->get_job_system().schedule_main_thread([batch, path, imported] {
+                if (!is_model_loaded(path)) {
+                    register_model(path, ObjectLoader::upload_model(*imported));
+                }
+
+                for (size_t j = 0; j < batch->_paths.size(); ++j) {
+                    if (batch->_paths[j] == path) {
+                        batch->_loaded[j].store(true, std::memory_order_release);
+                    }
+                }
+            }, &batch->_counter);
+        }, &batch->_counter);
+    }
+
+    spdlog::info("load_models_async - {} models scheduled", scheduled.size());
+
+    return batch;
+}
 
 void create_model_entity(
     const char* name,
@@ -39,24 +223,27 @@ void create_model_entity(
     const glm::vec3& scale) {
 
     auto renderer = GEngine->get_renderer();
+    auto& assets  = GEngine->get_asset_registry();
 
-
-  if (!renderer->_meshes.contains(path) || !renderer->_materials.contains(path)) {
-        Model model = ObjectLoader::load_model(path);
-        renderer->_meshes[path]    = model.meshes;
-        renderer->_materials[path] = model.materials;
+    if (!is_model_loaded(path)) {
+        register_model(path, ObjectLoader::load_model(path));
     }
 
-    const auto& meshes    = renderer->_meshes[path];
-    const auto& materials = renderer->_materials[path];
+    const auto& meshes    = renderer->_mesh_paths[path];
+    const auto& materials = renderer->_material_names[path];
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        assets.acquire(AssetId::mesh(meshes[i]));
+        assets.acquire(AssetId::material(materials[i]));
+    }
 
     auto entity = GEngine->get_world().entity(name);
 
     for (size_t i = 0; i < meshes.size(); ++i) {
         entity.child()
             .set(Transform3D{position, rotation, scale})
-            .set(MeshRef{&meshes[i]})
-            .set(MaterialRef{&materials[i]});
+            .set(MeshRef{meshes[i]})
+            .set(MaterialRef{materials[i]});
     }
 
     spdlog::info("MeshInstance3D entity '{}' created with {} mesh parts.", name, meshes.size());
@@ -64,5 +251,9 @@ void create_model_entity(
 
 
 void create_material(const char* name, const Material& material) {
-    GEngine->get_renderer()->register_material(name,material);
+    auto& assets = GEngine->get_asset_registry();
+
+    const MaterialHandle handle = GEngine->get_renderer()->register_material(name, material);
+    assets.register_material(handle);
+    assets.acquire(AssetId::material(handle));
 }
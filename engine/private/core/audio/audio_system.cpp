@@ -0,0 +1,484 @@
+#include "core/audio/audio_system.h"
+
+namespace {
+
+/// Mixed sources win ties against virtual ones by this margin, equal emitters don't trade voices every frame
+constexpr float VOICE_HYSTERESIS = 1.25f;
+
+} // namespace
+
+AudioSystem::~AudioSystem() {
+    shutdown();
+}
+
+bool AudioSystem::initialize(const AudioDevice& settings) {
+    if (_is_initialized) {
+        return true;
+    }
+
+    _settings = settings;
+
+    if (!settings.is_enabled) {
+        spdlog::info("AudioSystem::initialize - Audio disabled");
+        return true;
+    }
+
+    ember_init_ma_vfs(&_vfs);
+
+    ma_engine_config config    = ma_engine_config_init();
+    config.pResourceManagerVFS = &_vfs;
+
+    if (settings.is_offline) {
+        // Without a device miniaudio can't pick a format, `render` pulls stereo
+        config.noDevice   = MA_TRUE;
+        config.channels   = 2;
+        config.sampleRate = settings.sample_rate > 0 ? static_cast<ma_uint32>(settings.sample_rate) : 48000;
+    } else {
+        if (settings.is_null_device) {
+            const ma_backend backend = ma_backend_null;
+
+            if (const ma_result result = ma_context_init(&backend, 1, nullptr, &_context); result != MA_SUCCESS) {
+                spdlog::error("AudioSystem::initialize - Failed to create the null device context: {}", ma_result_description(result));
+                return false;
+            }
+
+            _has_context = true;
+        }
+
+        ma_device_config device_config = ma_device_config_init(ma_device_type_playback);
+        device_config.playback.format  = ma_format_f32;
+        device_config.sampleRate       = static_cast<ma_uint32>(std::max(0, settings.sample_rate));
+        device_config.dataCallback     = device_callback;
+        device_config.pUserData        = this;
+
+        if (const ma_result result = ma_device_init(_has_context ? &_context : nullptr, &device_config, &_device); result != MA_SUCCESS) {
+            spdlog::error("AudioSystem::initialize - Failed to open the audio device: {}", ma_result_description(result));
+
+            if (_has_context) {
+                ma_context_uninit(&_context);
+                _has_context = false;
+            }
+
+            return false;
+        }
+
+        _has_device    = true;
+        config.pDevice = &_device;
+    }
+
+    if (const ma_result result = ma_engine_init(&config, &_engine); result != MA_SUCCESS) {
+        spdlog::error("AudioSystem::initialize - Failed to start the audio engine: {}", ma_result_description(result));
+
+        if (_has_device) {
+            ma_device_uninit(&_device);
+            _has_device = false;
+        }
+
+        if (_has_context) {
+            ma_context_uninit(&_context);
+            _has_context = false;
+        }
+
+        return false;
+    }
+
+    _voices = std::make_unique<Voice[]>(settings.max_voices);
+
+    // Popped from the back, voice 0 is handed out first
+    for (int i = settings.max_voices - 1; i >= 0; --i) {
+        _free_voices.push_back(i);
+    }
+
+    _is_initialized = true;
+
+    spdlog::info("AudioSystem::initialize - {} Hz, {} voices{}", ma_engine_get_sample_rate(&_engine), settings.max_voices,
+                 settings.is_offline ? " (offline)" : settings.is_null_device ? " (null device)" : "");
+
+    return true;
+}
+
+void AudioSystem::shutdown() {
+    // Queries die with the world, which outlives this call but not the system
+    _source_query.reset();
+    _listener_query.reset();
+
+    if (!_is_initialized) {
+        return;
+    }
+
+    for (int i = 0; i < _settings.max_voices; ++i) {
+        if (_voices[i].is_initialized) {
+            ma_sound_uninit(&_voices[i].sound);
+        }
+    }
+
+    _voices.reset();
+    _free_voices.clear();
+    _sources.clear();
+    _candidates.clear();
+
+    for (auto& [path, sample] : _samples) {
+        ma_sound_uninit(&sample->prototype);
+    }
+
+    _samples.clear();
+
+    // Stops the device, which the engine doesn't own
+    ma_engine_uninit(&_engine);
+
+    if (_has_device) {
+        ma_device_uninit(&_device);
+        _has_device = false;
+    }
+
+    if (_has_context) {
+        ma_context_uninit(&_context);
+        _has_context = false;
+    }
+
+    _is_initialized = false;
+    _stats          = {};
+
+    reset_mixer_stats();
+}
+
+bool AudioSystem::is_initialized() const {
+    return _is_initialized;
+}
+
+void AudioSystem::setup(flecs::world& world) {
+    _source_query   = world.query<AudioSource, const Transform3D*>();
+    _listener_query = world.query<const AudioListener, const Transform3D, const Camera3D*>();
+
+    // Deleted entities, or entities losing the component, stop right away
+    world.observer<AudioSource>("ReleaseAudioVoice")
+         .event(flecs::OnRemove)
+         .each([this](flecs::entity entity, AudioSource&) {
+             const auto it = _sources.find(entity.id());
+             if (it == _sources.end()) {
+                 return;
+             }
+
+             release_voice(it->second);
+             _sources.erase(it);
+         });
+}
+
+void AudioSystem::update(float delta) {
+    if (!_is_initialized || !_source_query) {
+        return;
+    }
+
+    glm::vec3 listener_position{0.0f};
+    bool has_listener = false;
+
+    _listener_query->each([this, &listener_position, &has_listener](const AudioListener& listener, const Transform3D& transform, const Camera3D* camera) {
+        if (has_listener) {
+            return;
+        }
+
+        // Rows of the view matrix are the listener axes
+        const glm::mat4 view    = camera ? camera->get_view(transform) : glm::inverse(transform.get_matrix());
+        const glm::vec3 forward = -glm::normalize(glm::vec3(view[0][2], view[1][2], view[2][2]));
+        const glm::vec3 up      = glm::normalize(glm::vec3(view[0][1], view[1][1], view[2][1]));
+
+        listener_position = transform.position;
+        has_listener      = true;
+
+        ma_engine_listener_set_position(&_engine, 0, listener_position.x, listener_position.y, listener_position.z);
+        ma_engine_listener_set_direction(&_engine, 0, forward.x, forward.y, forward.z);
+        ma_engine_listener_set_world_up(&_engine, 0, up.x, up.y, up.z);
+        ma_engine_set_volume(&_engine, listener.volume);
+    });
+
+    _candidates.clear();
+    _stats = {};
+
+    _source_query->each([this, delta, &listener_position](flecs::entity entity, AudioSource& source, const Transform3D* transform) {
+        auto& state = _sources[entity.id()];
+
+        if (!source.is_playing) {
+            if (state.is_active) {
+                release_voice(state);
+                state.is_active = false;
+            }
+            return;
+        }
+
+        bool is_finished = false;
+
+        if (!state.is_active) {
+            state.is_active = true;
+            state.cursor    = 0.0f;
+
+            // Decoded on the first play, gives the length virtual playback needs
+            if (!source.is_streamed) {
+                Sample* sample = get_sample(source.path);
+
+                if (!sample) {
+                    source.is_playing = false;
+                    state.is_active   = false;
+                    return;
+                }
+
+                ma_sound_get_length_in_seconds(&sample->prototype, &state.length);
+            }
+        } else if (state.voice >= 0) {
+            is_finished = !source.is_looping && ma_sound_at_end(&_voices[state.voice].sound);
+        } else {
+            state.cursor += delta * source.pitch;
+
+            if (state.length > 0.0f && state.cursor >= state.length) {
+                if (source.is_looping) {
+                    state.cursor = std::fmod(state.cursor, state.length);
+                } else {
+                    is_finished = true;
+                }
+            }
+        }
+
+        if (is_finished) {
+            release_voice(state);
+            state.is_active   = false;
+            source.is_playing = false;
+            return;
+        }
+
+        const glm::vec3 position = transform ? transform->position : listener_position;
+        const float attenuation  = source.is_spatial ? compute_attenuation(source, glm::distance(position, listener_position)) : 1.0f;
+
+        _candidates.push_back({entity.id(), &source, &state, position, source.volume * attenuation});
+    });
+
+    const auto is_more_important = [](const Candidate& a, const Candidate& b) {
+        if (a.source->priority != b.source->priority) {
+            return a.source->priority > b.source->priority;
+        }
+
+        const float a_gain = a.state->voice >= 0 ? a.gain * VOICE_HYSTERESIS : a.gain;
+        const float b_gain = b.state->voice >= 0 ? b.gain * VOICE_HYSTERESIS : b.gain;
+        return a_gain > b_gain;
+    };
+
+    const size_t voice_count = std::min(_candidates.size(), static_cast<size_t>(_settings.max_voices));
+
+    if (voice_count < _candidates.size()) {
+        std::nth_element(_candidates.begin(), _candidates.begin() + static_cast<std::ptrdiff_t>(voice_count), _candidates.end(), is_more_important);
+    }
+
+    // Voices of the sources that dropped out go to the ones that made it
+    for (size_t i = voice_count; i < _candidates.size(); ++i) {
+        if (auto& candidate = _candidates[i]; candidate.state->voice >= 0) {
+            release_voice(*candidate.state);
+            _stats.stolen++;
+        }
+    }
+
+    for (size_t i = 0; i < voice_count; ++i) {
+        auto& candidate = _candidates[i];
+
+        if (candidate.state->voice >= 0) {
+            apply(_voices[candidate.state->voice].sound, *candidate.source, candidate.position);
+            continue;
+        }
+
+        if (!start_voice(candidate.entity, *candidate.source, *candidate.state)) {
+            // Unreadable sound, stopped rather than retried every frame
+            candidate.source->is_playing = false;
+            candidate.state->is_active   = false;
+            continue;
+        }
+
+        apply(_voices[candidate.state->voice].sound, *candidate.source, candidate.position);
+        ma_sound_start(&_voices[candidate.state->voice].sound);
+    }
+
+    _stats.sources         = static_cast<int>(_candidates.size());
+    _stats.voices          = _settings.max_voices - static_cast<int>(_free_voices.size());
+    _stats.virtual_sources = _stats.sources - _stats.voices;
+    _stats.samples         = static_cast<int>(_samples.size());
+}
+
+bool AudioSystem::preload(const std::string& path) {
+    return _is_initialized && get_sample(path) != nullptr;
+}
+
+void AudioSystem::unload(const std::string& path) {
+    const auto it = _samples.find(path);
+    if (it == _samples.end()) {
+        return;
+    }
+
+    ma_sound_uninit(&it->second->prototype);
+    _samples.erase(it);
+}
+
+Uint64 AudioSystem::render(float seconds, std::vector<float>& out, Uint32 period_frames) {
+    if (!_is_initialized || !_settings.is_offline || seconds <= 0.0f || period_frames == 0) {
+        return 0;
+    }
+
+    const Uint32 channels = ma_engine_get_channels(&_engine);
+    // Rounded, a float tick like 0.01 s is a hair short of its 480 frames at 48 kHz
+    const Uint64 frames   = static_cast<Uint64>(std::llround(static_cast<double>(seconds) * ma_engine_get_sample_rate(&_engine)));
+
+    const size_t offset = out.size();
+    out.resize(offset + frames * channels);
+
+    for (Uint64 frame = 0; frame < frames; frame += period_frames) {
+        const auto count = static_cast<Uint32>(std::min<Uint64>(period_frames, frames - frame));
+        mix(out.data() + offset + frame * channels, count);
+    }
+
+    return frames;
+}
+
+const AudioStats& AudioSystem::get_stats() const {
+    return _stats;
+}
+
+MixerStats AudioSystem::get_mixer_stats() const {
+    MixerStats stats;
+    stats.callbacks = _mix_callbacks.load(std::memory_order_relaxed);
+    stats.frames    = _mix_frames.load(std::memory_order_relaxed);
+    stats.underruns = _mix_underruns.load(std::memory_order_relaxed);
+    stats.max_ms    = static_cast<double>(_mix_max_ns.load(std::memory_order_relaxed)) / 1e6;
+
+    if (stats.callbacks > 0) {
+        stats.average_ms = static_cast<double>(_mix_time_ns.load(std::memory_order_relaxed)) / 1e6 / static_cast<double>(stats.callbacks);
+    }
+
+    return stats;
+}
+
+void AudioSystem::reset_mixer_stats() {
+    _mix_callbacks.store(0, std::memory_order_relaxed);
+    _mix_frames.store(0, std::memory_order_relaxed);
+    _mix_underruns.store(0, std::memory_order_relaxed);
+    _mix_time_ns.store(0, std::memory_order_relaxed);
+    _mix_max_ns.store(0, std::memory_order_relaxed);
+}
+
+ma_engine* AudioSystem::get_engine() {
+    return _is_initialized ? &_engine : nullptr;
+}
+
+void AudioSystem::device_callback(ma_device* device, void* output, const void*, ma_uint32 frame_count) {
+    static_cast<AudioSystem*>(device->pUserData)->mix(static_cast<float*>(output), frame_count);
+}
+
+void AudioSystem::mix(float* output, Uint32 frame_count) {
+    const Uint64 start = SDL_GetTicksNS();
+    ma_engine_read_pcm_frames(&_engine, output, frame_count, nullptr);
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+
+    // Time the period takes to play, mixing slower starves the device
+    const Uint64 budget = static_cast<Uint64>(frame_count) * SDL_NS_PER_SECOND / ma_engine_get_sample_rate(&_engine);
+
+    _mix_callbacks.fetch_add(1, std::memory_order_relaxed);
+    _mix_frames.fetch_add(frame_count, std::memory_order_relaxed);
+    _mix_time_ns.fetch_add(elapsed, std::memory_order_relaxed);
+
+    if (elapsed > budget) {
+        _mix_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Single writer, the mixer runs on one thread at a time
+    if (elapsed > _mix_max_ns.load(std::memory_order_relaxed)) {
+        _mix_max_ns.store(elapsed, std::memory_order_relaxed);
+    }
+}
+
+AudioSystem::Sample* AudioSystem::get_sample(const std::string& path) {
+    if (const auto it = _samples.find(path); it != _samples.end()) {
+        return it->second.get();
+    }
+
+    auto sample = std::make_unique<Sample>();
+
+    if (const ma_result result = ma_sound_init_from_file(&_engine, path.c_str(), MA_SOUND_FLAG_DECODE, nullptr, nullptr, &sample->prototype);
+        result != MA_SUCCESS) {
+        spdlog::error("AudioSystem - Failed to decode {}: {}", path, ma_result_description(result));
+        return nullptr;
+    }
+
+    return _samples.emplace(path, std::move(sample)).first->second.get();
+}
+
+bool AudioSystem::start_voice(Uint64 entity, const AudioSource& source, SourceState& state) {
+    if (_free_voices.empty()) {
+        return false;
+    }
+
+    const int index = _free_voices.back();
+    Voice& voice    = _voices[index];
+
+    ma_result result = MA_DOES_NOT_EXIST;
+
+    if (source.is_streamed) {
+        result = ma_sound_init_from_file(&_engine, source.path.c_str(), MA_SOUND_FLAG_STREAM, nullptr, nullptr, &voice.sound);
+    } else if (const Sample* sample = get_sample(source.path)) {
+        result = ma_sound_init_copy(&_engine, &sample->prototype, 0, nullptr, &voice.sound);
+    }
+
+    if (result != MA_SUCCESS) {
+        spdlog::error("AudioSystem - Failed to play {}: {}", source.path, ma_result_description(result));
+        return false;
+    }
+
+    _free_voices.pop_back();
+
+    voice.is_initialized = true;
+    voice.entity         = entity;
+    state.voice          = index;
+
+    if (state.length < 0.0f) {
+        ma_sound_get_length_in_seconds(&voice.sound, &state.length);
+    }
+
+    // Resumes where the source would be had it kept its voice
+    if (state.cursor > 0.0f) {
+        ma_sound_seek_to_second(&voice.sound, state.cursor);
+    }
+
+    return true;
+}
+
+void AudioSystem::release_voice(SourceState& state) {
+    if (state.voice < 0) {
+        return;
+    }
+
+    Voice& voice = _voices[state.voice];
+
+    if (float cursor = 0.0f; ma_sound_get_cursor_in_seconds(&voice.sound, &cursor) == MA_SUCCESS) {
+        state.cursor = cursor;
+    }
+
+    ma_sound_uninit(&voice.sound);
+    voice.is_initialized = false;
+    voice.entity         = 0;
+
+    _free_voices.push_back(state.voice);
+    state.voice = -1;
+}
+
+void AudioSystem::apply(ma_sound& sound, const AudioSource& source, const glm::vec3& position) {
+    ma_sound_set_volume(&sound, source.volume);
+    ma_sound_set_pitch(&sound, source.pitch);
+    ma_sound_set_looping(&sound, source.is_looping);
+    ma_sound_set_spatialization_enabled(&sound, source.is_spatial);
+
+    if (source.is_spatial) {
+        ma_sound_set_position(&sound, position.x, position.y, position.z);
+        ma_sound_set_min_distance(&sound, source.min_distance);
+        ma_sound_set_max_distance(&sound, source.max_distance);
+    }
+}
+
+float AudioSystem::compute_attenuation(const AudioSource& source, float distance) {
+    const float min_distance = std::max(source.min_distance, 0.0001f);
+    const float clamped      = std::clamp(distance, min_distance, std::max(source.max_distance, min_distance));
+
+    return min_distance / clamped;
+}
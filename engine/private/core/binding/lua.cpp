@@ -0,0 +1,334 @@
+#include "core/binding/lua.h"
+
+namespace {
+
+LuaBindingContext* get_context(lua_State* L) {
+    return static_cast<LuaBindingContext*>(lua_touserdata(L, lua_upvalueindex(1)));
+}
+
+flecs::world_t* get_world(lua_State* L) {
+    return get_context(L)->world;
+}
+
+flecs::entity_t check_entity(lua_State* L, int index) {
+    luaL_checktype(L, index, LUA_TLIGHTUSERDATA);
+    return static_cast<flecs::entity_t>(reinterpret_cast<uintptr_t>(lua_touserdata(L, index)));
+}
+
+/// nullptr for dead entities, they can be deleted by another script earlier in the frame
+template <typename T>
+T* find_component(lua_State* L, int index) {
+    flecs::world_t* world        = get_world(L);
+    const flecs::entity_t entity = check_entity(L, index);
+
+    if (!world || !ecs_is_alive(world, entity)) {
+        return nullptr;
+    }
+
+    return flecs::entity(world, entity).try_get_mut<T>();
+}
+
+template <glm::vec3 Transform3D::* Field>
+int get_transform_field(lua_State* L) {
+    const Transform3D* transform = find_component<Transform3D>(L, 1);
+    if (!transform) {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    const glm::vec3& value = transform->*Field;
+    lua_pushnumber(L, value.x);
+    lua_pushnumber(L, value.y);
+    lua_pushnumber(L, value.z);
+    return 3;
+}
+
+template <glm::vec3 Transform3D::* Field, ScriptCommand::Type Command>
+int set_transform_field(lua_State* L) {
+    // Another worker may be reading that entity, the write waits for the main thread
+    if (const LuaBindingContext* context = get_context(L); context->commands && check_entity(L, 1) != context->self) {
+        context->commands->push_back({Command, check_entity(L, 1),
+                                      {static_cast<float>(luaL_checknumber(L, 2)), static_cast<float>(luaL_checknumber(L, 3)),
+                                       static_cast<float>(luaL_checknumber(L, 4))}});
+        return 0;
+    }
+
+    Transform3D* transform = find_component<Transform3D>(L, 1);
+    if (!transform) {
+        return luaL_error(L, "entity has no Transform3D");
+    }
+
+    transform->*Field = {static_cast<float>(luaL_checknumber(L, 2)), static_cast<float>(luaL_checknumber(L, 3)),
+                         static_cast<float>(luaL_checknumber(L, 4))};
+
+    // `RunScripts` only marks the tables of scripted entities changed, extraction and snapshots must see this one too (deferred on the stage)
+    if (const flecs::entity_t entity = check_entity(L, 1); entity != get_context(L)->self) {
+        flecs::entity(get_world(L), entity).modified<Transform3D>();
+    }
+
+    return 0;
+}
+
+int is_alive(lua_State* L) {
+    flecs::world_t* world = get_world(L);
+    lua_pushboolean(L, world && ecs_is_alive(world, check_entity(L, 1)));
+    return 1;
+}
+
+int get_id(lua_State* L) {
+    lua_pushinteger(L, static_cast<lua_Integer>(check_entity(L, 1)));
+    return 1;
+}
+
+int get_name(lua_State* L) {
+    flecs::world_t* world        = get_world(L);
+    const flecs::entity_t entity = check_entity(L, 1);
+
+    const char* name = world && ecs_is_alive(world, entity) ? ecs_get_name(world, entity) : nullptr;
+    if (!name) {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    lua_pushstring(L, name);
+    return 1;
+}
+
+int lookup(lua_State* L) {
+    flecs::world_t* world        = get_world(L);
+    const flecs::entity_t entity = world ? ecs_lookup(world, luaL_checkstring(L, 1)) : 0;
+
+    if (!entity) {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    push_entity(L, entity);
+    return 1;
+}
+
+int destruct(lua_State* L) {
+    flecs::world_t* world        = get_world(L);
+    const flecs::entity_t entity = check_entity(L, 1);
+
+    if (const LuaBindingContext* context = get_context(L); context->commands) {
+        context->commands->push_back({ScriptCommand::Type::DESTRUCT, entity});
+        return 0;
+    }
+
+    // Deferred while the scripts run, the entity stays readable until the end of the frame
+    if (world && ecs_is_alive(world, entity)) {
+        ecs_delete(world, entity);
+    }
+
+    return 0;
+}
+
+/// Rows of one table matched by the transform query, only valid during the `ecs.each_transform` callback it was passed to
+struct TransformView {
+    Transform3D* rows               = nullptr;
+    const flecs::entity_t* entities = nullptr;
+    int count                       = 0;
+    Uint64 epoch                    = 0;
+    LuaBindingContext* context      = nullptr;
+};
+
+/// One vec3 field of every row of a view, strided over the table column (no copy)
+struct Vec3Column {
+    std::byte* first             = nullptr;
+    int count                    = 0;
+    flecs::entity_t first_entity = 0; ///< Marks the table changed on the first `set`
+    Uint64 epoch                 = 0;
+    LuaBindingContext* context   = nullptr;
+};
+
+bool is_current(const LuaBindingContext* context, Uint64 epoch) {
+    return context->is_iterating && context->view_epoch == epoch;
+}
+
+template <typename T>
+T& check_view(lua_State* L, const char* name) {
+    if (!sol::stack::check<T>(L, 1)) {
+        luaL_typeerror(L, 1, name);
+    }
+
+    T& view = sol::stack::get<T&>(L, 1);
+    if (!is_current(view.context, view.epoch)) {
+        luaL_error(L, "%s used outside its ecs.each_transform callback", name);
+    }
+
+    return view;
+}
+
+/// Lua index (1-based) to row
+int check_row(lua_State* L, int index, int count) {
+    const lua_Integer i = luaL_checkinteger(L, index);
+    luaL_argcheck(L, i >= 1 && i <= count, index, "row out of range");
+    return static_cast<int>(i - 1);
+}
+
+glm::vec3& get_element(const Vec3Column& column, int row) {
+    return *reinterpret_cast<glm::vec3*>(column.first + static_cast<size_t>(row) * sizeof(Transform3D));
+}
+
+int column_get(lua_State* L) {
+    const Vec3Column& column = check_view<Vec3Column>(L, "column");
+    const glm::vec3& value   = get_element(column, check_row(L, 2, column.count));
+
+    lua_pushnumber(L, value.x);
+    lua_pushnumber(L, value.y);
+    lua_pushnumber(L, value.z);
+    return 3;
+}
+
+int column_set(lua_State* L) {
+    const Vec3Column& column = check_view<Vec3Column>(L, "column");
+
+    get_element(column, check_row(L, 2, column.count)) = {static_cast<float>(luaL_checknumber(L, 3)), static_cast<float>(luaL_checknumber(L, 4)),
+                                                           static_cast<float>(luaL_checknumber(L, 5))};
+
+    // Once per table: flecs tracks changes per table, one modified row marks every row changed (deferred on the stage)
+    if (column.context->written_epoch != column.epoch) {
+        column.context->written_epoch = column.epoch;
+        flecs::entity(column.context->world, column.first_entity).modified<Transform3D>();
+    }
+
+    return 0;
+}
+
+int view_entity(lua_State* L) {
+    const TransformView& view = check_view<TransformView>(L, "view");
+    push_entity(L, view.entities[check_row(L, 2, view.count)]);
+    return 1;
+}
+
+template <glm::vec3 Transform3D::* Field>
+Vec3Column get_column(const TransformView& view) {
+    return {reinterpret_cast<std::byte*>(&(view.rows->*Field)), view.count, view.count > 0 ? view.entities[0] : 0, view.epoch, view.context};
+}
+
+int each_transform(lua_State* L) {
+    LuaBindingContext* context = get_context(L);
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+
+    if (context->commands) {
+        return luaL_error(L, "ecs.each_transform is not available to parallel scripts");
+    }
+
+    if (context->is_iterating) {
+        return luaL_error(L, "ecs.each_transform can't be nested");
+    }
+
+    flecs::world_t* world = context->world;
+    if (!world || !context->transform_query) {
+        return 0;
+    }
+
+    // Tables can't move while views point into them: systems run on a deferred stage already, elsewhere defer here
+    const bool is_deferring = !ecs_is_deferred(world);
+    if (is_deferring) {
+        ecs_defer_begin(world);
+    }
+
+    context->is_iterating = true;
+
+    ecs_iter_t it = ecs_query_iter(world, context->transform_query);
+    int status    = LUA_OK;
+
+    while (ecs_query_next(&it)) {
+        context->view_epoch++;
+
+        lua_pushvalue(L, 1);
+        sol::stack::push(L, TransformView{ecs_field(&it, Transform3D, 0), it.entities, it.count, context->view_epoch, context});
+
+        // Protected, an error must not skip the cleanup below
+        if (status = lua_pcall(L, 1, 0, 0); status != LUA_OK) {
+            ecs_iter_fini(&it);
+            break;
+        }
+    }
+
+    context->view_epoch++;
+    context->is_iterating = false;
+
+    if (is_deferring) {
+        ecs_defer_end(world);
+    }
+
+    return status == LUA_OK ? 0 : lua_error(L);
+}
+
+void bind_views(sol::state_view& lua) {
+    // Raw C functions, per-row calls go through the usertype lookup only
+    lua.new_usertype<Vec3Column>("Vec3Column",
+        sol::no_constructor,
+        "get", &column_get,
+        "set", &column_set,
+        sol::meta_function::length, [](const Vec3Column& column) { return column.count; });
+
+    lua.new_usertype<TransformView>("TransformView",
+        sol::no_constructor,
+        "entity", &view_entity,
+        "position", sol::readonly_property(&get_column<&Transform3D::position>),
+        "rotation", sol::readonly_property(&get_column<&Transform3D::rotation>),
+        "scale", sol::readonly_property(&get_column<&Transform3D::scale>),
+        sol::meta_function::length, [](const TransformView& view) { return view.count; });
+}
+
+void bind_types(sol::state_view& lua) {
+    lua.new_usertype<glm::vec3>("vec3",
+        sol::constructors<glm::vec3(), glm::vec3(float), glm::vec3(float, float, float)>(),
+        "x", &glm::vec3::x,
+        "y", &glm::vec3::y,
+        "z", &glm::vec3::z,
+        sol::meta_function::addition, [](const glm::vec3& a, const glm::vec3& b) { return a + b; },
+        sol::meta_function::subtraction, [](const glm::vec3& a, const glm::vec3& b) { return a - b; },
+        sol::meta_function::multiplication, [](const glm::vec3& a, float b) { return a * b; },
+        sol::meta_function::unary_minus, [](const glm::vec3& a) { return -a; },
+        sol::meta_function::to_string, [](const glm::vec3& a) { return glm::to_string(a); },
+        "length", [](const glm::vec3& a) { return glm::length(a); },
+        "normalize", [](const glm::vec3& a) { return glm::normalize(a); },
+        "dot", [](const glm::vec3& a, const glm::vec3& b) { return glm::dot(a, b); },
+        "cross", [](const glm::vec3& a, const glm::vec3& b) { return glm::cross(a, b); });
+
+    lua.new_usertype<Transform3D>("Transform3D",
+        sol::constructors<Transform3D()>(),
+        "position", &Transform3D::position,
+        "rotation", &Transform3D::rotation,
+        "scale", &Transform3D::scale);
+}
+
+} // namespace
+
+void generate_bindings(lua_State* L, LuaBindingContext* context) {
+    sol::state_view lua(L);
+    bind_types(lua);
+
+    if (!context) {
+        return;
+    }
+
+    bind_views(lua);
+
+    static constexpr luaL_Reg functions[] = {
+        {"get_position", get_transform_field<&Transform3D::position>},
+        {"set_position", set_transform_field<&Transform3D::position, ScriptCommand::Type::SET_POSITION>},
+        {"get_rotation", get_transform_field<&Transform3D::rotation>},
+        {"set_rotation", set_transform_field<&Transform3D::rotation, ScriptCommand::Type::SET_ROTATION>},
+        {"get_scale", get_transform_field<&Transform3D::scale>},
+        {"set_scale", set_transform_field<&Transform3D::scale, ScriptCommand::Type::SET_SCALE>},
+        {"is_alive", is_alive},
+        {"get_id", get_id},
+        {"get_name", get_name},
+        {"lookup", lookup},
+        {"destruct", destruct},
+        {"each_transform", each_transform},
+        {nullptr, nullptr},
+    };
+
+    // Every function gets the context as upvalue, no registry lookup per call
+    lua_newtable(L);
+    lua_pushlightuserdata(L, context);
+    luaL_setfuncs(L, functions, 1);
+    lua_setglobal(L, "ecs");
+}
@@ -11,6 +11,22 @@ glm::mat4 Transform3D::get_matrix() const {
     return mat;
 }
 
+Transform3D Transform3D::lerp(const Transform3D& from, const Transform3D& to, float alpha) {
+    constexpr float TWO_PI = glm::two_pi<float>();
+
+    const glm::vec3 rotation_delta = {
+        std::remainder(to.rotation.x - from.rotation.x, TWO_PI),
+        std::remainder(to.rotation.y - from.rotation.y, TWO_PI),
+        std::remainder(to.rotation.z - from.rotation.z, TWO_PI)
+    };
+
+    Transform3D result;
+    result.position = glm::mix(from.position, to.position, alpha);
+    result.rotation = from.rotation + rotation_delta * alpha;
+    result.scale    = glm::mix(from.scale, to.scale, alpha);
+    return result;
+}
+
 
 void Camera3D::update_vectors() {
     glm::vec3 f;
@@ -176,3 +192,16 @@ glm::mat4 DirectionalLight::get_light_space_matrix() const {
     glm::mat4 lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
     return lightProjection * lightView;
 }
+
+bool InputState::has_mouse_motion() const {
+    return is_mouse_captured && (mouse_dx != 0.0f || mouse_dy != 0.0f);
+}
+
+bool InputState::has_camera_input() const {
+    if (has_mouse_motion()) {
+        return true;
+    }
+
+    return keys && (keys[SDL_SCANCODE_W] || keys[SDL_SCANCODE_S] || keys[SDL_SCANCODE_A] || keys[SDL_SCANCODE_D]
+                    || keys[SDL_SCANCODE_SPACE] || keys[SDL_SCANCODE_LCTRL]);
+}
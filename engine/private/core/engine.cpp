@@ -2,6 +2,14 @@
 
 std::unique_ptr<Engine> GEngine = std::make_unique<Engine>();
 
+/// Pipeline running the systems of the `RenderExtract` phase
+struct RenderExtractPipeline {};
+
+template <typename T>
+flecs::query<> create_change_query(flecs::world& world) {
+    return world.query_builder().with<T>().in().cached().detect_changes().build();
+}
+
 
 Renderer* create_renderer_internal(SDL_Window* window, EngineConfig& config) {
 
@@ -78,6 +86,14 @@ bool Engine::initialize(int window_w, int window_h, const char* title, Uint32 wi
         spdlog::warn("Using default configuration values");
     }
 
+    for (const auto& mount : _config.get_resources().mounts) {
+        const bool is_mounted = mount.is_pack ? VirtualFileSystem::get().mount_pack(mount.path) : VirtualFileSystem::get().mount_directory(mount.path);
+
+        if (!is_mounted) {
+            spdlog::warn("Resources mount {} skipped", mount.path);
+        }
+    }
+
     const auto& app_config = _config.get_application();
 
 
@@ -116,7 +132,7 @@ bool Engine::initialize(int window_w, int window_h, const char* title, Uint32 wi
 #pragma endregion
 
 
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMEPAD | SDL_INIT_JOYSTICK | SDL_INIT_AUDIO)) {
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMEPAD | SDL_INIT_JOYSTICK)) {
         spdlog::error("Engine initialization failed: {}", SDL_GetError());
         return false;
     }
@@ -164,7 +180,8 @@ bool Engine::initialize(int window_w, int window_h, const char* title, Uint32 wi
 
     int w, h, channels;
     SDL_Surface* logo_surface = nullptr;
-    stbi_uc* logo_pixels      = stbi_load((ASSETS_PATH + "icon.png").c_str(), &w, &h, &channels, 4);
+    const MappedFile logo_file("res://icon.png");
+    stbi_uc* logo_pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(logo_file.data()), static_cast<int>(logo_file.size()), &w, &h, &channels, 4);
 
     if (logo_pixels) {
         logo_surface = SDL_CreateSurfaceFrom(w, h, SDL_PIXELFORMAT_RGBA32, logo_pixels, w * 4);
@@ -181,6 +198,17 @@ bool Engine::initialize(int window_w, int window_h, const char* title, Uint32 wi
     spdlog::info("Backend selected: {}", _config.get_renderer_device().get_backend_str());
 
 
+    const auto& performance = _config.get_performance();
+
+    // Started before the renderer, environment baking already runs on it
+    _job_system.initialize(performance.worker_threads, performance.is_multithreaded ? 2 : 1, performance.is_thread_affinity);
+    AsyncFileIO::get().initialize(performance.io_threads, performance.is_io_uring);
+    _scripts.set_gc(performance.is_script_gc_generational, performance.script_gc_ms);
+
+    if (!_audio.initialize(_config.get_audio_device())) {
+        spdlog::warn("Audio device unavailable, running muted");
+    }
+
     // TODO: later we can add support for other renderers (Vulkan, OpenGL, etc.)
     _renderer = create_renderer_internal(_window, _config);
 
@@ -192,7 +220,44 @@ bool Engine::initialize(int window_w, int window_h, const char* title, Uint32 wi
     }
 
 
+    engine_setup_systems(_world);
+
+    // Stage 0 is this thread, multi_threaded systems (SnapshotTransforms) are split over it and flecs' own threads (one per extra
+    // stage), not the job workers: flecs threads sleep outside multi_threaded systems. Running flecs tasks on the job system instead
+    // would hold every worker for the whole `progress` (task threads live for the frame), leaving none to parallel scripts.
+    if (_job_system.get_worker_count() > 0) {
+        _world.set_threads(_job_system.get_worker_count() + 1);
+    }
+
+    if (app_config.is_on_demand) {
+        _change_queries.push_back(create_change_query<Transform3D>(_world));
+        _change_queries.push_back(create_change_query<Camera3D>(_world));
+        _change_queries.push_back(create_change_query<MeshRef>(_world));
+        _change_queries.push_back(create_change_query<MaterialRef>(_world));
+        _change_queries.push_back(create_change_query<DirectionalLight>(_world));
+        _change_queries.push_back(create_change_query<SpotLight>(_world));
+    }
+
+    update_frame_pacing(false);
+
+    if (_config.get_performance().is_multithreaded) {
+#if defined(SDL_PLATFORM_EMSCRIPTEN) || defined(SDL_PLATFORM_APPLE)
+        // WebGL contexts can't move between threads, Cocoa wants the GL context and window on the main thread
+        spdlog::warn("Multithreaded rendering is not supported on this platform, rendering on the main thread");
+#else
+        _render_thread = std::make_unique<RenderThread>();
+
+        if (!_render_thread->start(_renderer, engine_render_frame)) {
+            spdlog::error("Render thread creation failed, rendering on the main thread");
+            _render_thread = nullptr;
+        }
+#endif
+    }
+
     _timer.start();
+    _timer.set_fixed_rate(_config.get_performance().physics_fps);
+
+    spdlog::info("Simulation rate: {}", _timer.fixed_delta > 0.0 ? fmt::format("{} Hz fixed step", _config.get_performance().physics_fps) : "variable step");
 
     SDL_ShowWindow(_window); // now shown after renderer  setup
 
@@ -222,70 +287,350 @@ flecs::world& Engine::get_world() {
     return _world;
 }
 
+FrameLimiter& Engine::get_frame_limiter() {
+    return _frame_limiter;
+}
 
-void engine_draw_loop() {
-    std::vector<DirectionalLight> directionalLights;
-    glm::mat4 light_space_matrix(1.0f);
-
-    Camera3D main_camera;
-    Transform3D camera_transform;
-    GEngine->get_world().each([&](const Camera3D& cam, const Transform3D& transform) {
-        main_camera      = cam;
-        camera_transform = transform;
-    });
-
-    GEngine->get_world().each([&](flecs::entity e, Transform3D& t, DirectionalLight& light) {
-        directionalLights.push_back(light);
-
-        if (light.castShadows && light_space_matrix == glm::mat4(1.0f)) {
-            const auto width = GEngine->get_config().get_window().width;
-            const auto height = GEngine->get_config().get_window().height;
-            light_space_matrix = light.get_light_space_matrix();
+JobSystem& Engine::get_job_system() {
+    return _job_system;
+}
+
+RenderSnapshot& Engine::get_frame_snapshot() {
+    return _frame_snapshot;
+}
+
+StaticGeometry& Engine::get_static_geometry() {
+    return _static_geometry;
+}
+
+AssetRegistry& Engine::get_asset_registry() {
+    return _asset_registry;
+}
+
+AudioSystem& Engine::get_audio() {
+    return _audio;
+}
+
+ScriptSystem& Engine::get_scripts() {
+    return _scripts;
+}
+
+void Engine::request_redraw() {
+    _redraw_requested = true;
+}
+
+void Engine::update_frame_pacing(bool is_background) {
+    const auto& app_config = _config.get_application();
+
+    int target_fps = is_background ? app_config.background_fps : app_config.max_fps;
+
+    // VSync already blocks in swap at the refresh rate, limiting on top of it only adds jitter
+    if (!is_background && _renderer && _renderer->get_swap_interval() != 0) {
+        const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(_window));
+
+        if (mode && mode->refresh_rate > 0.0f && static_cast<float>(target_fps) >= mode->refresh_rate - 0.5f) {
+            target_fps = 0;
         }
-    });
+    }
+
+    _frame_limiter.set_target_fps(target_fps);
+}
 
-    std::vector<std::pair<Transform3D, SpotLight>> spotLights;
-    GEngine->get_world().each([&](flecs::entity e, Transform3D& t, SpotLight& light) {
-        spotLights.emplace_back(t, light);
-    });
+void Engine::run_on_render_thread(const std::function<void()>& command) {
+    if (_render_thread) {
+        _render_thread->execute(command);
+        return;
+    }
 
+    command();
+}
 
+void Engine::submit_frame(RenderSnapshot& snapshot) {
+    if (_render_thread && _render_thread->is_running()) {
+        _render_thread->submit(snapshot);
+    } else {
+        engine_render_frame(snapshot);
+    }
+
+    // Cleared after submission, proxy removals observed until the next extraction must survive
+    snapshot.clear();
+}
+
+RenderStats Engine::get_render_stats() const {
+    if (_render_thread) {
+        return _render_thread->get_stats();
+    }
+
+    return _renderer->get_stats();
+}
+
+bool Engine::consume_redraw() {
+    bool changed = _redraw_requested;
+    _redraw_requested = false;
+
+    for (auto& query : _change_queries) {
+        if (query.changed()) {
+            // Iterating synchronizes the query with the current table state
+            query.run([](flecs::iter& it) {
+                while (it.next()) {
+                }
+            });
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+
+void engine_setup_systems(flecs::world& world) {
+    world.set<InputState>({});
+
+    // Every transform keeps the state of the previous simulation step for render interpolation
+    world.component<Transform3D>().add(flecs::With, world.component<PreviousTransform3D>());
+
+    // First phase of every fixed step, before simulation systems write transforms, split over the flecs threads.
+    // Static entities never move, nothing to interpolate. Extraction doesn't follow changes of the snapshot (see ExtractDrawables).
+    world.system<const Transform3D, PreviousTransform3D>("SnapshotTransforms")
+         .kind(flecs::OnLoad)
+         .without<Static>()
+         .multi_threaded()
+         .each([](const Transform3D& transform, PreviousTransform3D& previous) {
+             previous.value    = transform;
+             previous.is_valid = true;
+         });
+
+    // No phase: run once per rendered frame by `engine_core_loop`, the camera follows input at the frame rate rather than physics_fps
+    world.system<Transform3D, Camera3D>("CameraInput")
+         .kind(0)
+         .run([](flecs::iter& it) {
+             auto& input = it.world().get_mut<InputState>();
+
+             // Cameras are only written with input, writes mark them as changed for on-demand rendering
+             if (!input.has_camera_input()) {
+                 it.fini();
+                 return;
+             }
+
+             const auto keys = input.keys;
+             const float dt  = it.delta_time();
+
+             while (it.next()) {
+                 auto transforms = it.field<Transform3D>(0);
+                 auto cameras    = it.field<Camera3D>(1);
+
+                 for (auto i : it) {
+                     auto& transform = transforms[i];
+                     auto& camera    = cameras[i];
+
+                     if (keys[SDL_SCANCODE_W]) camera.move_forward(transform, dt);
+                     if (keys[SDL_SCANCODE_S]) camera.move_backward(transform, dt);
+                     if (keys[SDL_SCANCODE_A]) camera.move_left(transform, dt);
+                     if (keys[SDL_SCANCODE_D]) camera.move_right(transform, dt);
+                     if (keys[SDL_SCANCODE_SPACE]) transform.position.y += camera.speed * dt;
+                     if (keys[SDL_SCANCODE_LCTRL]) transform.position.y -= camera.speed * dt;
+
+                     camera.speed = keys[SDL_SCANCODE_LSHIFT] ? 150.0f : 50.0f;
+
+                     if (input.has_mouse_motion()) {
+                         constexpr float sensitivity = 0.1f;
+                         camera.look_at(input.mouse_dx, -input.mouse_dy, sensitivity);
+                     }
+                 }
+             }
+
+             // Consumed, the next frame only sees its own motion
+             input.mouse_dx = 0.0f;
+             input.mouse_dy = 0.0f;
+         });
+
+    // Extraction runs once per rendered frame from `engine_extract_frame`, never with the simulation steps
+    const auto extract_phase = world.entity("RenderExtract").add(flecs::Phase).depends_on(flecs::PreStore).add(flecs::Disabled);
+
+    auto& snapshot = GEngine->get_frame_snapshot();
+
+    world.system<const Camera3D, const Transform3D>("ExtractCamera")
+         .kind(extract_phase)
+         .each([&snapshot](const Camera3D& camera, const Transform3D& transform) {
+             snapshot.camera           = camera;
+             snapshot.camera_transform = transform;
+         });
+
+    world.system<const Transform3D, const DirectionalLight>("ExtractDirectionalLights")
+         .kind(extract_phase)
+         .each([&snapshot](const Transform3D&, const DirectionalLight& light) {
+             snapshot.directional_lights.push_back(light);
+
+             if (light.castShadows && snapshot.light_space_matrix == glm::mat4(1.0f)) {
+                 snapshot.light_space_matrix = light.get_light_space_matrix();
+             }
+         });
+
+    world.system<const Transform3D, const SpotLight>("ExtractSpotLights")
+         .kind(extract_phase)
+         .each([&snapshot](const Transform3D& transform, const SpotLight& light) {
+             snapshot.spot_lights.emplace_back(transform, light);
+         });
+
+    // Only tables changed since the last extraction are sent, the renderer keeps every other proxy resident.
+    // Tables that moved in the last fixed step are resent every frame until the next one, alpha changes per frame,
+    // then during one more step: its snapshot caught up with their transforms, where they settle.
+    auto interpolating = std::make_shared<std::unordered_set<const ecs_table_t*>>();
+    auto settling      = std::make_shared<std::unordered_set<const ecs_table_t*>>();
+    auto last_step     = std::make_shared<int64_t>(-1);
+
+    world.system<const Transform3D, const MeshRef, const MaterialRef>("ExtractDrawables")
+         .kind(extract_phase)
+         .without<Static>()
+         .detect_changes()
+         .run([&snapshot, interpolating, settling, last_step](flecs::iter& it) {
+             const float alpha = static_cast<float>(GEngine->get_timer().alpha);
+             const auto step   = it.world().get_info()->frame_count_total;
+
+             if (step != *last_step) {
+                 std::swap(*interpolating, *settling);
+                 interpolating->clear();
+                 *last_step = step;
+             }
+
+             while (it.next()) {
+                 const ecs_table_t* table = it.c_ptr()->table;
+                 const bool changed       = it.changed();
+
+                 if (!changed && !interpolating->contains(table) && !settling->contains(table)) {
+                     it.skip();
+                     continue;
+                 }
+
+                 auto transforms = it.field<const Transform3D>(0);
+                 auto meshes     = it.field<const MeshRef>(1);
+                 auto materials  = it.field<const MaterialRef>(2);
+
+                 // Read from the table rather than a term, the snapshot writes every table each step
+                 const PreviousTransform3D* previous = it.range().try_get<PreviousTransform3D>();
+                 const bool has_previous             = previous != nullptr;
+
+                 if (changed && has_previous) {
+                     interpolating->insert(table);
+                 }
+
+                 snapshot.proxy_updates.reserve(snapshot.proxy_updates.size() + it.count());
+
+                 for (auto i : it) {
+                     const Uint64 id = it.entity(i).id();
+
+                     // Render between the last two simulation states so motion stays smooth when rendering faster than physics_fps
+                     if (has_previous && previous[i].is_valid && alpha < 1.0f) {
+                         snapshot.proxy_updates.push_back({id, Transform3D::lerp(previous[i].value, transforms[i], alpha), meshes[i], materials[i]});
+                         continue;
+                     }
+
+                     snapshot.proxy_updates.push_back({id, transforms[i], meshes[i], materials[i]});
+                 }
+             }
+         });
+
+    // Fires when an entity stops being drawable: deleted or lost one of the components
+    world.observer<const Transform3D, const MeshRef, const MaterialRef>("RemoveRenderProxy")
+         .event(flecs::OnRemove)
+         .each([&snapshot](flecs::entity entity, const Transform3D&, const MeshRef&, const MaterialRef&) {
+             snapshot.proxy_removals.push_back(entity.id());
+         });
+
+    // Drawables turned static are drawn by their chunk from now on
+    world.observer<const Transform3D, const MeshRef, const MaterialRef>("StaticRemoveRenderProxy")
+         .with<Static>()
+         .event(flecs::OnAdd)
+         .each([&snapshot](flecs::entity entity, const Transform3D&, const MeshRef&, const MaterialRef&) {
+             snapshot.proxy_removals.push_back(entity.id());
+         });
+
+    GEngine->get_static_geometry().setup(world);
+    GEngine->get_audio().setup(world);
+    GEngine->get_scripts().setup(world, &GEngine->get_job_system());
+
+    world.pipeline<RenderExtractPipeline>()
+         .with(flecs::System)
+         .with(flecs::DependsOn, extract_phase)
+         .build();
+}
+
+void engine_extract_frame() {
+    GEngine->get_world().run_pipeline<RenderExtractPipeline>(static_cast<float>(GEngine->get_timer().delta));
+}
+
+void engine_render_frame(const RenderSnapshot& snapshot) {
     const auto renderer = GEngine->get_renderer();
 
     renderer->begin_frame();
-    auto query = GEngine->get_world().query<const Transform3D, const MeshRef, const MaterialRef>();
 
-    query.each([&](const Transform3D& transform,
-                   const MeshRef& mesh,
-                   const MaterialRef& material) {
-        renderer->add_to_render_batch(transform, mesh, material);
-        renderer->add_to_shadow_batch(transform, mesh);
-    });
+    for (const Uint64 id : snapshot.proxy_removals) {
+        renderer->remove_render_proxy(id);
+    }
+
+    for (const auto& update : snapshot.proxy_updates) {
+        renderer->update_render_proxy(update.id, update.transform, update.mesh, update.material);
+    }
 
     renderer->begin_shadow_pass();
-    renderer->render_shadow_pass(light_space_matrix);
+    renderer->render_shadow_pass(snapshot.light_space_matrix);
     renderer->end_shadow_pass();
 
     renderer->begin_render_target();
-    renderer->render_main_target(main_camera, camera_transform, light_space_matrix, directionalLights, spotLights);
+    renderer->render_main_target(snapshot.camera, snapshot.camera_transform, snapshot.light_space_matrix,
+                                 snapshot.directional_lights, snapshot.spot_lights);
     renderer->end_render_target();
 
     renderer->swap_chain();
 }
 
-void engine_core_loop() {
-    static bool mouse_captured = false;
-    static float mouse_dx = 0.0f;
-    static float mouse_dy = 0.0f;
+void engine_draw_loop() {
+    // Scene load bakes every static chunk, afterwards only the chunks touched by added/removed static entities
+    auto& static_geometry = GEngine->get_static_geometry();
+    if (static_geometry.has_pending()) {
+        static_geometry.bake(GEngine->get_world());
+    }
+
+    engine_extract_frame();
+    GEngine->submit_frame(GEngine->get_frame_snapshot());
+
+    // Frame boundary: assets unreferenced a few frames ago can no longer be in flight
+    GEngine->get_asset_registry().collect();
+
+    // Debug stats in the window title, throttled (title updates are slow on some platforms)
+    static double next_stats_update = 0.0;
+    static bool showing_stats       = false;
+    const auto& timer               = GEngine->get_timer();
+
+    if (GEngine->get_config().is_debug && timer.elapsed_time >= next_stats_update) {
+        const auto stats        = GEngine->get_render_stats();
+        const auto& gc          = GEngine->get_scripts().get_gc_stats();
+        const std::string title = fmt::format("{} | {} fps | {}x{} ({:.0f}%) | {:.2f}/{:.2f} ms | {} draws ({} culled), {} instances, {} uploads | lua gc {:.2f} ms, {} KiB",
+                                              GEngine->get_config().get_application().name, timer.get_fps(),
+                                              stats.render_width, stats.render_height, stats.render_scale * 100.0f,
+                                              stats.frame_ms, stats.target_ms, stats.draw_calls, stats.culled_batches, stats.instances, stats.instance_uploads,
+                                              gc.gc_ms, gc.heap_bytes / 1024);
+
+        SDL_SetWindowTitle(GEngine->get_window(), title.c_str());
+        next_stats_update = timer.elapsed_time + 0.5;
+        showing_stats     = true;
+    } else if (!GEngine->get_config().is_debug && showing_stats) {
+        SDL_SetWindowTitle(GEngine->get_window(), GEngine->get_config().get_application().name);
+        showing_stats = false;
+    }
+}
 
+void engine_core_loop() {
     GEngine->get_timer().tick();
 
-    // Reset mouse delta each frame
-    mouse_dx = 0.0f;
-    mouse_dy = 0.0f;
+    // Consumed by `CameraInput` below and the input systems (OnLoad) of the next simulation step
+    auto& input = GEngine->get_world().get_mut<InputState>();
+
+    bool has_events = false;
 
     while (SDL_PollEvent(&GEngine->event)) {
-        auto& ev = GEngine->event;
+        auto& ev   = GEngine->event;
+        has_events = true;
 
         switch (ev.type) {
             case SDL_EVENT_QUIT:
@@ -294,8 +639,8 @@ void engine_core_loop() {
 
             case SDL_EVENT_KEY_DOWN:
                 if (ev.key.scancode == SDL_SCANCODE_ESCAPE) {
-                    mouse_captured = !mouse_captured;
-                    SDL_SetWindowRelativeMouseMode(GEngine->get_window(), mouse_captured);
+                    input.is_mouse_captured = !input.is_mouse_captured;
+                    SDL_SetWindowRelativeMouseMode(GEngine->get_window(), input.is_mouse_captured);
                     SDL_ShowCursor();
                 }
                 if (ev.key.scancode == SDL_SCANCODE_F1) {
@@ -304,17 +649,17 @@ void engine_core_loop() {
                 break;
 
             case SDL_EVENT_MOUSE_BUTTON_DOWN:
-                if (ev.button.button == SDL_BUTTON_RIGHT && !mouse_captured) {
-                    mouse_captured = true;
+                if (ev.button.button == SDL_BUTTON_RIGHT && !input.is_mouse_captured) {
+                    input.is_mouse_captured = true;
                     SDL_SetWindowRelativeMouseMode(GEngine->get_window(), true);
                     SDL_HideCursor();
                 }
                 break;
 
             case SDL_EVENT_MOUSE_MOTION:
-                if (mouse_captured) {
-                    mouse_dx += static_cast<float>(ev.motion.xrel);
-                    mouse_dy += static_cast<float>(ev.motion.yrel);
+                if (input.is_mouse_captured) {
+                    input.mouse_dx += static_cast<float>(ev.motion.xrel);
+                    input.mouse_dy += static_cast<float>(ev.motion.yrel);
                 }
                 break;
 
@@ -324,7 +669,7 @@ void engine_core_loop() {
                 auto& app_win = GEngine->get_config().get_window();
                 app_win.width = new_w;
                 app_win.height = new_h;
-                GEngine->get_renderer()->resize(new_w, new_h);
+                GEngine->run_on_render_thread([&] { GEngine->get_renderer()->resize(new_w, new_h); });
                 break;
             }
 
@@ -333,28 +678,48 @@ void engine_core_loop() {
         }
     }
 
-    const bool* scancodes = SDL_GetKeyboardState(nullptr);
+    GEngine->get_job_system().run_main_thread_jobs();
 
-    GEngine->get_world().each([&](flecs::entity e, Transform3D& transform, Camera3D& camera) {
-        float dt = static_cast<float>(GEngine->get_timer().delta);
+    input.keys                  = SDL_GetKeyboardState(nullptr);
+    const bool has_camera_input = input.has_camera_input();
 
-        if (scancodes[SDL_SCANCODE_W]) camera.move_forward(transform, dt);
-        if (scancodes[SDL_SCANCODE_S]) camera.move_backward(transform, dt);
-        if (scancodes[SDL_SCANCODE_A]) camera.move_left(transform, dt);
-        if (scancodes[SDL_SCANCODE_D]) camera.move_right(transform, dt);
-        if (scancodes[SDL_SCANCODE_SPACE]) transform.position.y += camera.speed * dt;
-        if (scancodes[SDL_SCANCODE_LCTRL]) transform.position.y -= camera.speed * dt;
+    auto& timer = GEngine->get_timer();
 
-        camera.speed = scancodes[SDL_SCANCODE_LSHIFT] ? 150.0f : 50.0f;
+    // Per frame, outside the fixed steps: extraction copies the camera as is, it's never interpolated
+    flecs::system(GEngine->get_world(), GEngine->get_world().lookup("CameraInput")).run(static_cast<float>(timer.delta));
 
-        if (mouse_captured && (mouse_dx != 0.0f || mouse_dy != 0.0f)) {
-            constexpr float sensitivity = 0.1f;
-            camera.look_at(mouse_dx, -mouse_dy, sensitivity);
+    if (timer.fixed_delta > 0.0) {
+        // Simulation runs at physics_fps regardless of the frame rate, rendering interpolates with timer.alpha
+        const int steps = timer.accumulate_fixed_steps();
+        for (int i = 0; i < steps; ++i) {
+            GEngine->get_world().progress(static_cast<float>(timer.fixed_delta));
         }
+    } else {
+        GEngine->get_world().progress(static_cast<float>(timer.delta));
+    }
+
+    // Once per frame, sources and the listener are where the last step left them
+    GEngine->get_audio().update(static_cast<float>(timer.delta));
+
+    // Minimized/occluded windows keep simulating at a low rate but never render
+    const SDL_WindowFlags window_flags = SDL_GetWindowFlags(GEngine->get_window());
+    const bool is_background           = (window_flags & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_OCCLUDED | SDL_WINDOW_HIDDEN)) != 0;
 
-    });
+    GEngine->update_frame_pacing(is_background);
+
+    if (is_background) {
+        GEngine->request_redraw();
+        return;
+    }
+
+    if (GEngine->get_config().get_application().is_on_demand) {
+        const bool needs_redraw = GEngine->consume_redraw();
+
+        if (!has_events && !has_camera_input && !needs_redraw && !GEngine->get_config().is_debug) {
+            return;
+        }
+    }
 
-    GEngine->get_world().progress(static_cast<float>(GEngine->get_timer().delta));
     engine_draw_loop();
 }
 
@@ -368,6 +733,11 @@ void Engine::run() {
 #else
     while (is_running) {
         engine_core_loop();
+
+        // Leftover frame time goes to the Lua collector before the limiter sleeps it away,
+        // without a limiter (vsync or unlimited) the configured budget is spent as is
+        _scripts.collect_garbage(_frame_limiter.get_target_fps() > 0 ? _frame_limiter.get_remaining_ns() : std::numeric_limits<Uint64>::max());
+        _frame_limiter.wait();
     }
 
 #endif
@@ -376,10 +746,24 @@ void Engine::run() {
 
 Engine::~Engine() {
 
+    // Joins the render thread and makes the context current here again for cleanup
+    _render_thread = nullptr;
+
+    _job_system.shutdown();
+
+    if (_renderer) {
+        _static_geometry.clear(*_renderer);
+    }
+
     delete _renderer;
 
     SDL_DestroyWindow(_window);
 
+    // Streamed sounds and reads from mounted packs still use their mapping
+    _audio.shutdown();
+    AsyncFileIO::get().shutdown();
+    VirtualFileSystem::get().unmount_all();
+
     TTF_Quit();
     SDL_Quit();
 }
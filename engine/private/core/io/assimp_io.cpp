@@ -1,103 +1,88 @@
 #include "core/io/assimp_io.h"
 #include "core/io/file_system.h"
+#include "core/io/mapped_file.h"
 
 
-SDLIOStream::SDLIOStream(const std::string& path, const std::string& mode) 
-    : m_path(path) {
-    
-    ModeFlags flags = ModeFlags::READ;
-    if (mode.find('w') != std::string::npos) {
-        flags = ModeFlags::WRITE;
-    }
-    
-    m_file = std::make_unique<FileAccess>(path, flags);
+MappedIOStream::MappedIOStream(std::unique_ptr<MappedFile> file)
+    : _file(std::move(file)) {
 }
 
-SDLIOStream::~SDLIOStream() {
-    // FileAccess destructor handles cleanup
-}
+MappedIOStream::~MappedIOStream() = default;
 
-size_t SDLIOStream::Read(void* pvBuffer, size_t pSize, size_t pCount) {
-    if (!m_file || !m_file->is_open()) {
+size_t MappedIOStream::Read(void* pvBuffer, size_t pSize, size_t pCount) {
+    if (pSize == 0 || pCount == 0) {
         return 0;
     }
-    
-    const auto& bytes = m_file->get_file_as_bytes();
-    size_t bytesToRead = pSize * pCount;
-    size_t available = bytes.size() - m_position;
-    size_t toRead = std::min(bytesToRead, available);
-    
-    if (toRead > 0) {
-        SDL_memcpy(pvBuffer, bytes.data() + m_position, toRead);
-        m_position += toRead;
+
+    // Whole elements only, Assimp counts elements and not bytes
+    const size_t available = _file->size() - _position;
+    const size_t count     = std::min(pCount, available / pSize);
+
+    if (count > 0) {
+        SDL_memcpy(pvBuffer, _file->data() + _position, count * pSize);
+        _position += count * pSize;
     }
-    
-    return toRead / pSize;
+
+    return count;
 }
 
-size_t SDLIOStream::Write(const void* pvBuffer, size_t pSize, size_t pCount) {
+size_t MappedIOStream::Write(const void* pvBuffer, size_t pSize, size_t pCount) {
     // Write not implemented for assets
     return 0;
 }
 
-aiReturn SDLIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
-    if (!m_file || !m_file->is_open()) {
-        return aiReturn_FAILURE;
-    }
-    
-    size_t fileSize = m_file->get_file_as_bytes().size();
-    
+aiReturn MappedIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    size_t position = 0;
+
     switch (pOrigin) {
         case aiOrigin_SET:
-            m_position = pOffset;
+            position = pOffset;
             break;
         case aiOrigin_CUR:
-            m_position += pOffset;
+            position = _position + pOffset;
             break;
         case aiOrigin_END:
-            m_position = fileSize + pOffset;
+            position = _file->size() - pOffset;
             break;
         default:
             return aiReturn_FAILURE;
     }
-    
+
+    if (position > _file->size()) {
+        return aiReturn_FAILURE;
+    }
+
+    _position = position;
     return aiReturn_SUCCESS;
 }
 
-size_t SDLIOStream::Tell() const {
-    return m_position;
+size_t MappedIOStream::Tell() const {
+    return _position;
 }
 
-size_t SDLIOStream::FileSize() const {
-    if (!m_file || !m_file->is_open()) {
-        return 0;
-    }
-    return m_file->get_file_as_bytes().size();
+size_t MappedIOStream::FileSize() const {
+    return _file->size();
 }
 
-void SDLIOStream::Flush() {
+void MappedIOStream::Flush() {
     // Nothing to flush for read-only files
 }
 
-SDLIOSystem::SDLIOSystem(const std::string& base_path) 
-    : m_base_path(base_path) {
+MappedIOSystem::MappedIOSystem(const std::string& base_path)
+    : _base_path(base_path) {
     // Ensure base path ends with separator
-    if (!m_base_path.empty() && m_base_path.back() != '/' && m_base_path.back() != '\\') {
-        m_base_path += '/';
+    if (!_base_path.empty() && _base_path.back() != '/' && _base_path.back() != '\\') {
+        _base_path += '/';
     }
 }
 
-SDLIOSystem::~SDLIOSystem() {
-    // Cleanup handled by unique_ptrs
-}
+MappedIOSystem::~MappedIOSystem() = default;
 
-bool SDLIOSystem::Exists(const char* pFile) const {
-    std::string full_path = m_base_path + pFile;
-    FileAccess file(full_path, ModeFlags::READ);
-    return file.is_open();
+bool MappedIOSystem::Exists(const char* pFile) const {
+    return FileAccess::file_exists(_base_path + pFile);
 }
 
-char SDLIOSystem::getOsSeparator() const {
+char MappedIOSystem::getOsSeparator() const {
 #ifdef _WIN32
     return '\\';
 #else
@@ -105,18 +90,25 @@ char SDLIOSystem::getOsSeparator() const {
 #endif
 }
 
-Assimp::IOStream* SDLIOSystem::Open(const char* pFile, const char* pMode) {
-    std::string full_path = m_base_path + pFile;
-    
-    auto stream = new SDLIOStream(full_path, pMode);
-    if (!stream->m_file || !stream->m_file->is_open()) {
-        delete stream;
+Assimp::IOStream* MappedIOSystem::Open(const char* pFile, const char* pMode) {
+    // Assets are read-only
+    if (std::string_view(pMode).find_first_of("wa+") != std::string_view::npos) {
         return nullptr;
     }
-    
-    return stream;
+
+    auto file = std::make_unique<MappedFile>(_base_path + pFile);
+    if (!file->is_open()) {
+        return nullptr;
+    }
+
+    _opened_files.push_back(_base_path + pFile);
+    return new MappedIOStream(std::move(file));
 }
 
-void SDLIOSystem::Close(Assimp::IOStream* pFile) {
+void MappedIOSystem::Close(Assimp::IOStream* pFile) {
     delete pFile;
-}
\ No newline at end of file
+}
+
+const std::vector<std::string>& MappedIOSystem::get_opened_files() const {
+    return _opened_files;
+}
@@ -0,0 +1,719 @@
+#include "core/io/async_io.h"
+#include "core/io/file_system.h"
+#include "core/io/vfs.h"
+
+#if defined(SDL_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int DEFAULT_THREADS = 2;
+
+/// Loose file serving `path`, empty for `res://` files coming from a mounted pack
+std::string resolve_loose_path(const std::string& path, bool& is_pack) {
+    is_pack = false;
+
+    if (path.rfind("res://", 0) == 0) {
+        std::string loose_path = VirtualFileSystem::get().get_loose_path(path);
+        is_pack = loose_path.empty();
+        return loose_path;
+    }
+
+    return FileAccess::globalize_path(path);
+}
+
+} // namespace
+
+#if defined(SDL_PLATFORM_LINUX)
+
+/*!
+    @brief Raw io_uring, set up with the syscalls directly (no liburing dependency)
+    - Only the I/O thread touches the rings, submissions and completions need no lock
+    - An eventfd read is always in flight, writing to it wakes the I/O thread for new or cancelled requests
+*/
+struct AsyncFileIO::Ring {
+    static constexpr Uint32 ENTRIES   = QUEUE_DEPTH * 2; ///< Reads, their cancels and the wake read
+    static constexpr Uint64 SLOT_MASK = 0xFF;
+    static constexpr Uint64 WAKE_TAG  = 0xFF;
+    static constexpr Uint64 CANCEL_TAG = 0xFE;
+
+    int fd       = -1;
+    int event_fd = -1;
+    Uint64 event_value = 0;
+
+    void* sq_ptr     = MAP_FAILED;
+    size_t sq_size   = 0;
+    void* cq_ptr     = MAP_FAILED;
+    size_t cq_size   = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned* sq_head  = nullptr;
+    unsigned* sq_tail  = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_mask   = 0;
+    unsigned sq_entries = 0;
+
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask  = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    unsigned to_submit = 0;
+
+    // Reads in flight, the low byte of their `user_data` is the slot, the rest a sequence so late cancels can't hit a reused slot
+    std::array<AsyncReadHandle, QUEUE_DEPTH> slots;
+    std::array<Uint64, QUEUE_DEPTH> slot_user_data{};
+    Uint32 in_flight = 0;
+    Uint64 sequence  = 0;
+
+    ~Ring() {
+        if (sqes) {
+            munmap(sqes, sqes_size);
+        }
+
+        if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) {
+            munmap(cq_ptr, cq_size);
+        }
+
+        if (sq_ptr != MAP_FAILED) {
+            munmap(sq_ptr, sq_size);
+        }
+
+        if (event_fd >= 0) {
+            close(event_fd);
+        }
+
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    bool create() {
+        io_uring_params params{};
+
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+        if (fd < 0) {
+            spdlog::info("AsyncFileIO - io_uring unavailable ({}), using reader threads", strerror(errno));
+            return false;
+        }
+
+        // IORING_OP_READ is 5.6, fast poll 5.7, older kernels use the reader threads
+        if (!(params.features & IORING_FEAT_FAST_POLL)) {
+            spdlog::info("AsyncFileIO - io_uring too old, using reader threads");
+            return false;
+        }
+
+        sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        const bool is_single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (is_single_mmap) {
+            sq_size = cq_size = std::max(sq_size, cq_size);
+        }
+
+        sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq_ptr == MAP_FAILED) {
+            return false;
+        }
+
+        cq_ptr = is_single_mmap ? sq_ptr : mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED) {
+            return false;
+        }
+
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes_ptr == MAP_FAILED) {
+            return false;
+        }
+
+        sqes = static_cast<io_uring_sqe*>(sqes_ptr);
+
+        auto* sq = static_cast<char*>(sq_ptr);
+        sq_head    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail    = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_array   = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_mask    = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries = params.sq_entries;
+
+        auto* cq = static_cast<char*>(cq_ptr);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        event_fd = eventfd(0, EFD_CLOEXEC);
+        return event_fd >= 0;
+    }
+
+    /// Next free submission entry, zeroed. The kernel only reads the ring in `submit` (no SQ polling), so it is published right away
+    io_uring_sqe* get_sqe() {
+        const unsigned tail = *sq_tail;
+
+        if (tail - std::atomic_ref(*sq_head).load(std::memory_order_acquire) >= sq_entries) {
+            submit(0);
+
+            if (tail - std::atomic_ref(*sq_head).load(std::memory_order_acquire) >= sq_entries) {
+                return nullptr;
+            }
+        }
+
+        const unsigned index = tail & sq_mask;
+        io_uring_sqe* sqe    = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+
+        sq_array[index] = index;
+        std::atomic_ref(*sq_tail).store(tail + 1, std::memory_order_release);
+        to_submit++;
+
+        return sqe;
+    }
+
+    /// Submit every queued entry in one call, then block until `wait_count` completions are available
+    void submit(unsigned wait_count) {
+        const int submitted = static_cast<int>(
+            syscall(__NR_io_uring_enter, fd, to_submit, wait_count, wait_count > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+
+        if (submitted >= 0) {
+            to_submit -= std::min(to_submit, static_cast<unsigned>(submitted));
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            spdlog::error("AsyncFileIO - io_uring_enter failed: {}", strerror(errno));
+        }
+    }
+
+    void arm_wake() {
+        if (io_uring_sqe* sqe = get_sqe()) {
+            sqe->opcode    = IORING_OP_READ;
+            sqe->fd        = event_fd;
+            sqe->addr      = reinterpret_cast<Uint64>(&event_value);
+            sqe->len       = sizeof(event_value);
+            sqe->off       = static_cast<Uint64>(-1); // Current position, eventfds can't seek
+            sqe->user_data = WAKE_TAG;
+        }
+    }
+};
+
+#else
+
+struct AsyncFileIO::Ring {};
+
+#endif
+
+AsyncReadStatus AsyncRead::wait() const {
+    _is_done.wait(false, std::memory_order_acquire);
+    return get_status();
+}
+
+void AsyncRead::cancel() {
+    if (!is_done()) {
+        AsyncFileIO::get().cancel(*this);
+    }
+}
+
+AsyncFileIO& AsyncFileIO::get() {
+    static AsyncFileIO instance;
+    return instance;
+}
+
+AsyncFileIO::~AsyncFileIO() {
+    shutdown();
+}
+
+bool AsyncFileIO::initialize(int thread_count, bool use_io_uring) {
+    std::lock_guard lock(_mutex);
+    return _running || start(thread_count, use_io_uring);
+}
+
+bool AsyncFileIO::start(int thread_count, bool use_io_uring) {
+    _running    = true;
+    _is_started = true;
+
+#if defined(SDL_PLATFORM_LINUX)
+    if (use_io_uring) {
+        auto ring = std::make_unique<Ring>();
+
+        if (ring->create()) {
+            _ring = std::move(ring);
+            _ring->arm_wake();
+            _threads.emplace_back(&AsyncFileIO::ring_loop, this);
+
+            spdlog::info("AsyncFileIO::initialize - io_uring, {} reads in flight", QUEUE_DEPTH);
+            return true;
+        }
+    }
+#endif
+
+    const int count = std::max(1, thread_count);
+    for (int i = 0; i < count; ++i) {
+        _threads.emplace_back(&AsyncFileIO::pool_loop, this);
+    }
+
+    spdlog::info("AsyncFileIO::initialize - {} reader threads", count);
+    return true;
+}
+
+void AsyncFileIO::shutdown() {
+    std::vector<AsyncReadHandle> dropped;
+
+    {
+        std::lock_guard lock(_mutex);
+        if (!_running) {
+            return;
+        }
+
+        _running = false;
+
+        for (auto& queue : _queues) {
+            dropped.insert(dropped.end(), queue.begin(), queue.end());
+            queue.clear();
+        }
+
+        _cv.notify_all();
+        wake();
+    }
+
+    for (const auto& request : dropped) {
+        complete(*request, AsyncReadStatus::CANCELLED);
+    }
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+
+    std::lock_guard lock(_mutex);
+    _threads.clear();
+    _ring.reset();
+}
+
+bool AsyncFileIO::is_io_uring() const {
+    std::lock_guard lock(_mutex);
+    return _ring != nullptr;
+}
+
+AsyncReadHandle AsyncFileIO::read(const std::string& path, Uint64 offset, size_t size, void* buffer, IoPriority priority,
+                                  AsyncRead::Callback callback) {
+    auto request       = std::make_shared<AsyncRead>();
+    request->_path     = path;
+    request->_offset   = offset;
+    request->_size     = size;
+    request->_buffer   = static_cast<std::byte*>(buffer);
+    request->_priority = priority;
+    request->_callback = std::move(callback);
+
+    if (!buffer && size > 0) {
+        spdlog::error("AsyncFileIO::read - No destination buffer for {}", path);
+        complete(*request, AsyncReadStatus::FAILED);
+        return request;
+    }
+
+    return submit(std::move(request));
+}
+
+AsyncReadHandle AsyncFileIO::read_file(const std::string& path, IoPriority priority, AsyncRead::Callback callback) {
+    auto request       = std::make_shared<AsyncRead>();
+    request->_path     = path;
+    request->_priority = priority;
+    request->_callback = std::move(callback);
+
+    return submit(std::move(request));
+}
+
+size_t AsyncFileIO::get_pending_count() const {
+    return _pending.load(std::memory_order_acquire);
+}
+
+AsyncReadHandle AsyncFileIO::submit(AsyncReadHandle request) {
+    _pending.fetch_add(1, std::memory_order_acq_rel);
+
+    {
+        std::lock_guard lock(_mutex);
+
+        // Started on first use when the engine did not, never restarted once shut down
+        if (!_running && !_is_started) {
+            start(DEFAULT_THREADS, true);
+        }
+
+        if (_running) {
+            _queues[static_cast<size_t>(request->_priority)].push_back(request);
+            wake();
+            return request;
+        }
+    }
+
+    spdlog::warn("AsyncFileIO::read - {} dropped, the I/O threads are shut down", request->_path);
+    complete(*request, AsyncReadStatus::CANCELLED);
+    return request;
+}
+
+AsyncReadHandle AsyncFileIO::pop_next() {
+    for (auto& queue : _queues) {
+        if (!queue.empty()) {
+            AsyncReadHandle request = std::move(queue.front());
+            queue.pop_front();
+            return request;
+        }
+    }
+
+    return nullptr;
+}
+
+void AsyncFileIO::cancel(AsyncRead& request) {
+    request._is_cancel_requested.store(true, std::memory_order_release);
+
+    AsyncReadHandle dropped;
+
+    // Still queued: dropped right away, otherwise the backend aborts it
+    {
+        std::lock_guard lock(_mutex);
+        auto& queue = _queues[static_cast<size_t>(request._priority)];
+
+        if (const auto it = std::ranges::find_if(queue, [&request](const auto& queued) { return queued.get() == &request; }); it != queue.end()) {
+            dropped = std::move(*it);
+            queue.erase(it);
+        } else if (_running) {
+            wake();
+        }
+    }
+
+    if (dropped) {
+        complete(*dropped, AsyncReadStatus::CANCELLED);
+    }
+}
+
+/// `_mutex` held, `_ring` is only replaced under it
+void AsyncFileIO::wake() {
+#if defined(SDL_PLATFORM_LINUX)
+    if (_ring) {
+        const Uint64 value = 1;
+        [[maybe_unused]] const auto written = write(_ring->event_fd, &value, sizeof(value));
+        return;
+    }
+#endif
+
+    _cv.notify_one();
+}
+
+void AsyncFileIO::complete(AsyncRead& request, AsyncReadStatus status) {
+    request._status.store(status, std::memory_order_release);
+
+    if (request._callback) {
+        request._callback(request);
+    }
+
+    // No longer counted by the time a waiter returns
+    _pending.fetch_sub(1, std::memory_order_acq_rel);
+
+    request._is_done.store(true, std::memory_order_release);
+    request._is_done.notify_all();
+}
+
+bool AsyncFileIO::read_from_pack(AsyncRead& request, const std::string& key) const {
+    auto& vfs = VirtualFileSystem::get();
+
+    size_t file_size = 0;
+    if (!vfs.get_file_size(key, file_size)) {
+        return false;
+    }
+
+    const size_t available = request._offset < file_size ? file_size - request._offset : 0;
+
+    if (!request._buffer) {
+        request._owned.resize(available);
+        request._buffer = request._owned.data();
+        request._size   = available;
+    }
+
+    const size_t count = std::min(request._size, available);
+
+    if (const auto view = vfs.view(key); !view.empty()) {
+        std::memcpy(request._buffer, view.data() + request._offset, count);
+    } else {
+        const auto bytes = vfs.read_all(key);
+        if (bytes.size() != file_size) {
+            return false;
+        }
+
+        std::memcpy(request._buffer, bytes.data() + request._offset, count);
+    }
+
+    request._bytes_read = count;
+    return true;
+}
+
+void AsyncFileIO::pool_loop() {
+    while (true) {
+        AsyncReadHandle request;
+        {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [this] { return !_running || std::ranges::any_of(_queues, [](const auto& queue) { return !queue.empty(); }); });
+
+            request = pop_next();
+            if (!request) {
+                return;
+            }
+        }
+
+        if (request->_is_cancel_requested.load(std::memory_order_acquire)) {
+            complete(*request, AsyncReadStatus::CANCELLED);
+        } else {
+            pool_read(*request);
+        }
+    }
+}
+
+void AsyncFileIO::pool_read(AsyncRead& request) {
+    bool is_pack = false;
+    const std::string loose_path = resolve_loose_path(request._path, is_pack);
+
+    if (is_pack) {
+        complete(request, read_from_pack(request, request._path) ? AsyncReadStatus::DONE : AsyncReadStatus::FAILED);
+        return;
+    }
+
+    SDL_IOStream* file = SDL_IOFromFile(loose_path.c_str(), "rb");
+    if (!file) {
+        spdlog::error("AsyncFileIO - Failed to open {}", request._path);
+        complete(request, AsyncReadStatus::FAILED);
+        return;
+    }
+
+    if (!request._buffer) {
+        const Sint64 file_size = SDL_GetIOSize(file);
+        const size_t available = file_size > static_cast<Sint64>(request._offset) ? static_cast<size_t>(file_size - request._offset) : 0;
+
+        request._owned.resize(available);
+        request._buffer = request._owned.data();
+        request._size   = available;
+    }
+
+    AsyncReadStatus status = AsyncReadStatus::DONE;
+
+    if (request._size > 0 && SDL_SeekIO(file, static_cast<Sint64>(request._offset), SDL_IO_SEEK_SET) < 0) {
+        status = AsyncReadStatus::FAILED;
+    }
+
+    while (status == AsyncReadStatus::DONE && request._bytes_read < request._size) {
+        if (request._is_cancel_requested.load(std::memory_order_acquire)) {
+            status = AsyncReadStatus::CANCELLED;
+            break;
+        }
+
+        const size_t chunk = std::min(CHUNK_SIZE, request._size - request._bytes_read);
+        const size_t read  = SDL_ReadIO(file, request._buffer + request._bytes_read, chunk);
+        request._bytes_read += read;
+
+        if (read < chunk) {
+            // Short of the requested size at the end of the file, like pread
+            if (SDL_GetIOStatus(file) == SDL_IO_STATUS_ERROR) {
+                status = AsyncReadStatus::FAILED;
+            }
+            break;
+        }
+    }
+
+    if (status == AsyncReadStatus::FAILED) {
+        spdlog::error("AsyncFileIO - Failed to read {}: {}", request._path, SDL_GetError());
+    }
+
+    SDL_CloseIO(file);
+    complete(request, status);
+}
+
+#if defined(SDL_PLATFORM_LINUX)
+
+void AsyncFileIO::ring_loop() {
+    Ring& ring = *_ring;
+
+    while (true) {
+        bool is_running = true;
+
+        // Start queued reads while slots are free, they go out in the same submit call
+        while (ring.in_flight < QUEUE_DEPTH) {
+            AsyncReadHandle request;
+            {
+                std::lock_guard lock(_mutex);
+                is_running = _running;
+                request    = pop_next();
+            }
+
+            if (!request) {
+                break;
+            }
+
+            ring_start(request);
+        }
+
+        for (size_t slot = 0; slot < ring.slots.size(); ++slot) {
+            auto& request = ring.slots[slot];
+            if (!request || request->_is_cancel_sent) {
+                continue;
+            }
+
+            if (!is_running) {
+                request->_is_cancel_requested.store(true, std::memory_order_release);
+            }
+
+            if (!request->_is_cancel_requested.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            if (io_uring_sqe* sqe = ring.get_sqe()) {
+                sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+                sqe->addr      = ring.slot_user_data[slot];
+                sqe->user_data = Ring::CANCEL_TAG;
+
+                request->_is_cancel_sent = true;
+            }
+        }
+
+        if (!is_running && ring.in_flight == 0) {
+            return;
+        }
+
+        // The wake read is always pending, so this returns on new work as well as on completions
+        ring.submit(1);
+
+        unsigned head      = *ring.cq_head;
+        const unsigned tail = std::atomic_ref(*ring.cq_tail).load(std::memory_order_acquire);
+
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = ring.cqes[head & ring.cq_mask];
+
+            if (cqe.user_data == Ring::WAKE_TAG) {
+                ring.arm_wake();
+            } else if (cqe.user_data != Ring::CANCEL_TAG) {
+                ring_finish(cqe.user_data, cqe.res);
+            }
+        }
+
+        std::atomic_ref(*ring.cq_head).store(head, std::memory_order_release);
+    }
+}
+
+void AsyncFileIO::ring_start(const AsyncReadHandle& request) {
+    if (request->_is_cancel_requested.load(std::memory_order_acquire)) {
+        complete(*request, AsyncReadStatus::CANCELLED);
+        return;
+    }
+
+    bool is_pack = false;
+    const std::string loose_path = resolve_loose_path(request->_path, is_pack);
+
+    // Already mapped, a copy on this thread beats a round trip through the ring
+    if (is_pack) {
+        complete(*request, read_from_pack(*request, request->_path) ? AsyncReadStatus::DONE : AsyncReadStatus::FAILED);
+        return;
+    }
+
+    request->_fd = open(loose_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (request->_fd < 0) {
+        spdlog::error("AsyncFileIO - Failed to open {}: {}", request->_path, strerror(errno));
+        complete(*request, AsyncReadStatus::FAILED);
+        return;
+    }
+
+    if (!request->_buffer) {
+        struct stat info{};
+        const size_t file_size = fstat(request->_fd, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+        const size_t available = request->_offset < file_size ? file_size - request->_offset : 0;
+
+        request->_owned.resize(available);
+        request->_buffer = request->_owned.data();
+        request->_size   = available;
+    }
+
+    if (request->_size == 0) {
+        close(request->_fd);
+        request->_fd = -1;
+        complete(*request, AsyncReadStatus::DONE);
+        return;
+    }
+
+    Ring& ring = *_ring;
+
+    const auto free_slot = std::ranges::find(ring.slots, nullptr);
+    const int slot       = static_cast<int>(free_slot - ring.slots.begin());
+
+    ring.slots[slot]          = request;
+    ring.slot_user_data[slot] = (++ring.sequence << 8) | static_cast<Uint64>(slot);
+    ring.in_flight++;
+
+    ring_queue_read(slot);
+}
+
+void AsyncFileIO::ring_queue_read(int slot) {
+    Ring& ring     = *_ring;
+    AsyncRead& request = *ring.slots[slot];
+
+    io_uring_sqe* sqe = ring.get_sqe();
+    if (!sqe) {
+        ring_finish(ring.slot_user_data[slot], -EBUSY);
+        return;
+    }
+
+    // Reads are capped at 1 GiB by the kernel anyway, the rest goes out as a follow-up read
+    sqe->opcode    = IORING_OP_READ;
+    sqe->fd        = request._fd;
+    sqe->addr      = reinterpret_cast<Uint64>(request._buffer + request._bytes_read);
+    sqe->len       = static_cast<Uint32>(std::min<size_t>(request._size - request._bytes_read, 1u << 30));
+    sqe->off       = request._offset + request._bytes_read;
+    sqe->user_data = ring.slot_user_data[slot];
+}
+
+void AsyncFileIO::ring_finish(Uint64 user_data, int result) {
+    Ring& ring     = *_ring;
+    const int slot = static_cast<int>(user_data & Ring::SLOT_MASK);
+
+    if (slot >= static_cast<int>(QUEUE_DEPTH) || ring.slot_user_data[slot] != user_data || !ring.slots[slot]) {
+        return;
+    }
+
+    AsyncRead& request = *ring.slots[slot];
+    const bool is_cancelled = request._is_cancel_requested.load(std::memory_order_acquire);
+
+    if ((result == -EINTR || result == -EAGAIN) && !is_cancelled) {
+        ring_queue_read(slot);
+        return;
+    }
+
+    AsyncReadStatus status = AsyncReadStatus::DONE;
+
+    if (result < 0) {
+        status = result == -ECANCELED || is_cancelled ? AsyncReadStatus::CANCELLED : AsyncReadStatus::FAILED;
+
+        if (status == AsyncReadStatus::FAILED) {
+            spdlog::error("AsyncFileIO - Failed to read {}: {}", request._path, strerror(-result));
+        }
+    } else {
+        request._bytes_read += static_cast<size_t>(result);
+
+        // Short read: keep going unless it hit the end of the file
+        if (result > 0 && request._bytes_read < request._size) {
+            if (!is_cancelled) {
+                ring_queue_read(slot);
+                return;
+            }
+
+            status = AsyncReadStatus::CANCELLED;
+        }
+    }
+
+    close(request._fd);
+    request._fd = -1;
+
+    const AsyncReadHandle finished = std::move(ring.slots[slot]);
+    ring.slot_user_data[slot]      = 0;
+    ring.in_flight--;
+
+    complete(*finished, status);
+}
+
+#endif
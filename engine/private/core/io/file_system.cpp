@@ -1,4 +1,5 @@
 #include "core/io/file_system.h"
+#include "core/io/vfs.h"
 
 
 
@@ -13,30 +14,13 @@ std::string load_assets_file(const std::string& file_path) {
 
 std::vector<char> load_file_into_memory(const std::string& file_path) {
 
-    auto path = ASSETS_PATH + file_path;
+    // Mounted packs and overlays first, then the loose `res` folder
+    auto buffer = VirtualFileSystem::get().read_all(file_path);
 
-    SDL_IOStream* file_rw = SDL_IOFromFile(path.c_str(), "rb");
-    if (!file_rw) {
-        spdlog::error("Failed to open file {} , Error: {}", path.c_str(), SDL_GetError());
-        return {};
+    if (buffer.empty()) {
+        spdlog::error("Failed to load file {}", file_path);
     }
 
-    Sint64 size = SDL_GetIOSize(file_rw);
-    if (size <= 0) {
-        spdlog::error("Failed to get file size {}, Error: {}", path.c_str(), SDL_GetError());
-        SDL_CloseIO(file_rw);
-        return {};
-    }
-
-    std::vector<char> buffer(size);
-    if (SDL_ReadIO(file_rw, buffer.data(), size) != size) {
-        spdlog::error("Failed to read file {}", path.c_str());
-        SDL_CloseIO(file_rw);
-        return {};
-    }
-
-    SDL_CloseIO(file_rw);
-
     return buffer;
 }
 
@@ -96,7 +80,12 @@ bool FileAccess::open(const std::string& file_path, ModeFlags mode_flags) {
         return false;
     }
 
-    _file = SDL_IOFromFile(_file_path.c_str(), get_mode_str(mode_flags));
+    if (mode_flags == ModeFlags::READ && file_path.rfind("res://", 0) == 0) {
+        _file = VirtualFileSystem::get().open(file_path);
+    } else {
+        _file = SDL_IOFromFile(_file_path.c_str(), get_mode_str(mode_flags));
+    }
+
     if (!_file) {
         spdlog::error("Failed to open file {}", _file_path.c_str());
         return false;
@@ -139,20 +128,23 @@ std::string FileAccess::get_file_as_str() {
     return {bytes.begin(), bytes.end()};
 }
 
-bool FileAccess::file_exists(const std::string& file_path) {
-    std::string path;
+AsyncReadHandle FileAccess::read_async(const std::string& file_path, Uint64 offset, size_t size, void* buffer, IoPriority priority,
+                                       AsyncRead::Callback callback) {
+    return AsyncFileIO::get().read(file_path, offset, size, buffer, priority, std::move(callback));
+}
 
+AsyncReadHandle FileAccess::read_file_async(const std::string& file_path, IoPriority priority, AsyncRead::Callback callback) {
+    return AsyncFileIO::get().read_file(file_path, priority, std::move(callback));
+}
+
+bool FileAccess::file_exists(const std::string& file_path) {
     if (file_path.rfind("res://", 0) == 0) {
-        path = ASSETS_PATH + file_path.substr(6);
-    } else if (file_path.rfind("user://", 0) == 0) {
-        char* prefPath = SDL_GetPrefPath("Golias", "com.golias.engine.app");
-        if (!prefPath) return false;
-        path = std::string(prefPath) + file_path.substr(7);
-        SDL_free(prefPath);
-    } else {
-        path = ASSETS_PATH + file_path;
+        return VirtualFileSystem::get().exists(file_path);
     }
 
+    const std::string path = globalize_path(file_path);
+    if (path.empty()) return false;
+
     SDL_IOStream* test = SDL_IOFromFile(path.c_str(), "rb");
     if (test) {
         SDL_CloseIO(test);
@@ -161,6 +153,24 @@ bool FileAccess::file_exists(const std::string& file_path) {
     return false;
 }
 
+std::string FileAccess::globalize_path(const std::string& file_path) {
+    if (file_path.rfind("res://", 0) == 0) {
+        return VirtualFileSystem::get().get_loose_path(file_path);
+    }
+
+    if (file_path.rfind("user://", 0) == 0) {
+        char* prefPath = SDL_GetPrefPath(ENGINE_DEFAULT_FOLDER_NAME, ENGINE_PACKAGE_NAME);
+        if (!prefPath) return {};
+
+        std::string path = std::string(prefPath) + file_path.substr(7);
+        SDL_free(prefPath);
+        return path;
+    }
+
+    // Same as `open`: other paths are already resolved
+    return file_path;
+}
+
 void FileAccess::seek(int length) {
     if (_file) SDL_SeekIO(_file, length, SDL_IO_SEEK_SET);
 }
@@ -1,4 +1,5 @@
 #include "core/io/ma_io.h"
+#include "core/io/vfs.h"
 
 
 static ma_result sdl_vfs_onOpen(ma_vfs* pVFS, const char* pPath, ma_uint32 openMode, ma_vfs_file* pFile) {
@@ -10,7 +11,8 @@ static ma_result sdl_vfs_onOpen(ma_vfs* pVFS, const char* pPath, ma_uint32 openM
         return MA_INVALID_ARGS;
     }
 
-    SDL_IOStream* rw = SDL_IOFromFile(pPath, "rb");
+    // res:// sounds may live in a mounted pack
+    SDL_IOStream* rw = SDL_strncmp(pPath, "res://", 6) == 0 ? VirtualFileSystem::get().open(pPath) : SDL_IOFromFile(pPath, "rb");
     if (!rw) {
         return MA_DOES_NOT_EXIST;
     }
@@ -66,6 +68,21 @@ static ma_result sdl_vfs_onTell(ma_vfs* pVFS, ma_vfs_file file, ma_int64* pCurso
     return MA_SUCCESS;
 }
 
+static ma_result sdl_vfs_onInfo(ma_vfs* pVFS, ma_vfs_file file, ma_file_info* pInfo) {
+    if (!file || !pInfo) {
+        return MA_INVALID_ARGS;
+    }
+
+    Ember_File* sdlFile = (Ember_File*) file;
+    Sint64 size         = SDL_GetIOSize(sdlFile->stream);
+    if (size < 0) {
+        return MA_NOT_IMPLEMENTED;
+    }
+
+    pInfo->sizeInBytes = (ma_uint64) size;
+    return MA_SUCCESS;
+}
+
 static ma_result sdl_vfs_onClose(ma_vfs* pVFS, ma_vfs_file file) {
     if (!file) {
         return MA_INVALID_ARGS;
@@ -88,6 +105,7 @@ ma_result ember_init_ma_vfs(MiniAudio_VFS* vfs) {
     vfs->base.onSeek  = sdl_vfs_onSeek;
     vfs->base.onTell  = sdl_vfs_onTell;
     vfs->base.onClose = sdl_vfs_onClose;
+    vfs->base.onInfo  = sdl_vfs_onInfo;
     vfs->base.onWrite = NULL;
 
     return MA_SUCCESS;
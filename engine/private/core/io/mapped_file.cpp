@@ -0,0 +1,159 @@
+#include "core/io/mapped_file.h"
+#include "core/io/file_system.h"
+#include "core/io/vfs.h"
+
+#if defined(SDL_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(SDL_PLATFORM_EMSCRIPTEN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_POSIX
+#endif
+
+MappedFile::MappedFile(const std::string& file_path) {
+    open(file_path);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& file_path) {
+    close();
+
+    const std::string path = FileAccess::globalize_path(file_path);
+
+    if (!path.empty() && map(path)) {
+        return true;
+    }
+
+    const bool is_res_path = file_path.rfind("res://", 0) == 0;
+
+    // Stored pack entries are already mapped with their archive
+    if (is_res_path) {
+        if (const auto view = VirtualFileSystem::get().view(file_path); !view.empty()) {
+            _data    = view.data();
+            _size    = view.size();
+            _is_view = true;
+            return true;
+        }
+    }
+
+    // Not a plain file (APK asset, compressed pack entry) or no mapping support, keep a private copy instead
+    if (is_res_path) {
+        _fallback = VirtualFileSystem::get().read_all(file_path);
+    } else {
+        FileAccess file(file_path, ModeFlags::READ);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        _fallback = file.get_file_as_bytes();
+    }
+
+    _data     = reinterpret_cast<const std::byte*>(_fallback.data());
+    _size     = _fallback.size();
+
+    return !_fallback.empty();
+}
+
+void MappedFile::close() {
+#if defined(SDL_PLATFORM_WINDOWS)
+    if (_mapping) {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+
+    if (_file) {
+        CloseHandle(_file);
+        _file = nullptr;
+    }
+#elif defined(MAPPED_FILE_POSIX)
+    if (_data && _fallback.empty() && !_is_view) {
+        munmap(const_cast<std::byte*>(_data), _size);
+    }
+#endif
+
+    _fallback.clear();
+    _fallback.shrink_to_fit();
+    _data    = nullptr;
+    _size    = 0;
+    _is_view = false;
+}
+
+bool MappedFile::is_open() const {
+    return _data != nullptr;
+}
+
+const std::byte* MappedFile::data() const {
+    return _data;
+}
+
+size_t MappedFile::size() const {
+    return _size;
+}
+
+std::span<const std::byte> MappedFile::bytes() const {
+    return {_data, _size};
+}
+
+bool MappedFile::map(const std::string& path) {
+#if defined(SDL_PLATFORM_WINDOWS)
+    _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) {
+        _file = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) {
+        close();
+        return false;
+    }
+
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping) {
+        close();
+        return false;
+    }
+
+    _data = static_cast<const std::byte*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    _size = static_cast<size_t>(size.QuadPart);
+
+    if (!_data) {
+        close();
+        return false;
+    }
+
+    return true;
+#elif defined(MAPPED_FILE_POSIX)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping keeps its own reference on the file
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    _data = static_cast<const std::byte*>(view);
+    _size = static_cast<size_t>(info.st_size);
+    return true;
+#else
+    return false;
+#endif
+}
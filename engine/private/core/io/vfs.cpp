@@ -0,0 +1,514 @@
+#include "core/io/vfs.h"
+#include "core/utility/hash.h"
+
+#include <bit>
+
+namespace {
+
+constexpr std::string_view RES_PREFIX = "res://";
+
+/// Bounds checked little-endian reads over the archive index
+class IndexReader {
+public:
+    explicit IndexReader(std::span<const std::byte> bytes) : _bytes(bytes) {
+    }
+
+    template <typename T>
+    bool read(T& out) {
+        if (sizeof(T) > _bytes.size() - _offset) {
+            return false;
+        }
+
+        std::memcpy(&out, _bytes.data() + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    bool read_string(std::string& out, Uint32 length) {
+        if (length > _bytes.size() - _offset) {
+            return false;
+        }
+
+        out.assign(reinterpret_cast<const char*>(_bytes.data() + _offset), length);
+        _offset += length;
+        return true;
+    }
+
+    bool skip(Uint64 size) {
+        if (size > _bytes.size() - _offset) {
+            return false;
+        }
+
+        _offset += size;
+        return true;
+    }
+
+    [[nodiscard]] size_t get_offset() const {
+        return _offset;
+    }
+
+private:
+    std::span<const std::byte> _bytes;
+    size_t _offset = 0;
+};
+
+Uint64 hash_path(std::string_view path) {
+    return hash_fnv1a_64(path.data(), path.size());
+}
+
+bool is_loose_file(const std::string& path) {
+    SDL_PathInfo info{};
+    return SDL_GetPathInfo(path.c_str(), &info) && info.type == SDL_PATHTYPE_FILE;
+}
+
+void free_stream_buffer(void*, void* value) {
+    SDL_free(value);
+}
+
+} // namespace
+
+std::string normalize_res_path(std::string_view path) {
+    if (path.starts_with(RES_PREFIX)) {
+        path.remove_prefix(RES_PREFIX.size());
+    }
+
+    std::string out;
+    out.reserve(path.size());
+
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find_first_of("/\\", start);
+        if (end == std::string_view::npos) {
+            end = path.size();
+        }
+
+        const std::string_view part = path.substr(start, end - start);
+
+        if (part == "..") {
+            const size_t slash = out.find_last_of('/');
+            out.erase(slash == std::string::npos ? 0 : slash);
+        } else if (!part.empty() && part != ".") {
+            if (!out.empty()) {
+                out += '/';
+            }
+            out += part;
+        }
+
+        start = end + 1;
+    }
+
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+// PackArchive
+// -----------------------------------------------------------------------------
+bool PackArchive::open(const std::string& file_path) {
+    _entries.clear();
+    _path = file_path;
+
+    if (!_file.open(file_path)) {
+        spdlog::error("Failed to open pack {}", file_path);
+        return false;
+    }
+
+    if (!parse_index()) {
+        spdlog::error("Pack {} is corrupted or has an unsupported version", file_path);
+        _entries.clear();
+        _file.close();
+        return false;
+    }
+
+    std::ranges::sort(_entries, [](const Entry& a, const Entry& b) { return a.hash != b.hash ? a.hash < b.hash : a.path < b.path; });
+
+    return true;
+}
+
+bool PackArchive::parse_index() {
+    const auto bytes = _file.bytes();
+    IndexReader reader(bytes);
+
+    Uint32 first = 0;
+    if (!reader.read(first)) {
+        return false;
+    }
+
+    // Version 1 has no header: file count, then each path followed by its zlib data
+    if (first != MAGIC) {
+        _entries.reserve(first);
+
+        for (Uint32 i = 0; i < first; ++i) {
+            Entry entry;
+            Uint32 path_length = 0;
+
+            if (!reader.read(path_length) || !reader.read_string(entry.path, path_length) || !reader.read(entry.packed_size)
+                || !reader.read(entry.size)) {
+                return false;
+            }
+
+            entry.offset = reader.get_offset();
+
+            if (!reader.skip(entry.packed_size)) {
+                return false;
+            }
+
+            entry.path = normalize_res_path(entry.path);
+            entry.hash = hash_path(entry.path);
+            _entries.push_back(std::move(entry));
+        }
+
+        return true;
+    }
+
+    Uint32 version = 0, count = 0, alignment = 0;
+    if (!reader.read(version) || !reader.read(count) || !reader.read(alignment) || version != VERSION) {
+        return false;
+    }
+
+    _entries.reserve(count);
+
+    for (Uint32 i = 0; i < count; ++i) {
+        Entry entry;
+        Uint32 path_length = 0;
+
+        if (!reader.read(path_length) || !reader.read_string(entry.path, path_length) || !reader.read(entry.flags) || !reader.read(entry.offset)
+            || !reader.read(entry.packed_size) || !reader.read(entry.size)) {
+            return false;
+        }
+
+        if (entry.offset > bytes.size() || entry.packed_size > bytes.size() - entry.offset
+            || (entry.is_stored() && entry.packed_size != entry.size)) {
+            return false;
+        }
+
+        entry.path = normalize_res_path(entry.path);
+        entry.hash = hash_path(entry.path);
+        _entries.push_back(std::move(entry));
+    }
+
+    return true;
+}
+
+const PackArchive::Entry* PackArchive::find(std::string_view path) const {
+    const Uint64 hash = hash_path(path);
+
+    auto it = std::ranges::lower_bound(_entries, hash, {}, &Entry::hash);
+
+    for (; it != _entries.end() && it->hash == hash; ++it) {
+        if (it->path == path) {
+            return &*it;
+        }
+    }
+
+    return nullptr;
+}
+
+std::span<const std::byte> PackArchive::view(const Entry& entry) const {
+    return _file.bytes().subspan(entry.offset, entry.packed_size);
+}
+
+bool PackArchive::read(const Entry& entry, std::span<std::byte> out) const {
+    if (out.size() < entry.size) {
+        return false;
+    }
+
+    const auto packed = view(entry);
+
+    if (entry.is_stored()) {
+        std::ranges::copy(packed, out.begin());
+        return true;
+    }
+
+    const int inflated = stbi_zlib_decode_buffer(reinterpret_cast<char*>(out.data()), static_cast<int>(entry.size),
+                                                 reinterpret_cast<const char*>(packed.data()), static_cast<int>(packed.size()));
+
+    if (inflated != static_cast<int>(entry.size)) {
+        spdlog::error("Failed to inflate {} from pack {}", entry.path, _path);
+        return false;
+    }
+
+    return true;
+}
+
+bool PackArchive::write(const std::string& file_path, const std::vector<Source>& files, Uint32 alignment) {
+    if (!std::has_single_bit(alignment)) {
+        spdlog::error("PackArchive::write - Alignment {} isn't a power of two", alignment);
+        return false;
+    }
+
+    const auto align_up = [alignment](Uint64 value) { return (value + alignment - 1) / alignment * alignment; };
+
+    std::vector<Uint64> sizes(files.size());
+    Uint64 index_size = 16;
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        SDL_PathInfo info{};
+        if (!SDL_GetPathInfo(files[i].file.c_str(), &info) || info.type != SDL_PATHTYPE_FILE || info.size > SDL_MAX_UINT32) {
+            spdlog::error("PackArchive::write - Can't pack {}", files[i].file);
+            return false;
+        }
+
+        sizes[i] = info.size;
+        index_size += 4 + files[i].path.size() + 4 + 8 + 4 + 4;
+    }
+
+    std::string index;
+    index.reserve(index_size);
+
+    const auto append = [&index](const auto& value) { index.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+    append(MAGIC);
+    append(VERSION);
+    append(static_cast<Uint32>(files.size()));
+    append(alignment);
+
+    std::vector<Uint64> offsets(files.size());
+    Uint64 offset = align_up(index_size);
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        offsets[i] = offset;
+        offset     = align_up(offset + sizes[i]);
+
+        append(static_cast<Uint32>(files[i].path.size()));
+        index += files[i].path;
+        append(static_cast<Uint32>(ENTRY_STORED));
+        append(offsets[i]);
+        append(static_cast<Uint32>(sizes[i]));
+        append(static_cast<Uint32>(sizes[i]));
+    }
+
+    SDL_IOStream* out = SDL_IOFromFile(file_path.c_str(), "wb");
+    if (!out) {
+        spdlog::error("PackArchive::write - Failed to create {}: {}", file_path, SDL_GetError());
+        return false;
+    }
+
+    const std::vector<char> padding(alignment, '\0');
+    bool is_written = SDL_WriteIO(out, index.data(), index.size()) == index.size();
+
+    for (size_t i = 0; i < files.size() && is_written; ++i) {
+        const Uint64 position = static_cast<Uint64>(SDL_TellIO(out));
+        is_written            = SDL_WriteIO(out, padding.data(), offsets[i] - position) == offsets[i] - position;
+
+        const MappedFile file(files[i].file);
+        if (sizes[i] > 0) {
+            is_written = is_written && file.size() == sizes[i] && SDL_WriteIO(out, file.data(), file.size()) == file.size();
+        }
+    }
+
+    if (!SDL_CloseIO(out) || !is_written) {
+        spdlog::error("PackArchive::write - Failed to write {}", file_path);
+        return false;
+    }
+
+    return true;
+}
+
+size_t PackArchive::get_entry_count() const {
+    return _entries.size();
+}
+
+const std::string& PackArchive::get_path() const {
+    return _path;
+}
+
+// -----------------------------------------------------------------------------
+// VirtualFileSystem
+// -----------------------------------------------------------------------------
+VirtualFileSystem& VirtualFileSystem::get() {
+    static VirtualFileSystem vfs;
+    return vfs;
+}
+
+bool VirtualFileSystem::mount_pack(const std::string& file_path) {
+    auto pack = std::make_unique<PackArchive>();
+
+    if (!pack->open(file_path)) {
+        return false;
+    }
+
+    spdlog::info("Mounted pack {} ({} files)", file_path, pack->get_entry_count());
+
+    std::unique_lock lock(_mutex);
+    _mounts.push_back({std::move(pack), {}});
+    return true;
+}
+
+bool VirtualFileSystem::mount_directory(const std::string& directory) {
+    SDL_PathInfo info{};
+
+    if (!SDL_GetPathInfo(directory.c_str(), &info) || info.type != SDL_PATHTYPE_DIRECTORY) {
+        spdlog::error("Failed to mount directory {}, not a directory", directory);
+        return false;
+    }
+
+    std::string path = directory;
+    if (path.back() != '/' && path.back() != '\\') {
+        path += '/';
+    }
+
+    spdlog::info("Mounted directory {}", path);
+
+    std::unique_lock lock(_mutex);
+    _mounts.push_back({nullptr, std::move(path)});
+    return true;
+}
+
+void VirtualFileSystem::unmount_all() {
+    std::unique_lock lock(_mutex);
+    _mounts.clear();
+}
+
+VirtualFileSystem::Lookup VirtualFileSystem::find(const std::string& path) const {
+    const std::string key = normalize_res_path(path);
+
+    std::shared_lock lock(_mutex);
+
+    for (auto it = _mounts.rbegin(); it != _mounts.rend(); ++it) {
+        if (it->pack) {
+            if (const auto* entry = it->pack->find(key)) {
+                return {it->pack.get(), entry, {}};
+            }
+        } else if (std::string loose = it->directory + key; is_loose_file(loose)) {
+            return {nullptr, nullptr, std::move(loose)};
+        }
+    }
+
+    return {nullptr, nullptr, ASSETS_PATH + key};
+}
+
+bool VirtualFileSystem::exists(const std::string& path) const {
+    const Lookup lookup = find(path);
+
+    if (lookup.entry) {
+        return true;
+    }
+
+    // Opened rather than stat'd, Android assets are only reachable through SDL_IOFromFile
+    SDL_IOStream* file = SDL_IOFromFile(lookup.loose_path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    SDL_CloseIO(file);
+    return true;
+}
+
+bool VirtualFileSystem::get_file_size(const std::string& path, size_t& out) const {
+    const Lookup lookup = find(path);
+
+    if (lookup.entry) {
+        out = lookup.entry->size;
+        return true;
+    }
+
+    SDL_IOStream* file = SDL_IOFromFile(lookup.loose_path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    const Sint64 size = SDL_GetIOSize(file);
+    SDL_CloseIO(file);
+
+    if (size < 0) {
+        return false;
+    }
+
+    out = static_cast<size_t>(size);
+    return true;
+}
+
+std::string VirtualFileSystem::get_loose_path(const std::string& path) const {
+    return find(path).loose_path;
+}
+
+std::span<const std::byte> VirtualFileSystem::view(const std::string& path) const {
+    const Lookup lookup = find(path);
+
+    if (!lookup.entry || !lookup.entry->is_stored()) {
+        return {};
+    }
+
+    return lookup.pack->view(*lookup.entry);
+}
+
+bool VirtualFileSystem::read(const std::string& path, std::span<std::byte> out) const {
+    const Lookup lookup = find(path);
+
+    if (lookup.entry) {
+        return lookup.pack->read(*lookup.entry, out);
+    }
+
+    SDL_IOStream* file = SDL_IOFromFile(lookup.loose_path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    const Sint64 size = SDL_GetIOSize(file);
+    const bool is_read = size >= 0 && static_cast<size_t>(size) <= out.size() && SDL_ReadIO(file, out.data(), size) == static_cast<size_t>(size);
+
+    SDL_CloseIO(file);
+    return is_read;
+}
+
+std::vector<char> VirtualFileSystem::read_all(const std::string& path) const {
+    const Lookup lookup = find(path);
+
+    if (lookup.entry) {
+        std::vector<char> buffer(lookup.entry->size);
+
+        if (!lookup.pack->read(*lookup.entry, std::as_writable_bytes(std::span(buffer)))) {
+            return {};
+        }
+
+        return buffer;
+    }
+
+    SDL_IOStream* file = SDL_IOFromFile(lookup.loose_path.c_str(), "rb");
+    if (!file) {
+        return {};
+    }
+
+    const Sint64 size = SDL_GetIOSize(file);
+    std::vector<char> buffer(size > 0 ? static_cast<size_t>(size) : 0);
+
+    if (buffer.empty() || SDL_ReadIO(file, buffer.data(), buffer.size()) != buffer.size()) {
+        buffer.clear();
+    }
+
+    SDL_CloseIO(file);
+    return buffer;
+}
+
+SDL_IOStream* VirtualFileSystem::open(const std::string& path) const {
+    const Lookup lookup = find(path);
+
+    if (!lookup.entry) {
+        return SDL_IOFromFile(lookup.loose_path.c_str(), "rb");
+    }
+
+    if (lookup.entry->is_stored()) {
+        const auto bytes = lookup.pack->view(*lookup.entry);
+        return SDL_IOFromConstMem(bytes.data(), bytes.size());
+    }
+
+    auto* buffer = static_cast<std::byte*>(SDL_malloc(lookup.entry->size));
+    if (!buffer) {
+        return nullptr;
+    }
+
+    SDL_IOStream* stream = nullptr;
+
+    if (!lookup.pack->read(*lookup.entry, {buffer, lookup.entry->size}) || !(stream = SDL_IOFromConstMem(buffer, lookup.entry->size))) {
+        SDL_free(buffer);
+        return nullptr;
+    }
+
+    // The inflated copy lives as long as the stream, SDL runs the cleanup on failure too
+    if (!SDL_SetPointerPropertyWithCleanup(SDL_GetIOProperties(stream), "vfs.buffer", buffer, free_stream_buffer, nullptr)) {
+        SDL_CloseIO(stream);
+        return nullptr;
+    }
+
+    return stream;
+}
@@ -0,0 +1,242 @@
+#include "core/renderer/asset_registry.h"
+#include "core/engine.h"
+
+SceneId AssetRegistry::create_scene() {
+    return _next_scene++;
+}
+
+void AssetRegistry::set_active_scene(SceneId scene) {
+    _active_scene = scene;
+}
+
+SceneId AssetRegistry::get_active_scene() const {
+    return _active_scene;
+}
+
+void AssetRegistry::register_mesh(MeshHandle handle, const std::string& path) {
+    const MeshInstance3D* mesh = GEngine->get_renderer()->_meshes.get_cold(handle);
+
+    if (!mesh || _assets.contains(AssetId::mesh(handle))) {
+        return;
+    }
+
+    AssetInfo info;
+    info.name = path;
+
+    if (mesh->geometry) {
+        info.cpu_bytes = mesh->geometry->vertices.size() * sizeof(Vertex) + mesh->geometry->indices.size() * sizeof(unsigned int);
+    }
+
+    info.gpu_bytes = (mesh->vertex_buffer ? mesh->vertex_buffer->size() : 0) + (mesh->index_buffer ? mesh->index_buffer->size() : 0);
+
+    _assets[AssetId::mesh(handle)] = std::move(info);
+}
+
+void AssetRegistry::register_material(MaterialHandle handle) {
+    const auto renderer      = GEngine->get_renderer();
+    const Material* material = renderer->_materials.get(handle);
+
+    if (!material || _assets.contains(AssetId::material(handle))) {
+        return;
+    }
+
+    AssetInfo info;
+    info.name      = *renderer->_materials.get_cold(handle);
+    info.cpu_bytes = sizeof(Material);
+
+    // Maps store texture objects, find the pooled textures behind them
+    const Uint32 maps[] = {material->albedo_map, material->metallic_map, material->roughness_map,
+                           material->normal_map, material->ao_map, material->emissive_map};
+
+    renderer->_textures.for_each([&](TextureHandle texture, const Uint32& object, const TextureInfo&) {
+        if (std::ranges::find(maps, object) == std::end(maps)) {
+            return;
+        }
+
+        const AssetId id = AssetId::texture(texture);
+
+        if (std::ranges::find(info.dependencies, id) == info.dependencies.end()) {
+            info.dependencies.push_back(id);
+        }
+    });
+
+    for (const AssetId& texture : info.dependencies) {
+        register_texture({texture.handle});
+        _assets[texture].ref_count++;
+        _assets[texture].destroy_frame = 0;
+    }
+
+    _assets[AssetId::material(handle)] = std::move(info);
+}
+
+void AssetRegistry::register_texture(TextureHandle handle) {
+    const TextureInfo* texture = GEngine->get_renderer()->_textures.get_cold(handle);
+
+    if (!texture || _assets.contains(AssetId::texture(handle))) {
+        return;
+    }
+
+    AssetInfo info;
+    info.name      = texture->name;
+    info.gpu_bytes = texture->gpu_bytes;
+
+    _assets[AssetId::texture(handle)] = std::move(info);
+}
+
+void AssetRegistry::acquire(AssetId id, SceneId scene) {
+    const auto it = _assets.find(id);
+
+    if (it == _assets.end()) {
+        spdlog::warn("AssetRegistry::acquire - Asset {} is not registered", id.handle);
+        return;
+    }
+
+    it->second.ref_count++;
+    it->second.destroy_frame = 0;
+    _scene_refs[scene][id]++;
+}
+
+void AssetRegistry::acquire(AssetId id) {
+    acquire(id, _active_scene);
+}
+
+void AssetRegistry::release(AssetId id, SceneId scene) {
+    const auto scene_it = _scene_refs.find(scene);
+    if (scene_it == _scene_refs.end()) {
+        return;
+    }
+
+    const auto ref_it = scene_it->second.find(id);
+    if (ref_it == scene_it->second.end()) {
+        spdlog::warn("AssetRegistry::release - Scene {} holds no reference on asset {}", scene, id.handle);
+        return;
+    }
+
+    if (--ref_it->second == 0) {
+        scene_it->second.erase(ref_it);
+    }
+
+    if (const auto it = _assets.find(id); it != _assets.end()) {
+        unreference(id, it->second, 1);
+    }
+}
+
+void AssetRegistry::unload_scene(SceneId scene) {
+    const auto scene_it = _scene_refs.find(scene);
+    if (scene_it == _scene_refs.end()) {
+        return;
+    }
+
+    const auto refs = std::move(scene_it->second);
+    _scene_refs.erase(scene_it);
+
+    for (const auto& [id, count] : refs) {
+        if (const auto it = _assets.find(id); it != _assets.end()) {
+            unreference(id, it->second, count);
+        }
+    }
+
+    spdlog::info("AssetRegistry::unload_scene - Scene {} released {} assets, {} queued for destruction", scene, refs.size(), _pending_destroy.size());
+}
+
+void AssetRegistry::collect(bool force) {
+    _frame++;
+
+    if (_pending_destroy.empty()) {
+        return;
+    }
+
+    // Destroying a material releases its textures, they are queued while iterating
+    const auto pending = std::move(_pending_destroy);
+    _pending_destroy.clear();
+
+    for (const AssetId& id : pending) {
+        const auto it = _assets.find(id);
+
+        // Acquired again since it was queued
+        if (it == _assets.end() || it->second.destroy_frame == 0) {
+            continue;
+        }
+
+        if (!force && it->second.destroy_frame > _frame) {
+            _pending_destroy.push_back(id);
+            continue;
+        }
+
+        destroy(id);
+    }
+
+    if (force && !_pending_destroy.empty()) {
+        collect(true);
+    }
+}
+
+const AssetInfo* AssetRegistry::find(AssetId id) const {
+    const auto it = _assets.find(id);
+    return it != _assets.end() ? &it->second : nullptr;
+}
+
+AssetMemoryStats AssetRegistry::get_memory_stats() const {
+    AssetMemoryStats stats;
+
+    for (const auto& [id, info] : _assets) {
+        stats.cpu_bytes += info.cpu_bytes;
+        stats.gpu_bytes += info.gpu_bytes;
+
+        switch (id.type) {
+            case AssetType::MESH:
+                stats.meshes++;
+                break;
+            case AssetType::MATERIAL:
+                stats.materials++;
+                break;
+            case AssetType::TEXTURE:
+                stats.textures++;
+                break;
+        }
+    }
+
+    stats.pending_destroy = static_cast<int>(_pending_destroy.size());
+    return stats;
+}
+
+void AssetRegistry::unreference(AssetId id, AssetInfo& info, int count) {
+    info.ref_count = std::max(info.ref_count - count, 0);
+
+    if (info.ref_count == 0 && info.destroy_frame == 0) {
+        info.destroy_frame = _frame + DESTROY_DELAY_FRAMES;
+        _pending_destroy.push_back(id);
+    }
+}
+
+void AssetRegistry::destroy(AssetId id) {
+    const auto it = _assets.find(id);
+    if (it == _assets.end()) {
+        return;
+    }
+
+    const AssetInfo info = std::move(it->second);
+    _assets.erase(it);
+
+    const auto renderer = GEngine->get_renderer();
+
+    switch (id.type) {
+        case AssetType::MESH:
+            renderer->remove_mesh({id.handle});
+            break;
+        case AssetType::MATERIAL:
+            renderer->remove_material({id.handle});
+            break;
+        case AssetType::TEXTURE:
+            renderer->remove_texture({id.handle});
+            break;
+    }
+
+    spdlog::debug("AssetRegistry::destroy - '{}' ({} KB CPU, {} KB GPU)", info.name, info.cpu_bytes / 1024, info.gpu_bytes / 1024);
+
+    for (const AssetId& dependency : info.dependencies) {
+        if (const auto dep_it = _assets.find(dependency); dep_it != _assets.end()) {
+            unreference(dependency, dep_it->second, 1);
+        }
+    }
+}
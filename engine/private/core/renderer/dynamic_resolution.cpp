@@ -0,0 +1,62 @@
+#include "core/renderer/dynamic_resolution.h"
+
+
+void DynamicResolution::configure(float target_ms, float min_scale, float max_scale) {
+    _target_ms = std::max(target_ms, 0.1f);
+    _max_scale = std::clamp(max_scale, SCALE_STEP, 1.0f);
+    _min_scale = std::clamp(min_scale, SCALE_STEP, _max_scale);
+    _scale     = _max_scale;
+
+    _sample_sum   = 0.0f;
+    _sample_count = 0;
+    _average_ms   = 0.0f;
+}
+
+bool DynamicResolution::update(float frame_ms) {
+    if (frame_ms <= 0.0f) {
+        return false;
+    }
+
+    _sample_sum += frame_ms;
+    _sample_count++;
+
+    if (_sample_count < SAMPLE_WINDOW) {
+        return false;
+    }
+
+    _average_ms   = _sample_sum / static_cast<float>(_sample_count);
+    _sample_sum   = 0.0f;
+    _sample_count = 0;
+
+    float next = _scale;
+
+    if (_average_ms > _target_ms * DOWNSCALE_THRESHOLD) {
+        // Pixel cost grows with the scale squared
+        next = _scale * std::sqrt(_target_ms / _average_ms);
+        next = std::min(next, _scale - SCALE_STEP);
+        next = std::floor(next / SCALE_STEP) * SCALE_STEP;
+    } else if (_average_ms < _target_ms * UPSCALE_THRESHOLD) {
+        next = std::round((_scale + SCALE_STEP) / SCALE_STEP) * SCALE_STEP;
+    }
+
+    next = std::clamp(next, _min_scale, _max_scale);
+
+    if (std::abs(next - _scale) < SCALE_STEP * 0.5f) {
+        return false;
+    }
+
+    _scale = next;
+    return true;
+}
+
+float DynamicResolution::get_scale() const {
+    return _scale;
+}
+
+float DynamicResolution::get_average_ms() const {
+    return _average_ms;
+}
+
+float DynamicResolution::get_target_ms() const {
+    return _target_ms;
+}
@@ -0,0 +1,685 @@
+#include "core/renderer/environment_baker.h"
+
+#include "core/utility/hash.h"
+#include "core/engine.h"
+
+#include <bit>
+
+namespace {
+
+constexpr float PI = 3.14159265359f;
+
+constexpr Uint32 CACHE_MAGIC = 0x564E4547; // "GENV"
+
+struct CacheHeader {
+    Uint32 magic;
+    Uint32 version;
+    Sint32 skybox_size;
+    Sint32 specular_size;
+    Sint32 specular_mips;
+    Sint32 brdf_lut_size;
+};
+
+/// Largest face or LUT a cache may declare, GL's common max texture size
+constexpr Sint32 MAX_CACHE_SIZE = 16384;
+
+/// Bytes following the header for these sizes, 0 when a field is out of range (corrupt or hostile cache)
+Uint64 get_cache_payload_size(const CacheHeader& header) {
+    const auto is_valid_size = [](Sint32 size) { return size > 0 && size <= MAX_CACHE_SIZE; };
+
+    if (!is_valid_size(header.skybox_size) || !is_valid_size(header.specular_size) || !is_valid_size(header.brdf_lut_size)
+        || header.specular_mips <= 0 || header.specular_mips > static_cast<int>(std::bit_width(static_cast<Uint32>(header.specular_size)))) {
+        return 0;
+    }
+
+    const auto square = [](Sint32 size) { return static_cast<Uint64>(size) * static_cast<Uint64>(size); };
+
+    Uint64 bytes = 9 * 3 * sizeof(float);
+    bytes += 6 * square(header.skybox_size) * 4;
+
+    for (int mip = 0; mip < header.specular_mips; ++mip) {
+        bytes += 6 * square(std::max(1, header.specular_size >> mip)) * 3 * sizeof(float);
+    }
+
+    return bytes + square(header.brdf_lut_size) * 2 * sizeof(float);
+}
+
+/// Linear RGB float cubemap with a box filtered mip chain, sampled on the CPU
+struct FloatCubemap {
+    std::vector<int> sizes;                                   /// [mip]
+    std::vector<std::array<std::vector<glm::vec3>, 6>> faces; /// [mip][face]
+};
+
+template <typename Fn>
+void parallel_for(int count, Fn&& fn) {
+    GEngine->get_job_system().parallel_for_each(count, fn);
+}
+
+/// Texel center of face `face` to a (non normalized) direction, GL cubemap convention
+glm::vec3 face_direction(int face, float u, float v) {
+    switch (face) {
+    case 0:
+        return {1.0f, -v, -u};
+    case 1:
+        return {-1.0f, -v, u};
+    case 2:
+        return {u, 1.0f, v};
+    case 3:
+        return {u, -1.0f, -v};
+    case 4:
+        return {u, -v, 1.0f};
+    default:
+        return {-u, -v, -1.0f};
+    }
+}
+
+glm::vec3 sample_face(const std::vector<glm::vec3>& pixels, int size, float s, float t) {
+    const float x = std::clamp(s * size - 0.5f, 0.0f, static_cast<float>(size - 1));
+    const float y = std::clamp(t * size - 0.5f, 0.0f, static_cast<float>(size - 1));
+
+    const int x0 = static_cast<int>(x);
+    const int y0 = static_cast<int>(y);
+    const int x1 = std::min(x0 + 1, size - 1);
+    const int y1 = std::min(y0 + 1, size - 1);
+
+    const float fx = x - x0;
+    const float fy = y - y0;
+
+    const glm::vec3 top    = glm::mix(pixels[y0 * size + x0], pixels[y0 * size + x1], fx);
+    const glm::vec3 bottom = glm::mix(pixels[y1 * size + x0], pixels[y1 * size + x1], fx);
+
+    return glm::mix(top, bottom, fy);
+}
+
+glm::vec3 sample_cubemap(const FloatCubemap& cubemap, const glm::vec3& dir, int mip) {
+    const glm::vec3 a = glm::abs(dir);
+
+    int face = 0;
+    float sc = 0.0f, tc = 0.0f, ma = 1.0f;
+
+    if (a.x >= a.y && a.x >= a.z) {
+        face = dir.x > 0.0f ? 0 : 1;
+        sc   = dir.x > 0.0f ? -dir.z : dir.z;
+        tc   = -dir.y;
+        ma   = a.x;
+    } else if (a.y >= a.z) {
+        face = dir.y > 0.0f ? 2 : 3;
+        sc   = dir.x;
+        tc   = dir.y > 0.0f ? dir.z : -dir.z;
+        ma   = a.y;
+    } else {
+        face = dir.z > 0.0f ? 4 : 5;
+        sc   = dir.z > 0.0f ? dir.x : -dir.x;
+        tc   = -dir.y;
+        ma   = a.z;
+    }
+
+    mip = std::clamp(mip, 0, static_cast<int>(cubemap.sizes.size()) - 1);
+
+    return sample_face(cubemap.faces[mip][face], cubemap.sizes[mip], (sc / ma + 1.0f) * 0.5f, (tc / ma + 1.0f) * 0.5f);
+}
+
+/// Area average resample of an RGBA8 face into a linear float face
+std::vector<glm::vec3> resample_face(const std::vector<unsigned char>& rgba, int src_size, int dst_size) {
+    std::vector<glm::vec3> out(static_cast<size_t>(dst_size) * dst_size);
+    const float ratio = static_cast<float>(src_size) / static_cast<float>(dst_size);
+
+    for (int y = 0; y < dst_size; ++y) {
+        const int sy0 = static_cast<int>(y * ratio);
+        const int sy1 = std::max(sy0 + 1, static_cast<int>((y + 1) * ratio));
+
+        for (int x = 0; x < dst_size; ++x) {
+            const int sx0 = static_cast<int>(x * ratio);
+            const int sx1 = std::max(sx0 + 1, static_cast<int>((x + 1) * ratio));
+
+            glm::vec3 sum(0.0f);
+            int count = 0;
+
+            for (int sy = sy0; sy < std::min(sy1, src_size); ++sy) {
+                for (int sx = sx0; sx < std::min(sx1, src_size); ++sx) {
+                    const unsigned char* px = &rgba[(static_cast<size_t>(sy) * src_size + sx) * 4];
+                    // Atlas is sRGB, lighting is computed in linear space
+                    sum += glm::pow(glm::vec3(px[0], px[1], px[2]) / 255.0f, glm::vec3(2.2f));
+                    count++;
+                }
+            }
+
+            out[static_cast<size_t>(y) * dst_size + x] = count > 0 ? sum / static_cast<float>(count) : glm::vec3(0.0f);
+        }
+    }
+
+    return out;
+}
+
+FloatCubemap build_float_cubemap(const CubemapFaces& faces, int size) {
+    FloatCubemap cubemap;
+    cubemap.sizes.push_back(size);
+    cubemap.faces.emplace_back();
+
+    parallel_for(6, [&](int face) {
+        cubemap.faces[0][face] = resample_face(faces.faces[face], faces.size, size);
+    });
+
+    while (cubemap.sizes.back() > 1) {
+        const int src = cubemap.sizes.back();
+        const int dst = src / 2;
+
+        std::array<std::vector<glm::vec3>, 6> level;
+        for (int face = 0; face < 6; ++face) {
+            const auto& in = cubemap.faces.back()[face];
+            auto& out      = level[face];
+            out.resize(static_cast<size_t>(dst) * dst);
+
+            for (int y = 0; y < dst; ++y) {
+                for (int x = 0; x < dst; ++x) {
+                    out[y * dst + x] = (in[(2 * y) * src + 2 * x] + in[(2 * y) * src + 2 * x + 1]
+                                        + in[(2 * y + 1) * src + 2 * x] + in[(2 * y + 1) * src + 2 * x + 1]) * 0.25f;
+                }
+            }
+        }
+
+        cubemap.sizes.push_back(dst);
+        cubemap.faces.push_back(std::move(level));
+    }
+
+    return cubemap;
+}
+
+glm::vec2 hammersley(Uint32 i, Uint32 count) {
+    Uint32 bits = i;
+    bits        = (bits << 16u) | (bits >> 16u);
+    bits        = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits        = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits        = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits        = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+
+    return {static_cast<float>(i) / static_cast<float>(count), static_cast<float>(bits) * 2.3283064365386963e-10f};
+}
+
+glm::vec3 importance_sample_ggx(const glm::vec2& xi, const glm::vec3& n, float roughness) {
+    const float a = roughness * roughness;
+
+    const float phi       = 2.0f * PI * xi.x;
+    const float cos_theta = std::sqrt((1.0f - xi.y) / (1.0f + (a * a - 1.0f) * xi.y));
+    const float sin_theta = std::sqrt(1.0f - cos_theta * cos_theta);
+
+    const glm::vec3 h(std::cos(phi) * sin_theta, std::sin(phi) * sin_theta, cos_theta);
+
+    const glm::vec3 up        = std::abs(n.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    const glm::vec3 tangent   = glm::normalize(glm::cross(up, n));
+    const glm::vec3 bitangent = glm::cross(n, tangent);
+
+    return glm::normalize(tangent * h.x + bitangent * h.y + n * h.z);
+}
+
+float distribution_ggx(float n_dot_h, float roughness) {
+    const float a     = roughness * roughness;
+    const float a2    = a * a;
+    const float denom = n_dot_h * n_dot_h * (a2 - 1.0f) + 1.0f;
+    return a2 / std::max(PI * denom * denom, 1e-7f);
+}
+
+float geometry_schlick_ggx_ibl(float n_dot_v, float roughness) {
+    const float k = (roughness * roughness) / 2.0f;
+    return n_dot_v / (n_dot_v * (1.0f - k) + k);
+}
+
+/// Karis, "Real Shading in Unreal Engine 4" - prefiltered radiance for the split-sum approximation
+std::vector<glm::vec3> prefilter_face(const FloatCubemap& source, int face, int size, float roughness) {
+    std::vector<glm::vec3> out(static_cast<size_t>(size) * size);
+
+    const float texel_solid_angle = 4.0f * PI / (6.0f * source.sizes[0] * source.sizes[0]);
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const float u = 2.0f * (x + 0.5f) / size - 1.0f;
+            const float v = 2.0f * (y + 0.5f) / size - 1.0f;
+
+            const glm::vec3 n = glm::normalize(face_direction(face, u, v));
+
+            if (roughness <= 0.0f) {
+                out[y * size + x] = sample_cubemap(source, n, 0);
+                continue;
+            }
+
+            glm::vec3 color(0.0f);
+            float weight = 0.0f;
+
+            for (Uint32 i = 0; i < EnvironmentBaker::SPECULAR_SAMPLES; ++i) {
+                const glm::vec3 h = importance_sample_ggx(hammersley(i, EnvironmentBaker::SPECULAR_SAMPLES), n, roughness);
+                const glm::vec3 l = glm::normalize(2.0f * glm::dot(n, h) * h - n);
+
+                const float n_dot_l = glm::dot(n, l);
+                if (n_dot_l <= 0.0f) {
+                    continue;
+                }
+
+                // Sample a lower source mip based on the sample pdf to avoid fireflies with few samples
+                const float n_dot_h     = std::max(glm::dot(n, h), 0.0f);
+                const float pdf         = distribution_ggx(n_dot_h, roughness) * 0.25f + 1e-4f;
+                const float sample_area = 1.0f / (EnvironmentBaker::SPECULAR_SAMPLES * pdf);
+                const float mip         = roughness == 0.0f ? 0.0f : 0.5f * std::log2(sample_area / texel_solid_angle);
+
+                color += sample_cubemap(source, l, static_cast<int>(std::round(std::max(mip, 0.0f)))) * n_dot_l;
+                weight += n_dot_l;
+            }
+
+            out[y * size + x] = weight > 0.0f ? color / weight : glm::vec3(0.0f);
+        }
+    }
+
+    return out;
+}
+
+std::array<glm::vec3, 9> project_irradiance_sh(const FloatCubemap& source) {
+    // Pick the mip closest to IRRADIANCE_SIZE, SH only keeps low frequencies
+    size_t mip = 0;
+    while (mip + 1 < source.sizes.size() && source.sizes[mip] > EnvironmentBaker::IRRADIANCE_SIZE) {
+        mip++;
+    }
+
+    const int size = source.sizes[mip];
+
+    std::array<std::array<glm::vec3, 9>, 6> per_face{};
+    std::array<float, 6> per_face_weight{};
+
+    parallel_for(6, [&](int face) {
+        auto& sh     = per_face[face];
+        float weight = 0.0f;
+
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const float u = 2.0f * (x + 0.5f) / size - 1.0f;
+                const float v = 2.0f * (y + 0.5f) / size - 1.0f;
+
+                const float temp        = 1.0f + u * u + v * v;
+                const float solid_angle = 4.0f / (size * size * temp * std::sqrt(temp));
+
+                const glm::vec3 d = glm::normalize(face_direction(face, u, v));
+                const glm::vec3 c = source.faces[mip][face][y * size + x] * solid_angle;
+
+                sh[0] += c * 0.282095f;
+                sh[1] += c * 0.488603f * d.y;
+                sh[2] += c * 0.488603f * d.z;
+                sh[3] += c * 0.488603f * d.x;
+                sh[4] += c * 1.092548f * d.x * d.y;
+                sh[5] += c * 1.092548f * d.y * d.z;
+                sh[6] += c * 0.315392f * (3.0f * d.z * d.z - 1.0f);
+                sh[7] += c * 1.092548f * d.x * d.z;
+                sh[8] += c * 0.546274f * (d.x * d.x - d.y * d.y);
+
+                weight += solid_angle;
+            }
+        }
+
+        per_face_weight[face] = weight;
+    });
+
+    std::array<glm::vec3, 9> sh{};
+    float total_weight = 0.0f;
+
+    for (int face = 0; face < 6; ++face) {
+        for (int i = 0; i < 9; ++i) {
+            sh[i] += per_face[face][i];
+        }
+        total_weight += per_face_weight[face];
+    }
+
+    // Normalize the solid angle approximation to 4PI, convolve with the clamped cosine lobe
+    // and divide by PI so the shader multiplies the result by albedo directly.
+    const float normalization = 4.0f * PI / total_weight;
+    constexpr float band[9]   = {PI, 2.0f * PI / 3.0f, 2.0f * PI / 3.0f, 2.0f * PI / 3.0f,
+                                 PI / 4.0f, PI / 4.0f, PI / 4.0f, PI / 4.0f, PI / 4.0f};
+
+    for (int i = 0; i < 9; ++i) {
+        sh[i] *= normalization * band[i] / PI;
+    }
+
+    return sh;
+}
+
+std::vector<float> integrate_brdf_lut(int size) {
+    std::vector<float> lut(static_cast<size_t>(size) * size * 2);
+
+    parallel_for(size, [&](int y) {
+        const float roughness = (y + 0.5f) / size;
+
+        for (int x = 0; x < size; ++x) {
+            const float n_dot_v = std::max((x + 0.5f) / size, 1e-3f);
+
+            const glm::vec3 v(std::sqrt(1.0f - n_dot_v * n_dot_v), 0.0f, n_dot_v);
+            const glm::vec3 n(0.0f, 0.0f, 1.0f);
+
+            float a = 0.0f;
+            float b = 0.0f;
+
+            for (Uint32 i = 0; i < EnvironmentBaker::BRDF_LUT_SAMPLES; ++i) {
+                const glm::vec3 h = importance_sample_ggx(hammersley(i, EnvironmentBaker::BRDF_LUT_SAMPLES), n, roughness);
+                const glm::vec3 l = glm::normalize(2.0f * glm::dot(v, h) * h - v);
+
+                const float n_dot_l = std::max(l.z, 0.0f);
+                const float n_dot_h = std::max(h.z, 0.0f);
+                const float v_dot_h = std::max(glm::dot(v, h), 0.0f);
+
+                if (n_dot_l <= 0.0f) {
+                    continue;
+                }
+
+                const float g     = geometry_schlick_ggx_ibl(n_dot_v, roughness) * geometry_schlick_ggx_ibl(n_dot_l, roughness);
+                const float g_vis = (g * v_dot_h) / (n_dot_h * n_dot_v + 1e-7f);
+                const float fc    = std::pow(1.0f - v_dot_h, 5.0f);
+
+                a += (1.0f - fc) * g_vis;
+                b += fc * g_vis;
+            }
+
+            lut[(static_cast<size_t>(y) * size + x) * 2 + 0] = a / EnvironmentBaker::BRDF_LUT_SAMPLES;
+            lut[(static_cast<size_t>(y) * size + x) * 2 + 1] = b / EnvironmentBaker::BRDF_LUT_SAMPLES;
+        }
+    });
+
+    return lut;
+}
+
+template <typename T>
+void append_bytes(std::vector<char>& out, const T* data, size_t count) {
+    const auto* bytes = reinterpret_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+bool read_bytes(const std::vector<char>& in, size_t& offset, T* data, size_t count) {
+    const size_t size = count * sizeof(T);
+    if (offset + size > in.size()) {
+        return false;
+    }
+
+    std::memcpy(data, in.data() + offset, size);
+    offset += size;
+    return true;
+}
+
+} // namespace
+
+
+bool EnvironmentBaker::extract_faces(const unsigned char* pixels, int W, int H, CubemapOrientation orient, CubemapFaces& out) {
+    if (W <= 0 || H <= 0) {
+        spdlog::error("Invalid atlas dimensions: {}x{}", W, H);
+        return false;
+    }
+
+    // Detect layout
+    int face_w                                                               = 0, face_h = 0;
+    enum Layout { HORIZONTAL, VERTICAL, L_3x2, L_4x3_CROSS, UNKNOWN } layout = UNKNOWN;
+
+    if (W % 6 == 0 && W / 6 == H) {
+        layout = HORIZONTAL;
+        face_w = W / 6;
+        face_h = H;
+    } else if (H % 6 == 0 && H / 6 == W) {
+        layout = VERTICAL;
+        face_w = W;
+        face_h = H / 6;
+    } else if (W % 3 == 0 && H % 2 == 0 && W / 3 == H / 2) {
+        layout = L_3x2;
+        face_w = W / 3;
+        face_h = H / 2;
+    } else if (W % 4 == 0 && H % 3 == 0 && W / 4 == H / 3) {
+        layout = L_4x3_CROSS;
+        face_w = W / 4;
+        face_h = H / 3;
+    } else {
+        spdlog::error("Unknown atlas layout: {}x{}", W, H);
+        return false;
+    }
+
+    if (face_w <= 0 || face_h <= 0 || face_w != face_h) {
+        spdlog::error("Invalid face dimensions: {}x{}", face_w, face_h);
+        return false;
+    }
+
+    spdlog::debug("Detected layout: {}, Face size: {}x{}", static_cast<int>(layout), face_w, face_h);
+
+    // Define face rectangles based on layout
+    struct Rect {
+        int x, y, w, h;
+    };
+    std::array<Rect, 6> face_rects;
+
+    if (layout == HORIZONTAL) {
+        for (int i = 0; i < 6; ++i) {
+            face_rects[i] = {i * face_w, 0, face_w, face_h};
+        }
+    } else if (layout == VERTICAL) {
+        for (int i = 0; i < 6; ++i) {
+            face_rects[i] = {0, i * face_h, face_w, face_h};
+        }
+    } else if (layout == L_3x2) {
+        face_rects[0] = {0, 0, face_w, face_h}; // +X
+        face_rects[1] = {1 * face_w, 0, face_w, face_h}; // -X
+        face_rects[2] = {2 * face_w, 0, face_w, face_h}; // +Y
+        face_rects[3] = {0, 1 * face_h, face_w, face_h}; // -Y
+        face_rects[4] = {1 * face_w, 1 * face_h, face_w, face_h}; // +Z
+        face_rects[5] = {2 * face_w, 1 * face_h, face_w, face_h}; // -Z
+    } else {
+        // L_4x3_CROSS
+        face_rects[0] = {2 * face_w, 1 * face_h, face_w, face_h}; // +X
+        face_rects[1] = {0, 1 * face_h, face_w, face_h}; // -X
+        face_rects[2] = {1 * face_w, 0, face_w, face_h}; // +Y
+        face_rects[3] = {1 * face_w, 2 * face_h, face_w, face_h}; // -Y
+        face_rects[4] = {1 * face_w, 1 * face_h, face_w, face_h}; // +Z
+        face_rects[5] = {3 * face_w, 1 * face_h, face_w, face_h}; // -Z
+    }
+
+    // Apply orientation adjustments
+    switch (orient) {
+    case CubemapOrientation::TOP:
+        std::swap(face_rects[2], face_rects[3]); // +Y <-> -Y
+        break;
+    case CubemapOrientation::BOTTOM:
+        std::swap(face_rects[2], face_rects[3]);
+        break;
+    case CubemapOrientation::FLIP_X:
+        std::swap(face_rects[0], face_rects[1]);
+        std::swap(face_rects[4], face_rects[5]);
+        break;
+    case CubemapOrientation::FLIP_Y:
+        std::swap(face_rects[2], face_rects[3]);
+        std::swap(face_rects[4], face_rects[5]);
+        break;
+    default:
+        break;
+    }
+
+    constexpr int BYTES_PER_PIXEL = 4;
+    const int pitch               = W * BYTES_PER_PIXEL;
+
+    out.size = face_w;
+
+    for (int i = 0; i < 6; ++i) {
+        const auto& r = face_rects[i];
+
+        if (r.x < 0 || r.y < 0 || r.x + r.w > W || r.y + r.h > H) {
+            spdlog::error("Face rect {} out of bounds: x={} y={} w={} h={} (atlas: {}x{})", i, r.x, r.y, r.w, r.h, W, H);
+            return false;
+        }
+
+        auto& face = out.faces[i];
+        face.resize(static_cast<size_t>(r.w) * r.h * BYTES_PER_PIXEL);
+
+        for (int y = 0; y < r.h; ++y) {
+            const unsigned char* src = pixels + (static_cast<size_t>(r.y + y) * pitch) + (r.x * BYTES_PER_PIXEL);
+            std::memcpy(face.data() + static_cast<size_t>(y) * r.w * BYTES_PER_PIXEL, src, r.w * BYTES_PER_PIXEL);
+        }
+    }
+
+    return true;
+}
+
+void EnvironmentBaker::bake(const CubemapFaces& faces, BakedEnvironment& out) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    out.skybox = faces;
+
+    const int base_size = std::min(SPECULAR_SIZE, std::max(1, faces.size));
+
+    const FloatCubemap source = build_float_cubemap(faces, base_size);
+
+    out.irradiance_sh = project_irradiance_sh(source);
+
+    out.specular_size = base_size;
+    out.specular_mips = static_cast<int>(source.sizes.size());
+    out.specular.assign(out.specular_mips, {});
+
+    // One job per (mip, face), roughness increases linearly with the mip level
+    parallel_for(out.specular_mips * 6, [&](int job) {
+        const int mip         = job / 6;
+        const int face        = job % 6;
+        const float roughness = out.specular_mips > 1 ? static_cast<float>(mip) / static_cast<float>(out.specular_mips - 1) : 0.0f;
+
+        const auto filtered = prefilter_face(source, face, source.sizes[mip], roughness);
+
+        auto& texels = out.specular[mip][face];
+        texels.resize(filtered.size() * 3);
+        std::memcpy(texels.data(), filtered.data(), texels.size() * sizeof(float));
+    });
+
+    out.brdf_lut_size = BRDF_LUT_SIZE;
+    out.brdf_lut      = integrate_brdf_lut(BRDF_LUT_SIZE);
+
+    const double elapsed = static_cast<double>(SDL_GetPerformanceCounter() - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    spdlog::info("EnvironmentBaker::bake - Baked environment ({} specular mips, {}x{} BRDF LUT) in {:.2f} ms",
+                 out.specular_mips, BRDF_LUT_SIZE, BRDF_LUT_SIZE, elapsed * 1000.0);
+}
+
+bool EnvironmentBaker::load_cache(const std::string& path, BakedEnvironment& out) {
+    if (!FileAccess::file_exists(path)) {
+        return false;
+    }
+
+    FileAccess file(path, ModeFlags::READ);
+    const auto bytes = file.get_file_as_bytes();
+
+    size_t offset = 0;
+    CacheHeader header{};
+
+    if (!read_bytes(bytes, offset, &header, 1) || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION) {
+        spdlog::warn("EnvironmentBaker::load_cache - Ignoring stale cache {}", path);
+        return false;
+    }
+
+    // Checked before anything is sized from the header
+    const Uint64 payload_size = get_cache_payload_size(header);
+    if (payload_size == 0 || offset + payload_size != bytes.size()) {
+        spdlog::warn("EnvironmentBaker::load_cache - Ignoring corrupt cache {}", path);
+        return false;
+    }
+
+    out.skybox.size    = header.skybox_size;
+    out.specular_size  = header.specular_size;
+    out.specular_mips  = header.specular_mips;
+    out.brdf_lut_size  = header.brdf_lut_size;
+
+    bool ok = read_bytes(bytes, offset, &out.irradiance_sh[0].x, 9 * 3);
+
+    for (int face = 0; ok && face < 6; ++face) {
+        out.skybox.faces[face].resize(static_cast<size_t>(out.skybox.size) * out.skybox.size * 4);
+        ok = read_bytes(bytes, offset, out.skybox.faces[face].data(), out.skybox.faces[face].size());
+    }
+
+    out.specular.assign(std::max(out.specular_mips, 0), {});
+    for (int mip = 0; ok && mip < out.specular_mips; ++mip) {
+        const int size = std::max(1, out.specular_size >> mip);
+        for (int face = 0; ok && face < 6; ++face) {
+            out.specular[mip][face].resize(static_cast<size_t>(size) * size * 3);
+            ok = read_bytes(bytes, offset, out.specular[mip][face].data(), out.specular[mip][face].size());
+        }
+    }
+
+    if (ok) {
+        out.brdf_lut.resize(static_cast<size_t>(out.brdf_lut_size) * out.brdf_lut_size * 2);
+        ok = read_bytes(bytes, offset, out.brdf_lut.data(), out.brdf_lut.size());
+    }
+
+    if (!ok) {
+        spdlog::warn("EnvironmentBaker::load_cache - Truncated cache {}", path);
+    }
+
+    return ok;
+}
+
+bool EnvironmentBaker::save_cache(const std::string& path, const BakedEnvironment& environment) {
+    std::vector<char> bytes;
+
+    const CacheHeader header{CACHE_MAGIC, CACHE_VERSION, environment.skybox.size, environment.specular_size,
+                             environment.specular_mips, environment.brdf_lut_size};
+
+    append_bytes(bytes, &header, 1);
+    append_bytes(bytes, &environment.irradiance_sh[0].x, 9 * 3);
+
+    for (const auto& face : environment.skybox.faces) {
+        append_bytes(bytes, face.data(), face.size());
+    }
+
+    for (const auto& mip : environment.specular) {
+        for (const auto& face : mip) {
+            append_bytes(bytes, face.data(), face.size());
+        }
+    }
+
+    append_bytes(bytes, environment.brdf_lut.data(), environment.brdf_lut.size());
+
+    FileAccess file(path, ModeFlags::WRITE);
+    return file.is_open() && file.store_bytes(bytes);
+}
+
+bool EnvironmentBaker::load_or_bake(const std::string& atlas_path, CubemapOrientation orient, BakedEnvironment& out) {
+    FileAccess source(atlas_path, ModeFlags::READ);
+
+    if (!source.is_open()) {
+        spdlog::error("Failed to open cubemap atlas: {}", atlas_path);
+        return false;
+    }
+
+    const auto encoded = source.get_file_as_bytes();
+
+    Uint64 key = hash_fnv1a_64(encoded.data(), encoded.size());
+    key        = hash_fnv1a_64(&orient, sizeof(orient), key);
+    key        = hash_fnv1a_64(&CACHE_VERSION, sizeof(CACHE_VERSION), key);
+
+    const std::string cache_path = "user://cache/ibl/" + hash_to_string(key) + ".genv";
+
+    if (load_cache(cache_path, out)) {
+        spdlog::info("EnvironmentBaker::load_or_bake - Loaded baked environment for {} from cache", atlas_path);
+        return true;
+    }
+
+    spdlog::debug("Loading cubemap atlas: {}", atlas_path);
+
+    int W, H, channels;
+    unsigned char* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()), static_cast<int>(encoded.size()),
+                                                  &W, &H, &channels, STBI_rgb_alpha);
+
+    if (!pixels) {
+        spdlog::error("Failed to load cubemap atlas: {}", atlas_path);
+        return false;
+    }
+
+    spdlog::debug("Atlas loaded: {}x{} channels: {}", W, H, channels);
+
+    CubemapFaces faces;
+    const bool extracted = extract_faces(pixels, W, H, orient, faces);
+    stbi_image_free(pixels);
+
+    if (!extracted) {
+        return false;
+    }
+
+    bake(faces, out);
+
+    if (!save_cache(cache_path, out)) {
+        spdlog::warn("EnvironmentBaker::load_or_bake - Failed to write cache {}", cache_path);
+    }
+
+    return true;
+}
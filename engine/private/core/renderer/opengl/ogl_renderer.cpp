@@ -29,145 +29,47 @@ void APIENTRY ogl_validation_layer(
 }
 
 
-GLuint load_cubemap_from_atlas(const std::string& atlas_path, CubemapOrientation orient = CubemapOrientation::DEFAULT) {
-    spdlog::debug("Loading cubemap atlas: {}", atlas_path);
-
-    int W, H, channels;
-    unsigned char* pixels = stbi_load(atlas_path.c_str(), &W, &H, &channels, STBI_rgb_alpha);
-
-    if (!pixels) {
-        spdlog::error("Failed to load cubemap atlas: {}", atlas_path);
-        return 0;
-    }
-
-    spdlog::debug("Atlas loaded: {}x{} channels: {}", W, H, channels);
+/// World space bounding sphere of a mesh instance, xyz = center, w = radius
+glm::vec4 get_world_bounding_sphere(const MeshDrawData& mesh, const glm::mat4& model) {
+    const glm::vec3 center = glm::vec3(model * glm::vec4(mesh.bounds_center, 1.0f));
+    const float scale      = std::max({glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))});
+    return {center, mesh.bounds_radius * scale};
+}
 
-    if (W <= 0 || H <= 0) {
-        spdlog::error("Invalid atlas dimensions: {}x{}", W, H);
-        stbi_image_free(pixels);
-        return 0;
-    }
 
-    // Detect layout
-    int face_w                                                               = 0, face_h = 0;
-    enum Layout { HORIZONTAL, VERTICAL, L_3x2, L_4x3_CROSS, UNKNOWN } layout = UNKNOWN;
-
-    if (W % 6 == 0 && W / 6 == H) {
-        layout = HORIZONTAL;
-        face_w = W / 6;
-        face_h = H;
-    } else if (H % 6 == 0 && H / 6 == W) {
-        layout = VERTICAL;
-        face_w = W;
-        face_h = H / 6;
-    } else if (W % 3 == 0 && H % 2 == 0 && W / 3 == H / 2) {
-        layout = L_3x2;
-        face_w = W / 3;
-        face_h = H / 2;
-    } else if (W % 4 == 0 && H % 3 == 0 && W / 4 == H / 3) {
-        layout = L_4x3_CROSS;
-        face_w = W / 4;
-        face_h = H / 3;
-    } else {
-        spdlog::error("Unknown atlas layout: {}x{}", W, H);
-        stbi_image_free(pixels);
-        return 0;
-    }
+GLuint upload_skybox_cubemap(const CubemapFaces& faces) {
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id);
 
-    if (face_w <= 0 || face_h <= 0) {
-        spdlog::error("Invalid face dimensions: {}x{}", face_w, face_h);
-        stbi_image_free(pixels);
-        return 0;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int i = 0; i < 6; ++i) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA,
+                     faces.size, faces.size, 0, GL_RGBA, GL_UNSIGNED_BYTE, faces.faces[i].data());
     }
 
-    spdlog::debug("Detected layout: {}, Face size: {}x{}", static_cast<int>(layout), face_w, face_h);
-
-    // Define face rectangles based on layout
-    struct Rect {
-        int x, y, w, h;
-    };
-    std::array<Rect, 6> face_rects;
+    // The skybox is only sampled at mip 0, lighting uses the prefiltered cubemap
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-    if (layout == HORIZONTAL) {
-        for (int i = 0; i < 6; ++i) {
-            face_rects[i] = {i * face_w, 0, face_w, face_h};
-        }
-    } else if (layout == VERTICAL) {
-        for (int i = 0; i < 6; ++i) {
-            face_rects[i] = {0, i * face_h, face_w, face_h};
-        }
-    } else if (layout == L_3x2) {
-        face_rects[0] = {0, 0, face_w, face_h}; // +X
-        face_rects[1] = {1 * face_w, 0, face_w, face_h}; // -X
-        face_rects[2] = {2 * face_w, 0, face_w, face_h}; // +Y
-        face_rects[3] = {0, 1 * face_h, face_w, face_h}; // -Y
-        face_rects[4] = {1 * face_w, 1 * face_h, face_w, face_h}; // +Z
-        face_rects[5] = {2 * face_w, 1 * face_h, face_w, face_h}; // -Z
-    } else {
-        // L_4x3_CROSS
-        face_rects[0] = {2 * face_w, 1 * face_h, face_w, face_h}; // +X
-        face_rects[1] = {0, 1 * face_h, face_w, face_h}; // -X
-        face_rects[2] = {1 * face_w, 0, face_w, face_h}; // +Y
-        face_rects[3] = {1 * face_w, 2 * face_h, face_w, face_h}; // -Y
-        face_rects[4] = {1 * face_w, 1 * face_h, face_w, face_h}; // +Z
-        face_rects[5] = {3 * face_w, 1 * face_h, face_w, face_h}; // -Z
-    }
-
-    // Apply orientation adjustments
-    switch (orient) {
-    case CubemapOrientation::TOP:
-        std::swap(face_rects[2], face_rects[3]); // +Y <-> -Y
-        break;
-    case CubemapOrientation::BOTTOM:
-        std::swap(face_rects[2], face_rects[3]);
-        break;
-    case CubemapOrientation::FLIP_X:
-        std::swap(face_rects[0], face_rects[1]);
-        std::swap(face_rects[4], face_rects[5]);
-        break;
-    case CubemapOrientation::FLIP_Y:
-        std::swap(face_rects[2], face_rects[3]);
-        std::swap(face_rects[4], face_rects[5]);
-        break;
-    default:
-        break;
-    }
-
-    // Validate rectangles
-    for (int i = 0; i < 6; ++i) {
-        const auto& r = face_rects[i];
-        if (r.x < 0 || r.y < 0 || r.x + r.w > W || r.y + r.h > H) {
-            spdlog::error("Face rect {} out of bounds: x={} y={} w={} h={} (atlas: {}x{})",
-                          i, r.x, r.y, r.w, r.h, W, H);
-            stbi_image_free(pixels);
-            return 0;
-        }
-    }
+    return texture_id;
+}
 
-    // Create cubemap texture
+GLuint upload_prefiltered_cubemap(const BakedEnvironment& environment) {
     GLuint texture_id;
     glGenTextures(1, &texture_id);
     glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id);
 
-    constexpr int BYTES_PER_PIXEL = 4;
-    int pitch                     = W * BYTES_PER_PIXEL;
-    std::vector<unsigned char> face_data(face_w * face_h * BYTES_PER_PIXEL);
-
-    // Extract and upload each face
-    for (int i = 0; i < 6; ++i) {
-        const auto& r = face_rects[i];
-
-        // Copy face data row by row
-        for (int y = 0; y < r.h; ++y) {
-            int row            = r.y + y;
-            unsigned char* src = pixels + (row * pitch) + (r.x * BYTES_PER_PIXEL);
-            unsigned char* dst = face_data.data() + (y * r.w * BYTES_PER_PIXEL);
-            std::memcpy(dst, src, r.w * BYTES_PER_PIXEL);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int mip = 0; mip < environment.specular_mips; ++mip) {
+        const int size = std::max(1, environment.specular_size >> mip);
+        for (int i = 0; i < 6; ++i) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB16F,
+                         size, size, 0, GL_RGB, GL_FLOAT, environment.specular[mip][i].data());
         }
-
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA,
-                     r.w, r.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, face_data.data());
     }
 
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -175,12 +77,24 @@ GLuint load_cubemap_from_atlas(const std::string& atlas_path, CubemapOrientation
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, environment.specular_mips - 1);
 
-    stbi_image_free(pixels);
+    return texture_id;
+}
 
-    spdlog::info("Loaded cubemap atlas {} ({}x{}) Layout {} Face {}x{} Texture ID: {}",
-                 atlas_path, W, H, static_cast<int>(layout), face_w, face_h, texture_id);
+GLuint upload_brdf_lut(const BakedEnvironment& environment) {
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, environment.brdf_lut_size, environment.brdf_lut_size, 0,
+                 GL_RG, GL_FLOAT, environment.brdf_lut.data());
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
     return texture_id;
 }
@@ -266,28 +180,41 @@ WorldEnvironment* OpenGLRenderer::create_skybox_from_atlas(const std::string& at
 
     spdlog::info("Skybox geometry initialized");
 
-    GLuint cubemap = load_cubemap_from_atlas(atlas_path, orient);
+    BakedEnvironment baked;
 
-    if (cubemap == 0) {
+    if (!EnvironmentBaker::load_or_bake(atlas_path, orient, baked)) {
         spdlog::error("Failed to create skybox from atlas - loading failed");
         return world_environment;
     }
 
-    world_environment->texture = cubemap;
-    spdlog::info("Skybox created from atlas successfully");
+    world_environment->texture             = upload_skybox_cubemap(baked.skybox);
+    world_environment->prefiltered_texture = upload_prefiltered_cubemap(baked);
+    world_environment->prefiltered_mips    = baked.specular_mips;
+    world_environment->brdf_lut_texture    = upload_brdf_lut(baked);
+    world_environment->irradiance_sh       = baked.irradiance_sh;
+    world_environment->brightness          = brightness;
 
-    _textures[atlas_path] = cubemap;
+    spdlog::info("Skybox created from atlas successfully ({}x{} faces, {} prefiltered mips) Texture ID: {}",
+                 baked.skybox.size, baked.skybox.size, baked.specular_mips, world_environment->texture);
 
-    instance_buffer    = allocate_gpu_buffer(GpuBufferType::STORAGE);
-    size_t buffer_size = max_instances * sizeof(glm::mat4);
-    instance_buffer->upload(nullptr, buffer_size);
+    add_texture(atlas_path, world_environment->texture);
+    add_texture(atlas_path + "#prefiltered", world_environment->prefiltered_texture);
+    add_texture(atlas_path + "#brdf_lut", world_environment->brdf_lut_texture);
+
+    // Constant for the lifetime of the environment, set once instead of per frame
+    _default_shader->activate();
+    for (int i = 0; i < 9; ++i) {
+        _default_shader->set_value(fmt::format("IRRADIANCE_SH[{}]", i), world_environment->irradiance_sh[i], 1);
+    }
+    _default_shader->set_value("PREFILTER_MAX_LOD", static_cast<float>(std::max(world_environment->prefiltered_mips - 1, 0)));
+    _default_shader->set_value("USE_IBL", true);
 
     return world_environment;
 }
 
-void OpenGLRenderer::setup_instance_matrix_attribute(GpuVertexLayout* vao) {
+void OpenGLRenderer::setup_instance_matrix_attribute(const GpuVertexLayout* vao, const GpuBuffer* instances) {
     vao->bind();
-    instance_buffer->bind();
+    instances->bind();
 
     for (int i = 0; i < 4; i++) {
         GLuint location = 3 + i;
@@ -357,6 +284,167 @@ GLuint OpenGLRenderer::create_gl_texture(const unsigned char* data, int w, int h
     return texID;
 }
 
+GLuint OpenGLRenderer::create_streamed_texture(const unsigned char* data, int w, int h, int channels, TextureResidencyEntry entry) {
+    if (!_texture_residency.is_enabled()) {
+        return create_gl_texture(data, w, h, channels);
+    }
+
+    GLuint texID = 0;
+    glGenTextures(1, &texID);
+    glBindTexture(GL_TEXTURE_2D, texID);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Start with the low resolution tail only, screen-size feedback streams in the rest
+    TextureMipChain chain;
+    chain.id       = texID;
+    chain.channels = channels;
+    chain.base_mip = TextureResidency::compute_min_mip(w, h);
+    chain.levels   = TextureResidency::build_mip_chain(data, w, h, channels, chain.base_mip);
+
+    upload_texture_levels(texID, chain);
+
+    entry.id           = texID;
+    entry.width        = w;
+    entry.height       = h;
+    entry.channels     = channels;
+    entry.resident_mip = chain.base_mip;
+
+    _texture_residency.register_texture(std::move(entry));
+
+    return texID;
+}
+
+void OpenGLRenderer::upload_texture_levels(GLuint texture, const TextureMipChain& chain) {
+    GLenum format = GL_RGB;
+    if (chain.channels == 1)
+        format = GL_RED;
+    else if (chain.channels == 3)
+        format = GL_RGB;
+    else if (chain.channels == 4)
+        format = GL_RGBA;
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // Re-specify the texture in place, level 0 is always the finest resident mip
+    for (size_t level = 0; level < chain.levels.size(); ++level) {
+        const auto& mip = chain.levels[level];
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format, mip.width, mip.height, 0, format, GL_UNSIGNED_BYTE, mip.pixels.data());
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(chain.levels.size()) - 1);
+}
+
+void OpenGLRenderer::drop_texture_levels(GLuint texture, const TextureResidencyEntry& entry, int base_mip) {
+    GLenum format = GL_RGB;
+    if (entry.channels == 1)
+        format = GL_RED;
+    else if (entry.channels == 3)
+        format = GL_RGB;
+    else if (entry.channels == 4)
+        format = GL_RGBA;
+
+    const int shift           = base_mip - entry.resident_mip;
+    const int level_count     = entry.mip_count - base_mip;
+    const int old_level_count = entry.mip_count - entry.resident_mip;
+
+    GLint previous_read = 0, previous_draw = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_read);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous_draw);
+
+    GLuint fbos[2] = {};
+    glGenFramebuffers(2, fbos);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbos[0]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbos[1]);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Ascending, level `level` takes the old level `level + shift` which is only re-specified afterwards
+    for (int level = 0; level < level_count; ++level) {
+        const int w = std::max(1, entry.width >> (base_mip + level));
+        const int h = std::max(1, entry.height >> (base_mip + level));
+
+        glTexImage2D(GL_TEXTURE_2D, level, format, w, h, 0, format, GL_UNSIGNED_BYTE, nullptr);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, level + shift);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, level);
+        glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    // Release the old tail past the new chain
+    for (int level = level_count; level < old_level_count; ++level) {
+        glTexImage2D(GL_TEXTURE_2D, level, format, 0, 0, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous_read));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previous_draw));
+    glDeleteFramebuffers(2, fbos);
+}
+
+void OpenGLRenderer::stream_textures() {
+    if (!_texture_residency.is_enabled()) {
+        return;
+    }
+
+    _texture_residency.update(_frame_index);
+
+    // Evictions re-specify the texture from its resident levels, the decoder only raises quality
+    for (const auto& downgrade : _texture_residency.pop_downgrades()) {
+        const TextureResidencyEntry* entry = _texture_residency.find(downgrade.id);
+
+        drop_texture_levels(downgrade.id, *entry, downgrade.base_mip);
+        _texture_residency.mark_resident(downgrade.id, downgrade.base_mip,
+                                         TextureResidency::compute_bytes(entry->width, entry->height, entry->channels, downgrade.base_mip, entry->mip_count));
+    }
+
+    // Only chains of live registrations are popped, textures are destroyed on this thread
+    for (const auto& chain : _texture_residency.pop_ready(TEXTURE_UPLOAD_BUDGET)) {
+        upload_texture_levels(chain.id, chain);
+        _texture_residency.mark_resident(chain.id, chain.base_mip, chain.size_bytes());
+    }
+}
+
+void OpenGLRenderer::request_texture_feedback(RenderBatch& batch, const MeshDrawData& mesh, const Material& material,
+                                              const glm::vec3& camera_position, float pixels_per_unit) {
+    if (batch.is_bounds_dirty) {
+        glm::vec3 min(std::numeric_limits<float>::max());
+        glm::vec3 max(std::numeric_limits<float>::lowest());
+        batch.max_instance_radius = 0.0f;
+
+        for (const auto& model : batch.model_matrices) {
+            const glm::vec4 sphere = get_world_bounding_sphere(mesh, model);
+
+            min = glm::min(min, glm::vec3(sphere) - sphere.w);
+            max = glm::max(max, glm::vec3(sphere) + sphere.w);
+            batch.max_instance_radius = std::max(batch.max_instance_radius, sphere.w);
+        }
+
+        batch.bounds = batch.model_matrices.size() == 1 ? get_world_bounding_sphere(mesh, batch.model_matrices[0])
+                                                        : glm::vec4((min + max) * 0.5f, glm::length(max - min) * 0.5f);
+        batch.is_bounds_dirty = false;
+    }
+
+    // The largest instance at the nearest point of the batch bounds: never below the size of any instance,
+    // exact for single instances (static chunks), conservative for batches spread around the camera
+    const float distance   = std::max(glm::distance(camera_position, glm::vec3(batch.bounds)) - batch.bounds.w, 0.1f);
+    const float max_pixels = 2.0f * batch.max_instance_radius / distance * pixels_per_unit;
+
+    const Uint32 maps[] = {material.albedo_map, material.metallic_map, material.roughness_map,
+                           material.normal_map, material.ao_map, material.emissive_map};
+
+    for (const Uint32 map : maps) {
+        if (map) {
+            _texture_residency.request_screen_size(map, max_pixels, _frame_index);
+        }
+    }
+}
+
 OpenGLRenderer::~OpenGLRenderer() {
     OpenGLRenderer::cleanup();
 }
@@ -414,7 +502,23 @@ bool OpenGLRenderer::initialize(int w, int h, SDL_Window* window) {
 #endif
     _context = glContext;
 
-    SDL_GL_SetSwapInterval(0);
+    // Adaptive vsync tears instead of stalling on late frames, not every driver supports it
+    _swap_interval = 0;
+    if (GEngine->get_config().is_vsync()) {
+        if (SDL_GL_SetSwapInterval(-1)) {
+            _swap_interval = -1;
+        } else if (SDL_GL_SetSwapInterval(1)) {
+            _swap_interval = 1;
+        } else {
+            spdlog::warn("OpenGLRenderer::initialize - VSync not available: {}", SDL_GetError());
+        }
+    }
+
+    if (_swap_interval == 0) {
+        SDL_GL_SetSwapInterval(0);
+    }
+
+    spdlog::info("OpenGLRenderer::initialize - Swap interval {}", _swap_interval);
 
     width  = w;
     height = h;
@@ -458,8 +562,15 @@ bool OpenGLRenderer::initialize(int w, int h, SDL_Window* window) {
     spdlog::info("OpenGL Renderer: {}", gl_renderer);
 
     glEnable(GL_DEPTH_TEST);
+#if !defined(SDL_PLATFORM_IOS) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+    // Filter across cubemap face edges, always on in GLES 3.0
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+#endif
     glViewport(0, 0, width, height);
 
+    const size_t texture_budget = static_cast<size_t>(GEngine->get_config().get_renderer_device().texture_budget_mb) * 1024 * 1024;
+    _texture_residency.start(texture_budget);
+
     _default_shader = std::make_unique<OpenglShader>("shaders/opengl/default.vert", "shaders/opengl/default.frag");
     _default_shader->set_value("USE_IBL", false);
 
@@ -474,6 +585,41 @@ bool OpenGLRenderer::initialize(int w, int h, SDL_Window* window) {
     };
 
     shadow_map_fbo     = std::make_shared<OpenGLFramebuffer>(spec);
+
+    const auto& viewport = GEngine->get_config().get_viewport();
+    const int max_fps    = GEngine->get_config().get_application().max_fps;
+
+    _dynamic_resolution_enabled = viewport.dynamic_resolution;
+    _upscale_sharpness          = viewport.sharpness;
+    _dynamic_resolution.configure(1000.0f / static_cast<float>(max_fps > 0 ? max_fps : 60),
+                                  _dynamic_resolution_enabled ? viewport.min_scale : viewport.scale, viewport.scale);
+
+    if (_dynamic_resolution_enabled || viewport.scale < 1.0f) {
+        FramebufferSpecification scene_spec;
+        scene_spec.width       = width;
+        scene_spec.height      = height;
+        scene_spec.attachments = {
+            {FramebufferTextureFormat::RGBA8},
+            {FramebufferTextureFormat::DEPTH24STENCIL8}
+        };
+
+        _scene_fbo      = std::make_shared<OpenGLFramebuffer>(scene_spec);
+        _upscale_shader = std::make_unique<OpenglShader>("shaders/opengl/upscale.vert", "shaders/opengl/upscale.frag");
+        glGenVertexArrays(1, &_upscale_vao);
+
+        spdlog::info("OpenGLRenderer::initialize - Render scale {:.2f}, dynamic resolution {} (min {:.2f}, target {:.2f} ms)",
+                     viewport.scale, _dynamic_resolution_enabled, viewport.min_scale, _dynamic_resolution.get_target_ms());
+    }
+
+#if !defined(SDL_PLATFORM_IOS) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+    if (_dynamic_resolution_enabled) {
+        glGenQueries(GPU_TIMER_QUERIES, _gpu_timer_queries.data());
+    }
+#endif
+
+    _last_swap_counter = SDL_GetPerformanceCounter();
+    update_render_size();
+
     _world_environment = create_skybox_from_atlas("res/environment_sky.png", CubemapOrientation::DEFAULT, 1.0f);
     return true;
 }
@@ -489,20 +635,19 @@ std::shared_ptr<GpuVertexLayout> OpenGLRenderer::create_vertex_layout(const GpuB
 }
 
 GLuint OpenGLRenderer::load_texture_from_file(const std::string& path) {
-    if (auto it = _textures.find(path); it != _textures.end())
-        return it->second;
+    if (auto it = _texture_names.find(path); it != _texture_names.end()) {
+        if (const Uint32* texture = _textures.get(it->second))
+            return *texture;
+    }
 
-    int w, h, channels;
-    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 0);
-    if (!data) {
+    // Decoding stays on the calling thread, only the GL upload needs the context
+    const TextureImage image = decode_texture_file(path);
+    if (!image.pixels) {
         spdlog::error("Failed to load texture: {}", path);
         return 0;
     }
 
-    GLuint texID = create_gl_texture(data, w, h, channels);
-    stbi_image_free(data);
-
-    _textures[path] = texID;
+    const GLuint texID = create_texture(image);
     spdlog::info("Loaded Texture: {}", path);
     return texID;
 }
@@ -510,20 +655,18 @@ GLuint OpenGLRenderer::load_texture_from_file(const std::string& path) {
 GLuint OpenGLRenderer::load_texture_from_memory(const unsigned char* buffer, size_t size, const std::string& name) {
     std::string key = name.empty() ? "embedded_tex_" + std::to_string(reinterpret_cast<size_t>(buffer)) : name;
 
-    if (auto it = _textures.find(key); it != _textures.end())
-        return it->second;
+    if (auto it = _texture_names.find(key); it != _texture_names.end()) {
+        if (const Uint32* texture = _textures.get(it->second))
+            return *texture;
+    }
 
-    int w, h, channels;
-    unsigned char* data = stbi_load_from_memory(buffer, (int) size, &w, &h, &channels, 0);
-    if (!data) {
+    const TextureImage image = decode_texture_memory(buffer, size, key);
+    if (!image.pixels) {
         spdlog::error("Failed to load texture from memory: {}", key);
         return 0;
     }
 
-    GLuint texID = create_gl_texture(data, w, h, channels);
-    stbi_image_free(data);
-
-    _textures[key] = texID;
+    const GLuint texID = create_texture(image);
     spdlog::info("Loaded embedded Texture: {}, Path {}", texID, key);
     return texID;
 }
@@ -531,27 +674,166 @@ GLuint OpenGLRenderer::load_texture_from_memory(const unsigned char* buffer, siz
 GLuint OpenGLRenderer::load_texture_from_raw_data(const unsigned char* data, int w, int h, int channels, const std::string& name) {
     std::string key = name.empty() ? "raw_" + std::to_string(reinterpret_cast<size_t>(data)) : name;
 
-    if (auto it = _textures.find(key); it != _textures.end())
-        return it->second;
-
-    GLuint texID   = create_gl_texture(data, w, h, channels);
-    _textures[key] = texID;
+    const GLuint texID = create_texture(wrap_texture_raw(data, w, h, channels, key));
     spdlog::info("Loaded raw Texture: {}, Path {}", texID, key);
 
     return texID;
 }
 
+GLuint OpenGLRenderer::create_texture(const TextureImage& image) {
+    if (auto it = _texture_names.find(image.name); it != _texture_names.end()) {
+        if (const Uint32* texture = _textures.get(it->second))
+            return *texture;
+    }
+
+    if (!image.pixels) {
+        return 0;
+    }
+
+    const unsigned char* pixels = image.pixels.get();
+    const int w                 = image.width;
+    const int h                 = image.height;
+    const int channels          = image.channels;
+
+    TextureResidencyEntry entry;
+    entry.name        = image.name;
+    entry.source_type = image.source_type;
+
+    if (_texture_residency.is_enabled()) {
+        if (image.source_type == TextureSourceType::MEMORY) {
+            entry.source = std::make_shared<const std::vector<unsigned char>>(image.encoded.begin(), image.encoded.end());
+        } else if (image.source_type == TextureSourceType::RAW) {
+            entry.source = std::make_shared<const std::vector<unsigned char>>(pixels, pixels + static_cast<size_t>(w) * h * channels);
+        }
+    }
+
+    GLuint texID = 0;
+    GEngine->run_on_render_thread([&] { texID = create_streamed_texture(pixels, w, h, channels, std::move(entry)); });
+
+    add_texture(image.name, texID, TextureResidency::compute_bytes(w, h, channels, 0, TextureResidency::compute_mip_count(w, h)));
+    return texID;
+}
+
+void OpenGLRenderer::update_render_size() {
+    _stats.render_scale  = _scene_fbo ? _dynamic_resolution.get_scale() : 1.0f;
+    _stats.render_width  = std::max(1, static_cast<int>(static_cast<float>(width) * _stats.render_scale));
+    _stats.render_height = std::max(1, static_cast<int>(static_cast<float>(height) * _stats.render_scale));
+}
+
+void OpenGLRenderer::update_dynamic_resolution() {
+    if (!_dynamic_resolution_enabled) {
+        return;
+    }
+
+    float frame_ms = 0.0f;
+
+#if !defined(SDL_PLATFORM_IOS) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+    // GPU time of the oldest query in the ring, it is reused next frame
+    _gpu_timer_index = (_gpu_timer_index + 1) % GPU_TIMER_QUERIES;
+
+    if (_frame_index >= GPU_TIMER_QUERIES) {
+        const GLuint query = _gpu_timer_queries[_gpu_timer_index];
+        GLint available    = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (available) {
+            GLuint64 elapsed_ns = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed_ns);
+            frame_ms = static_cast<float>(static_cast<double>(elapsed_ns) / 1.0e6);
+        }
+    }
+#else
+    // No timer queries in GLES 3.0, fall back to the CPU frame interval
+    const Uint64 now = SDL_GetPerformanceCounter();
+    frame_ms         = static_cast<float>(static_cast<double>(now - _last_swap_counter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+    _last_swap_counter = now;
+#endif
+
+    if (_dynamic_resolution.update(frame_ms)) {
+        spdlog::debug("OpenGLRenderer::update_dynamic_resolution - Render scale {:.2f} ({:.2f} ms / {:.2f} ms)",
+                      _dynamic_resolution.get_scale(), _dynamic_resolution.get_average_ms(), _dynamic_resolution.get_target_ms());
+    }
+
+    _stats.frame_ms  = _dynamic_resolution.get_average_ms();
+    _stats.target_ms = _dynamic_resolution.get_target_ms();
+}
+
+void OpenGLRenderer::upscale_scene_target() {
+    const auto& spec         = _scene_fbo->get_specification();
+    const glm::vec2 fbo_size = glm::vec2(static_cast<float>(spec.width), static_cast<float>(spec.height));
+    const glm::vec2 rendered = glm::vec2(static_cast<float>(_stats.render_width), static_cast<float>(_stats.render_height));
+
+    _scene_fbo->unbind();
+    glViewport(0, 0, width, height);
+    glDisable(GL_DEPTH_TEST);
+
+    _upscale_shader->activate();
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _scene_fbo->get_color_attachment_id());
+    _upscale_shader->set_value("TEXTURE", 0);
+    _upscale_shader->set_value("UV_SCALE", rendered / fbo_size);
+    _upscale_shader->set_value("TEXEL_SIZE", 1.0f / fbo_size);
+    _upscale_shader->set_value("UV_MAX", (rendered - 0.5f) / fbo_size);
+    _upscale_shader->set_value("SHARPNESS", _stats.render_scale < 1.0f ? _upscale_sharpness : 0.0f);
+
+    glBindVertexArray(_upscale_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    glEnable(GL_DEPTH_TEST);
+}
+
 void OpenGLRenderer::begin_frame() {
-    for (auto& [key, batch] : _instanced_batches) {
-        batch.clear();
+    _frame_index++;
+    stream_textures();
+    update_render_size();
+
+#if !defined(SDL_PLATFORM_IOS) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+    if (_dynamic_resolution_enabled) {
+        glBeginQuery(GL_TIME_ELAPSED, _gpu_timer_queries[_gpu_timer_index]);
     }
+#endif
+
+    _stats.instance_uploads = 0;
+}
+
+void OpenGLRenderer::upload_render_proxies() {
+    for (auto& [key, batch] : _instanced_batches) {
+        if (!batch.is_dirty()) {
+            continue;
+        }
+
+        const size_t count = batch.model_matrices.size();
+
+        if (!batch.instance_buffer) {
+            batch.instance_buffer = allocate_gpu_buffer(GpuBufferType::VERTEX);
+        }
+
+        // Grow geometrically so entities spawned one by one don't reallocate every frame
+        if (count > batch.gpu_capacity) {
+            batch.gpu_capacity = std::max(count, batch.gpu_capacity * 2);
+            batch.instance_buffer->upload(nullptr, batch.gpu_capacity * sizeof(glm::mat4));
+            batch.dirty_begin = 0;
+            batch.dirty_end   = count;
+        }
 
-    for (auto& [mesh, batch] : shadow_batches) {
-        batch.clear();
+        const size_t end = std::min(batch.dirty_end, count);
+
+        if (end > batch.dirty_begin) {
+            batch.instance_buffer->update(batch.model_matrices.data() + batch.dirty_begin,
+                                          batch.dirty_begin * sizeof(glm::mat4),
+                                          (end - batch.dirty_begin) * sizeof(glm::mat4));
+            _stats.instance_uploads += static_cast<int>(end - batch.dirty_begin);
+        }
+
+        batch.clear_dirty();
     }
 }
 
 void OpenGLRenderer::begin_shadow_pass() {
+    upload_render_proxies();
+
     shadow_map_fbo->bind();
     glEnable(GL_DEPTH_TEST);
     glClear(GL_DEPTH_BUFFER_BIT);
@@ -561,23 +843,21 @@ void OpenGLRenderer::begin_shadow_pass() {
 void OpenGLRenderer::render_shadow_pass(const glm::mat4& light_space_matrix) {
     _shadow_shader->set_value("LIGHT_MATRIX", light_space_matrix, 1);
 
-    for (auto& [mesh_ptr, batch] : shadow_batches) {
-        if (batch.model_matrices.empty())
-            continue;
+    for (auto& [key, batch] : _instanced_batches) {
+        const MeshDrawData* mesh = _meshes.get(batch.mesh);
 
-        instance_buffer->bind();
-        instance_buffer->upload(batch.model_matrices.data(),
-                                batch.model_matrices.size() * sizeof(glm::mat4));
+        if (batch.model_matrices.empty() || !mesh)
+            continue;
 
-        setup_instance_matrix_attribute(batch.mesh->vertex_layout.get());
+        setup_instance_matrix_attribute(mesh->vertex_layout, batch.instance_buffer.get());
 
-        batch.mesh->vertex_layout->bind();
+        mesh->vertex_layout->bind();
         glDrawElementsInstanced(GL_TRIANGLES,
-                                batch.mesh->index_count,
+                                mesh->index_count,
                                 GL_UNSIGNED_INT,
                                 0,
                                 batch.model_matrices.size());
-        batch.mesh->vertex_layout->unbind();
+        mesh->vertex_layout->unbind();
     }
 }
 
@@ -588,10 +868,14 @@ void OpenGLRenderer::end_shadow_pass() {
 }
 
 void OpenGLRenderer::begin_render_target() {
+    if (_scene_fbo) {
+        _scene_fbo->bind();
+    }
+
     glClearColor(_world_environment->color.r, _world_environment->color.g, _world_environment->color.b, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     _default_shader->activate();
-    glViewport(0, 0, width, height);
+    glViewport(0, 0, _stats.render_width, _stats.render_height);
 }
 
 void OpenGLRenderer::render_main_target(const Camera3D& camera,
@@ -602,10 +886,13 @@ void OpenGLRenderer::render_main_target(const Camera3D& camera,
 
     int total_instances = 0;
     int draw_calls = 0;
+    int culled = 0;
 
     glm::mat4 view       = camera.get_view(camera_transform);
     glm::mat4 projection = camera.get_projection(width, height);
 
+    const Frustum frustum = Frustum::from_matrix(projection * view);
+
     _default_shader->set_value("VIEW", view);
     _default_shader->set_value("PROJECTION", projection);
     _default_shader->set_value("LIGHT_MATRIX", light_space_matrix);
@@ -621,35 +908,63 @@ void OpenGLRenderer::render_main_target(const Camera3D& camera,
     glBindTexture(GL_TEXTURE_CUBE_MAP, _world_environment->texture);
     _default_shader->set_value("ENVIRONMENT_MAP", ENVIRONMENT_TEXTURE_UNIT);
 
+    glActiveTexture(GL_TEXTURE0 + PREFILTER_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, _world_environment->prefiltered_texture);
+
+    glActiveTexture(GL_TEXTURE0 + BRDF_LUT_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, _world_environment->brdf_lut_texture);
+
+    // On-screen size of one world unit at distance 1, used for texture streaming feedback
+    const float pixels_per_unit = static_cast<float>(_stats.render_height) * 0.5f / glm::tan(glm::radians(camera.fov) * 0.5f);
+
     for (auto& [key, batch] : _instanced_batches) {
-        if (batch.model_matrices.empty())
+        // Meshes or materials released while still referenced are skipped, their handles no longer resolve
+        const MeshDrawData* mesh = _meshes.get(batch.mesh);
+        const Material* material = _materials.get(batch.material);
+
+        if (batch.model_matrices.empty() || !mesh || !material)
             continue;
 
+        // Static chunks (and unique meshes) are one instance, their bounds alone decide the whole draw
+        if (batch.model_matrices.size() == 1) {
+            const glm::vec4 sphere = get_world_bounding_sphere(*mesh, batch.model_matrices[0]);
+
+            if (!frustum.is_sphere_visible(glm::vec3(sphere), sphere.w)) {
+                culled++;
+                continue;
+            }
+        }
+
+        if (_texture_residency.is_enabled()) {
+            request_texture_feedback(batch, *mesh, *material, camera_transform.position, pixels_per_unit);
+        }
+
         draw_calls++;
         total_instances += batch.model_matrices.size();
 
-        instance_buffer->bind();
-        instance_buffer->upload(batch.model_matrices.data(),
-                                batch.model_matrices.size() * sizeof(glm::mat4));
-
-        batch.material->bind(_default_shader.get());
+        material->bind(_default_shader.get());
 
-        setup_instance_matrix_attribute(batch.mesh->vertex_layout.get());
+        setup_instance_matrix_attribute(mesh->vertex_layout, batch.instance_buffer.get());
 
-        batch.mesh->vertex_layout->bind();
+        mesh->vertex_layout->bind();
         glDrawElementsInstanced(GL_TRIANGLES,
-                                batch.mesh->index_count,
+                                mesh->index_count,
                                 GL_UNSIGNED_INT,
                                 0,
                                 batch.model_matrices.size());
-        batch.mesh->vertex_layout->unbind();
+        mesh->vertex_layout->unbind();
     }
 
     // spdlog::info("Frame: {} draw calls, {} instances", draw_calls, total_instances);
+    _stats.draw_calls     = draw_calls;
+    _stats.instances      = total_instances;
+    _stats.culled_batches = culled;
 }
 
 void OpenGLRenderer::end_render_target() {
-
+    if (_scene_fbo) {
+        upscale_scene_target();
+    }
 }
 
 void OpenGLRenderer::begin_environment_pass() {
@@ -658,10 +973,7 @@ void OpenGLRenderer::begin_environment_pass() {
 
 }
 
-void OpenGLRenderer::render_environment_pass(const Camera3D& camera) {
-    auto camera_query                   = GEngine->get_world().query<const Transform3D, const Camera3D>();
-    const Transform3D& camera_transform = camera_query.first().get<Transform3D>();
-
+void OpenGLRenderer::render_environment_pass(const Camera3D& camera, const Transform3D& camera_transform) {
     glm::mat4 view       = glm::mat4(glm::mat3(camera.get_view(camera_transform)));
     glm::mat4 projection = camera.get_projection(width, height);
 
@@ -683,42 +995,134 @@ void OpenGLRenderer::end_environment_pass() {
     glDepthFunc(GL_LESS);
 }
 
-void OpenGLRenderer::add_to_render_batch(const Transform3D& transform, const MeshRef& mesh_ref, const MaterialRef& mat_ref) {
-    MeshMaterialKey key{mesh_ref.mesh, mat_ref.material};
-    auto& batch = _instanced_batches[key];
+void OpenGLRenderer::update_render_proxy(Uint64 id, const Transform3D& transform, const MeshRef& mesh_ref, const MaterialRef& mat_ref) {
+    const MeshMaterialKey key{mesh_ref.mesh, mat_ref.material};
+
+    if (auto it = _render_proxies.find(id); it != _render_proxies.end()) {
+        if (it->second.key == key) {
+            auto& batch = _instanced_batches[key];
+            batch.model_matrices[it->second.slot] = transform.get_matrix();
+            batch.mark_dirty(it->second.slot);
+            return;
+        }
 
-    batch.mesh = mesh_ref.mesh;
+        remove_render_proxy(id);
+    }
+
+    auto& batch    = _instanced_batches[key];
+    batch.mesh     = mesh_ref.mesh;
     batch.material = mat_ref.material;
+
+    const size_t slot = batch.model_matrices.size();
     batch.model_matrices.push_back(transform.get_matrix());
+    batch.proxies.push_back(id);
+    batch.mark_dirty(slot);
+
+    _render_proxies[id] = {key, slot};
 }
 
-void OpenGLRenderer::add_to_shadow_batch(const Transform3D& transform, const MeshRef& mesh_ref) {
-    auto& batch = shadow_batches[mesh_ref.mesh];
-    batch.mesh = mesh_ref.mesh;
-    batch.model_matrices.push_back(transform.get_matrix());
+void OpenGLRenderer::remove_render_proxy(Uint64 id) {
+    const auto it = _render_proxies.find(id);
+    if (it == _render_proxies.end()) {
+        return;
+    }
+
+    const auto [key, slot] = it->second;
+    _render_proxies.erase(it);
+
+    auto batch_it = _instanced_batches.find(key);
+    auto& batch   = batch_it->second;
+
+    // Keep the slots packed, the last instance takes the freed slot
+    const size_t last = batch.model_matrices.size() - 1;
+    if (slot != last) {
+        batch.model_matrices[slot] = batch.model_matrices[last];
+        batch.proxies[slot]        = batch.proxies[last];
+        _render_proxies[batch.proxies[slot]].slot = slot;
+        batch.mark_dirty(slot);
+    }
+
+    batch.model_matrices.pop_back();
+    batch.proxies.pop_back();
+    batch.is_bounds_dirty = true;
+
+    if (batch.model_matrices.empty()) {
+        _instanced_batches.erase(batch_it);
+    }
+}
+
+void OpenGLRenderer::destroy_texture(Uint32 texture) {
+    _texture_residency.unregister_texture(texture);
+    glDeleteTextures(1, &texture);
 }
 
 void OpenGLRenderer::resize(int w, int h) {
     width  = w;
     height = h;
     glViewport(0, 0, width, height);
+
+    // Minimized windows report a 0x0 size, keep the previous target until restored
+    if (_scene_fbo && w > 0 && h > 0) {
+        _scene_fbo->resize(w, h);
+    }
 }
 
 void OpenGLRenderer::cleanup() {
+    _texture_residency.shutdown();
+
+    // Instance buffers are GL objects, released while the context is still alive
+    _instanced_batches.clear();
+    _render_proxies.clear();
+
     // Clean up textures
-    for (auto& [key, texID] : _textures)
-        glDeleteTextures(1, &texID);
+    _textures.for_each([](TextureHandle, Uint32& texture, const TextureInfo&) { glDeleteTextures(1, &texture); });
 
     _textures.clear();
+    _texture_names.clear();
+
+    // Mesh GPU buffers are owned by the pool
+    _meshes.clear();
+    _mesh_paths.clear();
+    _materials.clear();
+    _material_names.clear();
 
     // TODO: create world enviroment entity
     delete _world_environment;
     _world_environment = nullptr;
 
+    _scene_fbo      = nullptr;
+    _upscale_shader = nullptr;
+
+    if (_upscale_vao) {
+        glDeleteVertexArrays(1, &_upscale_vao);
+        _upscale_vao = 0;
+    }
+
+#if !defined(SDL_PLATFORM_IOS) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+    if (_dynamic_resolution_enabled) {
+        glDeleteQueries(GPU_TIMER_QUERIES, _gpu_timer_queries.data());
+    }
+#endif
+
     SDL_GL_DestroyContext(_context);
 
 }
 
+bool OpenGLRenderer::acquire_context() {
+    return SDL_GL_MakeCurrent(_window, _context);
+}
+
+void OpenGLRenderer::release_context() {
+    SDL_GL_MakeCurrent(_window, nullptr);
+}
+
 void OpenGLRenderer::swap_chain() {
+#if !defined(SDL_PLATFORM_IOS) && !defined(SDL_PLATFORM_ANDROID) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+    if (_dynamic_resolution_enabled) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+#endif
+
     SDL_GL_SwapWindow(_window);
+    update_dynamic_resolution();
 }
@@ -69,6 +69,8 @@ OpenglShader::OpenglShader(const std::string& vertex, const std::string& fragmen
     glUniform1i(glGetUniformLocation(program, "EMISSIVE_MAP"), EMISSIVE_TEXTURE_UNIT);
     glUniform1i(glGetUniformLocation(program, "SHADOW_MAP"), SHADOW_TEXTURE_UNIT);
     glUniform1i(glGetUniformLocation(program, "ENVIRONMENT_MAP"), ENVIRONMENT_TEXTURE_UNIT);
+    glUniform1i(glGetUniformLocation(program, "PREFILTER_MAP"), PREFILTER_TEXTURE_UNIT);
+    glUniform1i(glGetUniformLocation(program, "BRDF_LUT"), BRDF_LUT_TEXTURE_UNIT);
 
     const bool success = validate_gl_shader(program, GL_LINK_STATUS, true);
 
@@ -242,6 +244,11 @@ void OpenglGpuBuffer::upload(const void* data, size_t size) {
     _buffer_size = size;
 }
 
+void OpenglGpuBuffer::update(const void* data, size_t offset, size_t size) {
+    bind();
+    glBufferSubData(_target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
 size_t OpenglGpuBuffer::size() const {
     return _buffer_size;
 }
@@ -373,6 +380,11 @@ void OpenGLFramebuffer::cleanup() {
 
     if (fbo)
         glDeleteFramebuffers(1, &fbo);
+
+    // invalidate() re-populates the attachments on resize
+    depth_attachment = 0;
+    color_attachments.clear();
+    fbo = 0;
 }
 
 OpenglShader::~OpenglShader() {
@@ -0,0 +1,143 @@
+#include "core/renderer/render_thread.h"
+
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+bool RenderThread::start(Renderer* renderer, FrameRender render_frame) {
+    if (_running || !renderer) {
+        return false;
+    }
+
+    _renderer     = renderer;
+    _render_frame = std::move(render_frame);
+
+    // A context can only be current on one thread at a time
+    _renderer->release_context();
+
+    // Commands only run after the loop took the mutex, so they see the id written here
+    std::lock_guard lock(_mutex);
+    _running   = true;
+    _thread    = std::thread(&RenderThread::thread_loop, this);
+    _thread_id = _thread.get_id();
+
+    spdlog::info("RenderThread::start - Rendering on a dedicated thread");
+    return true;
+}
+
+void RenderThread::stop() {
+    {
+        std::lock_guard lock(_mutex);
+        if (!_running) {
+            return;
+        }
+        _running = false;
+    }
+
+    _cv.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    _renderer->acquire_context();
+}
+
+bool RenderThread::is_running() const {
+    std::lock_guard lock(_mutex);
+    return _running;
+}
+
+bool RenderThread::is_render_thread() const {
+    return std::this_thread::get_id() == _thread_id;
+}
+
+void RenderThread::submit(RenderSnapshot& snapshot) {
+    {
+        std::unique_lock lock(_mutex);
+        _cv.wait(lock, [this] { return !_has_pending || !_running; });
+
+        if (!_running) {
+            return;
+        }
+
+        std::swap(_pending, snapshot);
+        _has_pending = true;
+    }
+
+    _cv.notify_all();
+}
+
+void RenderThread::execute(const Command& command) {
+    if (is_render_thread() || !is_running()) {
+        command();
+        return;
+    }
+
+    std::promise<void> done;
+    auto future = done.get_future();
+
+    {
+        std::lock_guard lock(_mutex);
+        _commands.emplace_back([&] {
+            command();
+            done.set_value();
+        });
+    }
+
+    _cv.notify_all();
+    future.wait();
+}
+
+RenderStats RenderThread::get_stats() const {
+    std::lock_guard lock(_mutex);
+    return _stats;
+}
+
+void RenderThread::thread_loop() {
+    if (!_renderer->acquire_context()) {
+        spdlog::critical("RenderThread::thread_loop - Failed to make the context current: {}", SDL_GetError());
+    }
+
+    std::deque<Command> commands;
+
+    while (true) {
+        bool has_frame = false;
+
+        {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [this] { return !_running || _has_pending || !_commands.empty(); });
+
+            if (!_running && _commands.empty()) {
+                break;
+            }
+
+            commands.swap(_commands);
+
+            if (_has_pending && _running) {
+                std::swap(_current, _pending);
+                _has_pending = false;
+                has_frame    = true;
+            }
+        }
+
+        // The simulation thread may be waiting for the pending slot
+        _cv.notify_all();
+
+        // Resource creation first, the frame may reference it
+        for (auto& command : commands) {
+            command();
+        }
+        commands.clear();
+
+        if (has_frame) {
+            _render_frame(_current);
+
+            std::lock_guard lock(_mutex);
+            _stats = _renderer->get_stats();
+        }
+    }
+
+    _renderer->release_context();
+}
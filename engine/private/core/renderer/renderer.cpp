@@ -0,0 +1,134 @@
+#include "core/renderer/renderer.h"
+#include "core/engine.h"
+#include "core/utility/texture_cache.h"
+
+MeshHandle Renderer::add_mesh(MeshInstance3D mesh) {
+    if (!mesh.vertex_layout) {
+        spdlog::error("Renderer::add_mesh - '{}' has no GPU data", mesh.name);
+        return {};
+    }
+
+    const MeshDrawData draw{mesh.vertex_layout.get(), mesh.index_count, mesh.bounds_center, mesh.bounds_radius};
+
+    MeshHandle handle;
+    GEngine->run_on_render_thread([&] { handle = _meshes.create(draw, std::move(mesh)); });
+    return handle;
+}
+
+void Renderer::remove_mesh(MeshHandle handle) {
+    // Releases the GPU buffers owned by the cold data
+    GEngine->run_on_render_thread([&] { _meshes.destroy(handle); });
+
+    // A model is loaded as a whole, losing one of its meshes makes the next load import it again
+    std::erase_if(_mesh_paths, [handle](const auto& item) { return std::ranges::find(item.second, handle) != item.second.end(); });
+}
+
+MaterialHandle Renderer::add_material(const std::string& name, const Material& material) {
+    MaterialHandle handle;
+    GEngine->run_on_render_thread([&] { handle = _materials.create(material, name); });
+
+    _material_names[name].push_back(handle);
+    return handle;
+}
+
+void Renderer::remove_material(MaterialHandle handle) {
+    const std::string* name = _materials.get_cold(handle);
+
+    if (!name) {
+        return;
+    }
+
+    if (auto it = _material_names.find(*name); it != _material_names.end()) {
+        std::erase(it->second, handle);
+
+        if (it->second.empty()) {
+            _material_names.erase(it);
+        }
+    }
+
+    GEngine->run_on_render_thread([&] { _materials.destroy(handle); });
+}
+
+TextureImage Renderer::decode_texture_file(const std::string& path) {
+    TextureImage image;
+    image.name        = path;
+    image.source_type = TextureSourceType::FILE;
+
+    // Cooked by golias_cook: already decoded, the texels are used in place
+    if (const std::string cooked_path = TextureCache::get_cooked_path(path); FileAccess::file_exists(cooked_path)) {
+        auto cooked = std::make_shared<MappedFile>(cooked_path);
+        CookedImage cooked_image;
+
+        if (cooked->is_open() && TextureCache::read(cooked->bytes(), cooked_image)) {
+            image.width    = static_cast<int>(cooked_image.width);
+            image.height   = static_cast<int>(cooked_image.height);
+            image.channels = static_cast<int>(cooked_image.channels);
+            image.pixels   = std::shared_ptr<const unsigned char>(cooked, cooked_image.pixels.data());
+            return image;
+        }
+
+        spdlog::warn("Renderer::decode_texture_file - Ignoring stale cooked texture {}", cooked_path);
+    }
+
+    // Mapped rather than stbi_load so res:// textures can come from a mounted pack
+    const MappedFile file(path);
+
+    if (!file.is_open()) {
+        return image;
+    }
+
+    if (unsigned char* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.data()), static_cast<int>(file.size()), &image.width,
+                                                      &image.height, &image.channels, 0)) {
+        image.pixels.reset(pixels, stbi_image_free);
+    }
+
+    return image;
+}
+
+TextureImage Renderer::decode_texture_memory(const unsigned char* buffer, size_t size, const std::string& name) {
+    TextureImage image;
+    image.name        = name;
+    image.source_type = TextureSourceType::MEMORY;
+    image.encoded     = {buffer, size};
+
+    if (unsigned char* pixels = stbi_load_from_memory(buffer, static_cast<int>(size), &image.width, &image.height, &image.channels, 0)) {
+        image.pixels.reset(pixels, stbi_image_free);
+    }
+
+    return image;
+}
+
+TextureImage Renderer::wrap_texture_raw(const unsigned char* data, int width, int height, int channels, const std::string& name) {
+    TextureImage image;
+    image.name        = name;
+    image.source_type = TextureSourceType::RAW;
+    image.pixels      = std::shared_ptr<const unsigned char>(data, [](const unsigned char*) {});
+    image.width       = width;
+    image.height      = height;
+    image.channels    = channels;
+
+    return image;
+}
+
+TextureHandle Renderer::add_texture(const std::string& name, Uint32 texture, size_t gpu_bytes) {
+    TextureHandle handle;
+    GEngine->run_on_render_thread([&] { handle = _textures.create(texture, {name, gpu_bytes}); });
+
+    _texture_names[name] = handle;
+    return handle;
+}
+
+void Renderer::remove_texture(TextureHandle handle) {
+    const TextureInfo* info = _textures.get_cold(handle);
+
+    if (!info) {
+        return;
+    }
+
+    _texture_names.erase(info->name);
+
+    GEngine->run_on_render_thread([&] {
+        destroy_texture(*_textures.get(handle));
+        _textures.destroy(handle);
+    });
+}
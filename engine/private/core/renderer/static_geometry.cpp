@@ -0,0 +1,203 @@
+#include "core/renderer/static_geometry.h"
+#include "core/engine.h"
+
+namespace {
+
+/// Static entities of one chunk, gathered on the main thread then merged on the job system
+struct ChunkBake {
+    Uint64 proxy_id = 0;
+    MaterialHandle material;
+    std::vector<std::pair<glm::mat4, const MeshGeometry*>> parts;
+    MeshGeometry merged;
+};
+
+void merge_chunk(ChunkBake& bake) {
+    size_t vertex_count = 0;
+    size_t index_count  = 0;
+    for (const auto& [model, geometry] : bake.parts) {
+        vertex_count += geometry->vertices.size();
+        index_count += geometry->indices.size();
+    }
+
+    bake.merged.vertices.reserve(vertex_count);
+    bake.merged.indices.reserve(index_count);
+
+    for (const auto& [model, geometry] : bake.parts) {
+        const glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(model)));
+        const auto base               = static_cast<unsigned int>(bake.merged.vertices.size());
+
+        for (const auto& vertex : geometry->vertices) {
+            const glm::vec3 normal = normal_matrix * vertex.normal;
+
+            bake.merged.vertices.push_back({
+                glm::vec3(model * glm::vec4(vertex.position, 1.0f)),
+                glm::dot(normal, normal) > 0.0f ? glm::normalize(normal) : normal,
+                vertex.uv
+            });
+        }
+
+        for (const unsigned int index : geometry->indices) {
+            bake.merged.indices.push_back(base + index);
+        }
+    }
+}
+
+} // namespace
+
+void StaticGeometry::setup(flecs::world& world) {
+    // Only records the entity, the chunk it leaves/joins is resolved by `bake` once the changes settled
+    world.observer<const Transform3D, const MeshRef, const MaterialRef>("TrackStaticGeometry")
+         .with<Static>()
+         .event(flecs::OnAdd)
+         .event(flecs::OnSet)
+         .event(flecs::OnRemove)
+         .each([this](flecs::entity entity, const Transform3D&, const MeshRef&, const MaterialRef&) {
+             _pending.insert(entity.id());
+         });
+}
+
+bool StaticGeometry::has_pending() const {
+    return !_pending.empty();
+}
+
+void StaticGeometry::bake(const flecs::world& world) {
+    if (_pending.empty()) {
+        return;
+    }
+
+    const auto renderer = GEngine->get_renderer();
+
+    for (const Uint64 id : _pending) {
+        if (const auto it = _entity_chunks.find(id); it != _entity_chunks.end()) {
+            auto& chunk = _chunks[it->second];
+            std::erase(chunk.entities, id);
+            chunk.is_dirty = true;
+            _entity_chunks.erase(it);
+        }
+
+        if (!world.is_alive(id)) {
+            continue;
+        }
+
+        const flecs::entity entity(world, id);
+        const auto* transform = entity.try_get<Transform3D>();
+        const auto* mesh      = entity.try_get<MeshRef>();
+        const auto* material  = entity.try_get<MaterialRef>();
+
+        if (!entity.has<Static>() || !transform || !mesh || !material) {
+            continue;
+        }
+
+        const MeshInstance3D* source = renderer->_meshes.get_cold(mesh->mesh);
+
+        if (!source || !source->geometry) {
+            spdlog::warn("StaticGeometry::bake - '{}' has no CPU geometry, it can't be merged and won't be drawn", entity.name().c_str());
+            continue;
+        }
+
+        const ChunkKey key = get_chunk_key(*transform, *material);
+        auto& chunk        = _chunks[key];
+
+        if (chunk.proxy_id == 0) {
+            chunk.proxy_id = PROXY_ID_BIT | ++_next_proxy_id;
+        }
+
+        chunk.entities.push_back(id);
+        chunk.is_dirty     = true;
+        _entity_chunks[id] = key;
+    }
+
+    _pending.clear();
+
+    std::vector<ChunkBake> bakes;
+    std::vector<Chunk*> chunks;
+
+    for (auto& [key, chunk] : _chunks) {
+        if (!chunk.is_dirty) {
+            continue;
+        }
+
+        ChunkBake bake{chunk.proxy_id, key.material};
+        bake.parts.reserve(chunk.entities.size());
+
+        for (const Uint64 id : chunk.entities) {
+            const flecs::entity entity(world, id);
+
+            // The mesh may have been released since the entity joined the chunk
+            if (const MeshInstance3D* source = renderer->_meshes.get_cold(entity.get<MeshRef>().mesh)) {
+                bake.parts.emplace_back(entity.get<Transform3D>().get_matrix(), source->geometry.get());
+            }
+        }
+
+        bakes.push_back(std::move(bake));
+        chunks.push_back(&chunk);
+        chunk.is_dirty = false;
+    }
+
+    GEngine->get_job_system().parallel_for_each(static_cast<int>(bakes.size()), [&bakes](int i) { merge_chunk(bakes[i]); });
+
+    // Swapped between two frames, the render thread never draws a chunk mesh while it is replaced
+    GEngine->run_on_render_thread([&] {
+        for (size_t i = 0; i < bakes.size(); ++i) {
+            auto& bake  = bakes[i];
+            auto& chunk = *chunks[i];
+
+            const MeshHandle previous = chunk.mesh;
+            chunk.mesh                = {};
+
+            if (bake.merged.indices.empty()) {
+                renderer->remove_render_proxy(bake.proxy_id);
+                renderer->remove_mesh(previous);
+                continue;
+            }
+
+            MeshInstance3D mesh;
+            mesh.name     = fmt::format("static_chunk_{}", bake.proxy_id & ~PROXY_ID_BIT);
+            mesh.geometry = std::make_shared<const MeshGeometry>(std::move(bake.merged));
+            ObjectLoader::upload_geometry(mesh);
+            mesh.geometry = nullptr; // Rebuilt from the entities on the next bake, no need to keep the merged copy
+
+            chunk.mesh = renderer->add_mesh(std::move(mesh));
+            renderer->update_render_proxy(bake.proxy_id, Transform3D{}, MeshRef{chunk.mesh}, MaterialRef{bake.material});
+            renderer->remove_mesh(previous);
+        }
+    });
+
+    std::erase_if(_chunks, [](const auto& item) { return item.second.entities.empty(); });
+
+    spdlog::info("StaticGeometry::bake - {} chunks rebuilt, {} static chunks", bakes.size(), _chunks.size());
+}
+
+void StaticGeometry::rebuild(const flecs::world& world) {
+    for (const auto& [id, key] : _entity_chunks) {
+        _pending.insert(id);
+    }
+
+    world.query_builder<const Transform3D, const MeshRef, const MaterialRef>()
+         .with<Static>()
+         .build()
+         .each([this](flecs::entity entity, const Transform3D&, const MeshRef&, const MaterialRef&) {
+             _pending.insert(entity.id());
+         });
+
+    bake(world);
+}
+
+void StaticGeometry::clear(Renderer& renderer) {
+    for (auto& [key, chunk] : _chunks) {
+        renderer.remove_render_proxy(chunk.proxy_id);
+        renderer._meshes.destroy(chunk.mesh);
+    }
+
+    _chunks.clear();
+    _entity_chunks.clear();
+    _pending.clear();
+}
+
+size_t StaticGeometry::get_chunk_count() const {
+    return _chunks.size();
+}
+
+StaticGeometry::ChunkKey StaticGeometry::get_chunk_key(const Transform3D& transform, const MaterialRef& material) {
+    return {glm::ivec3(glm::floor(transform.position / CHUNK_SIZE)), material.material};
+}
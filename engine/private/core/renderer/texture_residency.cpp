@@ -0,0 +1,447 @@
+#include "core/renderer/texture_residency.h"
+#include "core/io/mapped_file.h"
+#include "core/io/file_system.h"
+#include "core/utility/texture_cache.h"
+
+
+size_t TextureMipChain::size_bytes() const {
+    size_t total = 0;
+    for (const auto& level : levels) {
+        total += level.pixels.size();
+    }
+    return total;
+}
+
+TextureResidency::~TextureResidency() {
+    shutdown();
+}
+
+void TextureResidency::start(size_t budget_bytes) {
+    _budget = budget_bytes;
+
+    if (_budget == 0 || _running) {
+        return;
+    }
+
+    _running = true;
+    _worker  = std::thread(&TextureResidency::worker_loop, this);
+
+    spdlog::info("TextureResidency::start - Streaming enabled, budget {} MB", _budget / (1024 * 1024));
+}
+
+void TextureResidency::shutdown() {
+    {
+        std::lock_guard lock(_mutex);
+        if (!_running) {
+            return;
+        }
+        _running = false;
+
+        for (const auto& job : _jobs) {
+            if (job.read) {
+                job.read->cancel();
+            }
+        }
+        _jobs.clear();
+    }
+
+    _cv.notify_all();
+
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+
+    _ready.clear();
+    _entries.clear();
+    _resident_bytes = 0;
+    _in_flight      = 0;
+}
+
+bool TextureResidency::is_enabled() const {
+    return _budget > 0;
+}
+
+void TextureResidency::register_texture(TextureResidencyEntry entry) {
+    entry.mip_count       = compute_mip_count(entry.width, entry.height);
+    entry.min_mip         = compute_min_mip(entry.width, entry.height);
+    entry.target_mip      = entry.resident_mip;
+    entry.requested_mip   = entry.min_mip;
+    entry.resident_bytes  = compute_bytes(entry.width, entry.height, entry.channels, entry.resident_mip, entry.mip_count);
+    entry.in_flight       = false;
+    entry.serial          = ++_next_serial;
+
+    _resident_bytes += entry.resident_bytes;
+    _entries[entry.id] = std::move(entry);
+}
+
+void TextureResidency::unregister_texture(Uint32 id) {
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    _resident_bytes -= it->second.resident_bytes;
+    if (it->second.in_flight) {
+        _in_flight--;
+    }
+
+    _entries.erase(it);
+}
+
+const TextureResidencyEntry* TextureResidency::find(Uint32 id) const {
+    auto it = _entries.find(id);
+    return it != _entries.end() ? &it->second : nullptr;
+}
+
+void TextureResidency::request_screen_size(Uint32 id, float pixels, Uint64 frame) {
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    auto& entry = it->second;
+
+    const float texels = static_cast<float>(std::max(entry.width, entry.height));
+    int mip            = 0;
+
+    if (pixels > 0.0f && texels > pixels) {
+        mip = static_cast<int>(std::floor(std::log2(texels / pixels)));
+    }
+
+    mip = std::clamp(mip, 0, entry.min_mip);
+
+    if (entry.requested_frame != frame) {
+        entry.requested_frame = frame;
+        entry.requested_mip   = mip;
+    } else {
+        entry.requested_mip = std::min(entry.requested_mip, mip);
+    }
+
+    entry.last_used_frame = frame;
+}
+
+void TextureResidency::update(Uint64 frame) {
+    if (!is_enabled() || _entries.empty()) {
+        return;
+    }
+
+    _downgrades.clear();
+
+    size_t target_bytes = 0;
+    std::vector<TextureResidencyEntry*> lru;
+    lru.reserve(_entries.size());
+
+    for (auto& [id, entry] : _entries) {
+        if (frame - entry.requested_frame <= 1) {
+            entry.target_mip = entry.requested_mip;
+        } else if (frame - entry.last_used_frame > FEEDBACK_WINDOW) {
+            entry.target_mip = entry.min_mip;
+        } else {
+            // Recently visible but not this frame, keep what is resident (hysteresis)
+            entry.target_mip = std::max(entry.resident_mip, entry.requested_mip);
+        }
+
+        target_bytes += compute_bytes(entry.width, entry.height, entry.channels, entry.target_mip, entry.mip_count);
+        lru.push_back(&entry);
+    }
+
+    // Over budget: drop top mips of the least recently used textures first
+    if (target_bytes > _budget) {
+        std::sort(lru.begin(), lru.end(), [](const TextureResidencyEntry* a, const TextureResidencyEntry* b) {
+            return a->last_used_frame < b->last_used_frame;
+        });
+
+        for (auto* entry : lru) {
+            while (target_bytes > _budget && entry->target_mip < entry->min_mip) {
+                const size_t current = compute_bytes(entry->width, entry->height, entry->channels, entry->target_mip, entry->mip_count);
+                entry->target_mip++;
+                const size_t lower = compute_bytes(entry->width, entry->height, entry->channels, entry->target_mip, entry->mip_count);
+                target_bytes -= current - lower;
+            }
+
+            if (target_bytes <= _budget) {
+                break;
+            }
+        }
+    }
+
+    // Schedule decodes, most recently used first so visible textures sharpen before the rest
+    std::sort(lru.begin(), lru.end(), [](const TextureResidencyEntry* a, const TextureResidencyEntry* b) {
+        return a->last_used_frame > b->last_used_frame;
+    });
+
+    std::lock_guard lock(_mutex);
+
+    for (auto* entry : lru) {
+        if (entry->in_flight || entry->target_mip == entry->resident_mip) {
+            continue;
+        }
+
+        // Lower levels are already resident, dropping mips costs no read or decode
+        if (entry->target_mip > entry->resident_mip) {
+            _downgrades.push_back({entry->id, entry->target_mip});
+            continue;
+        }
+
+        if (entry->failed || _in_flight >= MAX_IN_FLIGHT) {
+            continue;
+        }
+
+        Job job;
+        job.id          = entry->id;
+        job.serial      = entry->serial;
+        job.name        = entry->name;
+        job.source_type = entry->source_type;
+        job.source      = entry->source;
+        job.width       = entry->width;
+        job.height      = entry->height;
+        job.channels    = entry->channels;
+        job.base_mip    = entry->target_mip;
+
+        if (job.source_type == TextureSourceType::FILE) {
+            const std::string cooked_path = TextureCache::get_cooked_path(job.name);
+
+            job.is_cooked = FileAccess::file_exists(cooked_path);
+            job.read      = FileAccess::read_file_async(job.is_cooked ? cooked_path : job.name, IoPriority::LOW);
+        }
+
+        entry->in_flight = true;
+        _in_flight++;
+        _jobs.push_back(std::move(job));
+    }
+
+    _cv.notify_one();
+}
+
+std::vector<TextureDowngrade> TextureResidency::pop_downgrades() {
+    return std::exchange(_downgrades, {});
+}
+
+std::vector<TextureMipChain> TextureResidency::pop_ready(size_t max_bytes) {
+    std::vector<TextureMipChain> chains;
+    size_t total = 0;
+
+    std::lock_guard lock(_mutex);
+
+    while (!_ready.empty()) {
+        const size_t bytes = _ready.front().size_bytes();
+        if (!chains.empty() && total + bytes > max_bytes) {
+            break;
+        }
+
+        TextureMipChain chain = std::move(_ready.front());
+        _ready.pop_front();
+
+        // Released while decoding (`unregister_texture` already took it out of flight), maybe under a reused name
+        auto it = _entries.find(chain.id);
+        if (it == _entries.end() || it->second.serial != chain.serial) {
+            continue;
+        }
+
+        it->second.in_flight = false;
+        _in_flight--;
+
+        if (chain.base_mip < 0) {
+            it->second.failed = true;
+            continue;
+        }
+
+        total += bytes;
+        chains.push_back(std::move(chain));
+    }
+
+    return chains;
+}
+
+void TextureResidency::mark_resident(Uint32 id, int base_mip, size_t bytes) {
+    auto it = _entries.find(id);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    _resident_bytes -= it->second.resident_bytes;
+    it->second.resident_mip   = base_mip;
+    it->second.resident_bytes = bytes;
+    _resident_bytes += bytes;
+}
+
+size_t TextureResidency::get_resident_bytes() const {
+    return _resident_bytes;
+}
+
+size_t TextureResidency::get_budget() const {
+    return _budget;
+}
+
+size_t TextureResidency::get_texture_count() const {
+    return _entries.size();
+}
+
+int TextureResidency::compute_mip_count(int width, int height) {
+    int count = 1;
+    int size  = std::max(width, height);
+    while (size > 1) {
+        size >>= 1;
+        count++;
+    }
+    return count;
+}
+
+int TextureResidency::compute_min_mip(int width, int height) {
+    int mip  = 0;
+    int size = std::max(width, height);
+    while (size > MIN_RESIDENT_SIZE) {
+        size >>= 1;
+        mip++;
+    }
+    return mip;
+}
+
+size_t TextureResidency::compute_bytes(int width, int height, int channels, int base_mip, int mip_count) {
+    size_t total = 0;
+    for (int mip = base_mip; mip < mip_count; ++mip) {
+        const size_t w = std::max(1, width >> mip);
+        const size_t h = std::max(1, height >> mip);
+        total += w * h * channels;
+    }
+    return total;
+}
+
+std::vector<TextureMipLevel> TextureResidency::build_mip_chain(const unsigned char* pixels, int width, int height, int channels, int base_mip) {
+    std::vector<TextureMipLevel> levels;
+
+    TextureMipLevel current;
+    current.width  = width;
+    current.height = height;
+    current.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+
+    int mip = 0;
+
+    while (true) {
+        if (mip >= base_mip) {
+            levels.push_back(current);
+        }
+
+        if (current.width == 1 && current.height == 1) {
+            break;
+        }
+
+        TextureMipLevel next;
+        next.width  = std::max(1, current.width / 2);
+        next.height = std::max(1, current.height / 2);
+        next.pixels.resize(static_cast<size_t>(next.width) * next.height * channels);
+
+        // 2x2 box filter, clamped on odd/1-texel edges
+        for (int y = 0; y < next.height; ++y) {
+            const int y0 = std::min(y * 2, current.height - 1);
+            const int y1 = std::min(y * 2 + 1, current.height - 1);
+
+            for (int x = 0; x < next.width; ++x) {
+                const int x0 = std::min(x * 2, current.width - 1);
+                const int x1 = std::min(x * 2 + 1, current.width - 1);
+
+                for (int c = 0; c < channels; ++c) {
+                    const int sum = current.pixels[(y0 * current.width + x0) * channels + c]
+                                    + current.pixels[(y0 * current.width + x1) * channels + c]
+                                    + current.pixels[(y1 * current.width + x0) * channels + c]
+                                    + current.pixels[(y1 * current.width + x1) * channels + c];
+
+                    next.pixels[(y * next.width + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+
+        current = std::move(next);
+        mip++;
+    }
+
+    return levels;
+}
+
+bool TextureResidency::decode_job(const Job& job, TextureMipChain& out) {
+    out.id       = job.id;
+    out.serial   = job.serial;
+    out.base_mip = job.base_mip;
+    out.channels = job.channels;
+
+    if (job.source_type == TextureSourceType::RAW) {
+        if (!job.source) {
+            return false;
+        }
+
+        out.levels = build_mip_chain(job.source->data(), job.width, job.height, job.channels, job.base_mip);
+        return true;
+    }
+
+    int w = 0, h = 0, channels = 0;
+    unsigned char* data = nullptr;
+
+    if (job.source_type == TextureSourceType::FILE) {
+        const bool is_read = job.read && job.read->wait() == AsyncReadStatus::DONE;
+        const auto bytes   = is_read ? job.read->bytes() : std::span<const std::byte>{};
+
+        if (job.is_cooked) {
+            // Cooked textures skip decoding, the mips are built from the texels
+            CookedImage image;
+
+            if (TextureCache::read(bytes, image) && static_cast<int>(image.channels) == job.channels && static_cast<int>(image.width) == job.width
+                && static_cast<int>(image.height) == job.height) {
+                out.levels = build_mip_chain(image.pixels.data(), job.width, job.height, job.channels, job.base_mip);
+                return true;
+            }
+
+            // Stale, decode the source instead
+            if (const MappedFile file(job.name); file.is_open()) {
+                data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.data()), static_cast<int>(file.size()), &w, &h, &channels, job.channels);
+            }
+        } else if (!bytes.empty()) {
+            data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(bytes.data()), static_cast<int>(bytes.size()), &w, &h, &channels, job.channels);
+        }
+    } else if (job.source) {
+        data = stbi_load_from_memory(job.source->data(), static_cast<int>(job.source->size()), &w, &h, &channels, job.channels);
+    }
+
+    if (!data) {
+        spdlog::error("TextureResidency::decode_job - Failed to decode texture: {}", job.name);
+        return false;
+    }
+
+    if (w != job.width || h != job.height) {
+        spdlog::error("TextureResidency::decode_job - Texture {} changed size ({}x{} -> {}x{})", job.name, job.width, job.height, w, h);
+        stbi_image_free(data);
+        return false;
+    }
+
+    out.levels = build_mip_chain(data, w, h, job.channels, job.base_mip);
+    stbi_image_free(data);
+
+    return true;
+}
+
+void TextureResidency::worker_loop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [this] { return !_running || !_jobs.empty(); });
+
+            if (!_running) {
+                return;
+            }
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        TextureMipChain chain;
+        if (!decode_job(job, chain)) {
+            // Keep the request alive so the texture stays at its current residency
+            chain.id       = job.id;
+            chain.serial   = job.serial;
+            chain.base_mip = -1;
+        }
+
+        std::lock_guard lock(_mutex);
+        _ready.push_back(std::move(chain));
+    }
+}
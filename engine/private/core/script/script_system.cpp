@@ -0,0 +1,459 @@
+#include "core/script/script_system.h"
+#include "core/io/file_system.h"
+
+namespace {
+
+/// Parallel batches are split in chunks of at least this many entities, a Lua call is too cheap to schedule alone
+constexpr int PARALLEL_MIN_CHUNK = 64;
+
+/// Work of one incremental step in KiB, small enough to check the budget often
+constexpr int GC_STEP_KB = 16;
+
+bool is_bytecode(const std::string& chunk) {
+    return chunk.compare(0, sizeof(LUA_SIGNATURE) - 1, LUA_SIGNATURE) == 0;
+}
+
+size_t get_heap_bytes(lua_State* L) {
+    return static_cast<size_t>(lua_gc(L, LUA_GCCOUNT)) * 1024 + static_cast<size_t>(lua_gc(L, LUA_GCCOUNTB));
+}
+
+} // namespace
+
+ScriptSystem::ScriptSystem() {
+    _vms.push_back(create_vm());
+}
+
+void ScriptSystem::setup(flecs::world& world, JobSystem* job_system) {
+    _job_system = job_system;
+
+    // Read-only term, iterating doesn't mark tables changed: `col:set` marks its table itself.
+    // Static entities are merged into chunks that never see later writes, views don't reach them
+    _transform_query = world.query_builder<const Transform3D>().without<Static>().cached().build();
+
+    for (auto& vm : _vms) {
+        vm->context.transform_query = _transform_query.c_ptr();
+    }
+
+    // Transform3D is written in place by scripts, the inout term marks the scripted tables changed
+    world.system<Script, Transform3D*>("RunScripts")
+         .kind(flecs::OnUpdate)
+         .run([this](flecs::iter& it) { dispatch(it); });
+}
+
+int ScriptSystem::load(const std::string& path) {
+    if (const auto it = _prototype_index.find(path); it != _prototype_index.end()) {
+        return it->second;
+    }
+
+    _prototype_index[path] = -1;
+
+    const auto read_chunk = [](const std::string& chunk_path) {
+        if (!FileAccess::file_exists(chunk_path)) {
+            return std::string();
+        }
+
+        FileAccess file(chunk_path);
+        const std::vector<char> bytes = file.is_open() ? file.get_file_as_bytes() : std::vector<char>{};
+        return std::string(bytes.data(), bytes.size());
+    };
+
+    Prototype prototype;
+    prototype.chunk      = read_chunk(get_cooked_path(path));
+    prototype.stats.path = path;
+
+    const bool is_cooked = !prototype.chunk.empty();
+    if (!is_cooked) {
+        prototype.chunk = read_chunk(path);
+    }
+
+    if (prototype.chunk.empty()) {
+        spdlog::error("ScriptSystem - Failed to read {}", path);
+        return -1;
+    }
+
+    const int index = static_cast<int>(_prototypes.size());
+    _prototypes.push_back(std::move(prototype));
+
+    Vm& vm = *_vms.front();
+    bool is_loaded = load_into(vm, index);
+
+    // Cooked for another Lua ABI (or damaged), the source ships along
+    if (!is_loaded && is_cooked) {
+        spdlog::warn("ScriptSystem - Cooked {} rejected, loading the source", get_cooked_path(path));
+
+        _prototypes[index].chunk = read_chunk(path);
+        is_loaded                = !_prototypes[index].chunk.empty() && load_into(vm, index);
+    }
+
+    if (!is_loaded) {
+        _prototypes.pop_back();
+        vm.handles.resize(_prototypes.size());
+        return -1;
+    }
+
+    // Declared by the script itself, the entity has no say in what the code touches
+    const auto parallel = vm.handles[index].environment.raw_get<sol::object>("parallel");
+    _prototypes[index].stats.is_parallel = parallel.get_type() == sol::type::boolean && parallel.as<bool>();
+
+    _prototype_index[path] = index;
+    return index;
+}
+
+std::string ScriptSystem::get_cooked_path(const std::string& source_path) {
+    return source_path + "c";
+}
+
+void ScriptSystem::dispatch(flecs::iter& it) {
+    for (auto& prototype : _prototypes) {
+        prototype.batch.clear();
+    }
+
+    while (it.next()) {
+        auto scripts = it.field<Script>(0);
+
+        for (auto i : it) {
+            Script& script = scripts[i];
+
+            if (script.is_failed) {
+                continue;
+            }
+
+            if (script.prototype < 0) {
+                script.prototype = load(script.path);
+
+                if (script.prototype < 0) {
+                    script.is_failed = true;
+                    continue;
+                }
+            }
+
+            _prototypes[script.prototype].batch.push_back({it.entity(i).id(), &script});
+        }
+    }
+
+    // The stage of this system, deletes are deferred like any other write of a system
+    flecs::world_t* world = it.world().c_ptr();
+
+    for (auto& vm : _vms) {
+        vm->context.world = world;
+    }
+
+    for (size_t i = 0; i < _prototypes.size(); ++i) {
+        auto& prototype = _prototypes[i];
+
+        prototype.stats.instances = static_cast<int>(prototype.batch.size());
+        prototype.stats.update_ms = 0.0;
+
+        if (prototype.batch.empty()) {
+            continue;
+        }
+
+        if (prototype.stats.is_parallel && _job_system && _job_system->get_worker_count() > 0) {
+            run_parallel(prototype, static_cast<int>(i), it.delta_time());
+        } else {
+            run_serial(prototype, static_cast<int>(i), it.delta_time());
+        }
+    }
+
+    for (auto& vm : _vms) {
+        vm->context.world = nullptr;
+    }
+}
+
+std::vector<ScriptStats> ScriptSystem::get_stats() const {
+    std::vector<ScriptStats> stats;
+    stats.reserve(_prototypes.size());
+
+    for (const auto& prototype : _prototypes) {
+        stats.push_back(prototype.stats);
+    }
+
+    return stats;
+}
+
+void ScriptSystem::set_gc(bool is_generational, float budget_ms) {
+    _is_gc_generational = is_generational;
+    _gc_budget_ns       = static_cast<Uint64>(std::max(budget_ms, 0.0f) * 1e6f);
+
+    for (auto& vm : _vms) {
+        apply_gc_mode(vm->lua.lua_state());
+    }
+}
+
+void ScriptSystem::collect_garbage(Uint64 budget_ns) {
+    const Uint64 start    = SDL_GetTicksNS();
+    const Uint64 deadline = start + std::min(budget_ns, _gc_budget_ns);
+
+    _gc_stats = {};
+
+    for (size_t n = 0; n < _vms.size() && SDL_GetTicksNS() < deadline; ++n) {
+        lua_State* L = _vms[(_gc_cursor + n) % _vms.size()]->lua.lua_state();
+
+        if (lua_gc(L, LUA_GCISRUNNING) == 0) {
+            continue;
+        }
+
+        if (_is_gc_generational && LUA_VERSION_NUM >= 504) {
+            _gc_stats.steps++;
+            lua_gc(L, LUA_GCSTEP, 0);
+            continue;
+        }
+
+        // Returns 1 once the cycle is done, a clean heap isn't stepped again this frame
+        do {
+            _gc_stats.steps++;
+
+            if (lua_gc(L, LUA_GCSTEP, GC_STEP_KB) != 0) {
+                _gc_stats.cycles++;
+                break;
+            }
+        } while (SDL_GetTicksNS() < deadline);
+    }
+
+    _gc_cursor = _vms.empty() ? 0 : (_gc_cursor + 1) % _vms.size();
+
+    for (auto& vm : _vms) {
+        _gc_stats.heap_bytes += get_heap_bytes(vm->lua.lua_state());
+    }
+
+    _gc_stats.gc_ms = static_cast<double>(SDL_GetTicksNS() - start) / 1e6;
+}
+
+const ScriptGcStats& ScriptSystem::get_gc_stats() const {
+    return _gc_stats;
+}
+
+sol::state& ScriptSystem::get_state() {
+    return _vms.front()->lua;
+}
+
+std::unique_ptr<ScriptSystem::Vm> ScriptSystem::create_vm() const {
+    auto vm = std::make_unique<Vm>();
+    vm->lua.open_libraries(sol::lib::base, sol::lib::math, sol::lib::string, sol::lib::table, sol::lib::coroutine, sol::lib::os);
+    vm->context.transform_query = _transform_query.c_ptr();
+    generate_bindings(vm->lua.lua_state(), &vm->context);
+    apply_gc_mode(vm->lua.lua_state());
+    return vm;
+}
+
+void ScriptSystem::apply_gc_mode(lua_State* L) const {
+#if LUA_VERSION_NUM >= 504
+    // Default parameters of each mode
+    if (_is_gc_generational) {
+        lua_gc(L, LUA_GCGEN, 0, 0);
+    } else {
+        lua_gc(L, LUA_GCINC, 0, 0, 0);
+    }
+#else
+    (void)L;
+#endif
+}
+
+bool ScriptSystem::load_into(Vm& vm, int index) {
+    vm.handles.resize(_prototypes.size());
+
+    const Prototype& prototype = _prototypes[index];
+    Handles& handles           = vm.handles[index];
+
+    // Cooked scripts are bytecode, the signature can't start a source file
+    const auto mode        = is_bytecode(prototype.chunk) ? sol::load_mode::binary : sol::load_mode::text;
+    sol::load_result chunk = vm.lua.load(prototype.chunk, "@" + prototype.stats.path, mode);
+    if (!chunk.valid()) {
+        const sol::error error = chunk;
+        spdlog::error("ScriptSystem - {}", error.what());
+        return false;
+    }
+
+    handles.environment = sol::environment(vm.lua, sol::create, vm.lua.globals());
+
+    sol::protected_function main = chunk;
+
+    // The first upvalue of a main chunk is `_ENV`, set by index since stripped bytecode has no upvalue names to find it by
+    lua_State* L = vm.lua.lua_state();
+    main.push(L);
+    handles.environment.push(L);
+
+    if (!lua_setupvalue(L, -2, 1)) {
+        lua_pop(L, 1);
+    }
+
+    lua_pop(L, 1);
+
+    if (const sol::protected_function_result result = main(); !result.valid()) {
+        const sol::error error = result;
+        spdlog::error("ScriptSystem - {}", error.what());
+        return false;
+    }
+
+    // Raw gets, a global `update` of another script must not be picked up through `_G`
+    if (const auto ready = handles.environment.raw_get<sol::object>("ready"); ready.get_type() == sol::type::function) {
+        handles.ready = ready.as<sol::protected_function>();
+    }
+
+    if (const auto update = handles.environment.raw_get<sol::object>("update"); update.get_type() == sol::type::function) {
+        handles.update = update.as<sol::protected_function>();
+    }
+
+    handles.is_loaded = true;
+    return true;
+}
+
+void ScriptSystem::run_serial(Prototype& prototype, int index, float delta) {
+    Vm& vm = *_vms.front();
+
+    vm.time_ns = 0;
+    vm.errors  = 0;
+
+    run_range(vm, prototype, index, 0, prototype.batch.size(), delta);
+
+    prototype.stats.update_ms = static_cast<double>(vm.time_ns) / 1e6;
+    prototype.stats.errors += vm.errors;
+}
+
+void ScriptSystem::run_parallel(Prototype& prototype, int index, float delta) {
+    // Slot 0 is the calling thread, which takes its share of the batch
+    const size_t slot_count = static_cast<size_t>(_job_system->get_worker_count()) + 1;
+
+    while (_vms.size() < slot_count) {
+        _vms.push_back(create_vm());
+        _vms.back()->context.world = _vms.front()->context.world;
+    }
+
+    for (auto& vm : _vms) {
+        vm->time_ns = 0;
+        vm->errors  = 0;
+        vm->commands.clear();
+        vm->context.commands = &vm->commands;
+
+        // Compiled once per state, before the batch so workers never touch the file system
+        if (index >= static_cast<int>(vm->handles.size()) || !vm->handles[index].is_loaded) {
+            load_into(*vm, index);
+        }
+    }
+
+    _job_system->parallel_for(static_cast<int>(prototype.batch.size()), [this, &prototype, index, delta](int begin, int end) {
+        Vm& vm = *_vms[JobSystem::get_worker_index() + 1];
+        run_range(vm, prototype, index, begin, end, delta);
+    }, PARALLEL_MIN_CHUNK);
+
+    Uint64 time_ns = 0;
+
+    for (auto& vm : _vms) {
+        vm->context.commands = nullptr;
+        vm->context.self     = 0;
+
+        apply(vm->context.world, vm->commands);
+
+        time_ns += vm->time_ns;
+        prototype.stats.errors += vm->errors;
+    }
+
+    prototype.stats.update_ms = static_cast<double>(time_ns) / 1e6;
+}
+
+void ScriptSystem::run_range(Vm& vm, Prototype& prototype, int index, size_t begin, size_t end, float delta) {
+    if (index >= static_cast<int>(vm.handles.size()) || !vm.handles[index].is_loaded) {
+        return;
+    }
+
+    const Handles& handles = vm.handles[index];
+    lua_State* L           = vm.lua.lua_state();
+    const Uint64 start     = SDL_GetTicksNS();
+
+    if (handles.ready.valid()) {
+        handles.ready.push(L);
+
+        for (size_t i = begin; i < end; ++i) {
+            Instance& instance = prototype.batch[i];
+
+            if (instance.script->is_ready) {
+                continue;
+            }
+
+            instance.script->is_ready = true;
+            vm.context.self           = instance.entity;
+
+            lua_pushvalue(L, -1);
+            push_entity(L, instance.entity);
+
+            if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+                fail(vm, prototype, instance);
+            }
+        }
+
+        lua_pop(L, 1);
+    }
+
+    if (handles.update.valid()) {
+        handles.update.push(L);
+
+        for (size_t i = begin; i < end; ++i) {
+            Instance& instance = prototype.batch[i];
+
+            // Failed in `ready` just above
+            if (instance.script->is_failed) {
+                continue;
+            }
+
+            instance.script->is_ready = true;
+            vm.context.self           = instance.entity;
+
+            lua_pushvalue(L, -1);
+            push_entity(L, instance.entity);
+            lua_pushnumber(L, delta);
+
+            if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+                fail(vm, prototype, instance);
+            }
+        }
+
+        lua_pop(L, 1);
+    }
+
+    vm.time_ns += SDL_GetTicksNS() - start;
+}
+
+void ScriptSystem::fail(Vm& vm, const Prototype& prototype, Instance& instance) {
+    lua_State* L = vm.lua.lua_state();
+
+    spdlog::error("ScriptSystem - {} (entity {}): {}", prototype.stats.path, instance.entity, lua_tostring(L, -1));
+    lua_pop(L, 1);
+
+    instance.script->is_failed = true;
+    vm.errors++;
+}
+
+void ScriptSystem::apply(flecs::world_t* world, const std::vector<ScriptCommand>& commands) {
+    for (const auto& command : commands) {
+        if (!ecs_is_alive(world, command.entity)) {
+            continue;
+        }
+
+        if (command.type == ScriptCommand::Type::DESTRUCT) {
+            ecs_delete(world, command.entity);
+            continue;
+        }
+
+        auto* transform = flecs::entity(world, command.entity).try_get_mut<Transform3D>();
+        if (!transform) {
+            continue;
+        }
+
+        switch (command.type) {
+            case ScriptCommand::Type::SET_POSITION:
+                transform->position = command.value;
+                break;
+            case ScriptCommand::Type::SET_ROTATION:
+                transform->rotation = command.value;
+                break;
+            case ScriptCommand::Type::SET_SCALE:
+                transform->scale = command.value;
+                break;
+            default:
+                break;
+        }
+
+        // Not the entity of the script, its table isn't marked changed by `RunScripts`
+        flecs::entity(world, command.entity).modified<Transform3D>();
+    }
+}
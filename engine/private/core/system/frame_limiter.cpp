@@ -0,0 +1,55 @@
+#include "core/system/frame_limiter.h"
+
+
+void FrameLimiter::set_target_fps(int fps) {
+    if (fps == _target_fps) {
+        return;
+    }
+
+    _target_fps = std::max(fps, 0);
+    _period     = _target_fps > 0 ? SDL_GetPerformanceFrequency() / static_cast<Uint64>(_target_fps) : 0;
+    _deadline   = 0;
+}
+
+int FrameLimiter::get_target_fps() const {
+    return _target_fps;
+}
+
+Uint64 FrameLimiter::get_remaining_ns() const {
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    if (_period == 0 || _deadline == 0 || now >= _deadline) {
+        return 0;
+    }
+
+    return (_deadline - now) * SDL_NS_PER_SECOND / SDL_GetPerformanceFrequency();
+}
+
+void FrameLimiter::wait() {
+    if (_period == 0) {
+        return;
+    }
+
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    // First frame, or more than a frame late: resync instead of rushing the next frames to catch up
+    if (_deadline == 0 || now > _deadline + _period) {
+        _deadline = now + _period;
+        return;
+    }
+
+    if (now < _deadline) {
+        const Uint64 freq         = SDL_GetPerformanceFrequency();
+        const Uint64 remaining_ns = (_deadline - now) * SDL_NS_PER_SECOND / freq;
+
+        if (remaining_ns > SPIN_THRESHOLD_NS) {
+            SDL_DelayNS(remaining_ns - SPIN_THRESHOLD_NS);
+        }
+
+        while (SDL_GetPerformanceCounter() < _deadline) {
+            SDL_CPUPauseInstruction();
+        }
+    }
+
+    _deadline += _period;
+}
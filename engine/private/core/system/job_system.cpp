@@ -0,0 +1,418 @@
+#include "core/system/job_system.h"
+
+#if defined(SDL_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#include <sched.h>
+#endif
+
+struct Job {
+    JobSystem::JobFn fn;
+    JobCounter* counter = nullptr;
+};
+
+namespace {
+
+constexpr int IDLE_SPIN_COUNT = 256; // pause iterations before a worker goes to sleep
+
+thread_local int t_worker_index  = -1;
+thread_local JobSystem* t_owner  = nullptr;
+
+void set_current_thread_affinity(int core) {
+#if defined(SDL_PLATFORM_WINDOWS)
+    if (!SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core)) {
+        spdlog::warn("JobSystem - Failed to pin worker to core {}", core);
+    }
+#elif defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        spdlog::warn("JobSystem - Failed to pin worker to core {}", core);
+    }
+#else
+    (void) core;
+    spdlog::warn("JobSystem - Thread affinity is not supported on this platform");
+#endif
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// WorkStealingQueue
+// -----------------------------------------------------------------------------
+bool WorkStealingQueue::push(Job* job) {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+    const int64_t top    = _top.load(std::memory_order_acquire);
+
+    if (bottom - top >= CAPACITY) {
+        return false;
+    }
+
+    _buffer[bottom & MASK].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Job* WorkStealingQueue::pop() {
+    const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = _top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = _buffer[bottom & MASK].load(std::memory_order_relaxed);
+
+    // Last job, race against thieves for it
+    if (top == bottom) {
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+Job* WorkStealingQueue::steal() {
+    int64_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    Job* job = _buffer[top & MASK].load(std::memory_order_relaxed);
+
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    return job;
+}
+
+bool WorkStealingQueue::is_empty() const {
+    return _top.load(std::memory_order_acquire) >= _bottom.load(std::memory_order_acquire);
+}
+
+// -----------------------------------------------------------------------------
+// JobSystem
+// -----------------------------------------------------------------------------
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+bool JobSystem::initialize(int worker_count, int reserved_threads, bool use_affinity) {
+    if (_running) {
+        spdlog::warn("JobSystem::initialize - Already initialized");
+        return false;
+    }
+
+    _main_thread_id = std::this_thread::get_id();
+
+    const int hardware_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    const int count            = worker_count < 0 ? std::max(hardware_threads - reserved_threads, 1) : worker_count;
+
+    _running = true;
+    _workers.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        auto worker   = std::make_unique<Worker>();
+        worker->owner = this;
+        worker->index = i;
+        worker->core  = use_affinity ? (i + reserved_threads) % hardware_threads : -1;
+
+        // Workers only look at `_workers` once they run a job, it is complete before the first schedule
+        _workers.push_back(std::move(worker));
+    }
+
+    for (auto& worker : _workers) {
+        const std::string name = fmt::format("golias-worker-{}", worker->index);
+        worker->thread         = SDL_CreateThread(worker_entry, name.c_str(), worker.get());
+
+        if (!worker->thread) {
+            spdlog::error("JobSystem::initialize - Failed to create {}: {}", name, SDL_GetError());
+            shutdown();
+            return false;
+        }
+    }
+
+    spdlog::info("JobSystem::initialize - {} worker threads{}", count, use_affinity ? " (pinned)" : "");
+    return true;
+}
+
+void JobSystem::shutdown() {
+    run_main_thread_jobs();
+
+    {
+        std::lock_guard lock(_sleep_mutex);
+        if (!_running) {
+            return;
+        }
+        _running = false;
+    }
+
+    _sleep_cv.notify_all();
+
+    // Workers leave once every queued job ran
+    for (auto& worker : _workers) {
+        if (worker->thread) {
+            SDL_WaitThread(worker->thread, nullptr);
+        }
+    }
+
+    _workers.clear();
+}
+
+int JobSystem::get_worker_count() const {
+    return static_cast<int>(_workers.size());
+}
+
+int JobSystem::get_worker_index() {
+    return t_worker_index;
+}
+
+void JobSystem::schedule(JobFn fn, JobCounter* counter, JobCounter* dependency) {
+    auto* job = new Job{std::move(fn), counter};
+
+    if (counter) {
+        counter->_pending.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    if (dependency) {
+        std::lock_guard lock(dependency->_mutex);
+
+        if (!dependency->is_done()) {
+            dependency->_waiting.push_back(job);
+            return;
+        }
+    }
+
+    enqueue(job);
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    const int index     = t_owner == this ? t_worker_index : -1;
+    const bool is_main  = std::this_thread::get_id() == _main_thread_id;
+
+    while (!counter.is_done()) {
+        if (Job* job = find_job(index)) {
+            execute(job);
+            continue;
+        }
+
+        if (is_main) {
+            run_main_thread_jobs();
+        }
+
+        std::this_thread::yield();
+    }
+
+    // The last job may still be releasing its dependents, the counter must stay alive until it is done
+    std::lock_guard lock(counter._mutex);
+}
+
+void JobSystem::parallel_for(int count, const RangeFn& fn, int min_chunk) {
+    if (count <= 0) {
+        return;
+    }
+
+    min_chunk = std::max(min_chunk, 1);
+
+    if (_workers.empty() || count <= min_chunk) {
+        fn(0, count);
+        return;
+    }
+
+    const int participants = get_worker_count() + 1;
+    std::atomic<int> next{0};
+
+    auto run = [&] {
+        while (true) {
+            int begin = next.load(std::memory_order_relaxed);
+            int end   = 0;
+
+            do {
+                if (begin >= count) {
+                    return;
+                }
+
+                const int remaining = count - begin;
+                end                 = begin + std::min(std::max(remaining / (participants * 2), min_chunk), remaining);
+            } while (!next.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+
+            fn(begin, end);
+        }
+    };
+
+    JobCounter counter;
+    const int helpers = std::min(get_worker_count(), (count + min_chunk - 1) / min_chunk - 1);
+
+    for (int i = 0; i < helpers; ++i) {
+        schedule([&run] { run(); }, &counter);
+    }
+
+    run();
+    wait(counter);
+}
+
+void JobSystem::schedule_main_thread(JobFn fn, JobCounter* counter) {
+    auto* job = new Job{std::move(fn), counter};
+
+    if (counter) {
+        counter->_pending.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    std::lock_guard lock(_main_thread_mutex);
+    _main_thread_queue.push_back(job);
+}
+
+void JobSystem::run_main_thread_jobs() {
+    std::deque<Job*> jobs;
+
+    {
+        std::lock_guard lock(_main_thread_mutex);
+        jobs.swap(_main_thread_queue);
+    }
+
+    for (Job* job : jobs) {
+        execute(job);
+    }
+}
+
+int JobSystem::worker_entry(void* data) {
+    auto* worker = static_cast<Worker*>(data);
+    worker->owner->worker_loop(*worker);
+    return 0;
+}
+
+void JobSystem::worker_loop(Worker& worker) {
+    t_worker_index = worker.index;
+    t_owner        = this;
+
+    if (worker.core >= 0) {
+        set_current_thread_affinity(worker.core);
+    }
+
+    while (true) {
+        if (Job* job = find_job(worker.index)) {
+            execute(job);
+            continue;
+        }
+
+        // Jobs tend to come in bursts, spin a little before paying for a sleep/wake up
+        for (int spin = 0; spin < IDLE_SPIN_COUNT && _queued.load(std::memory_order_acquire) == 0; ++spin) {
+            SDL_CPUPauseInstruction();
+        }
+
+        if (_queued.load(std::memory_order_acquire) > 0) {
+            continue;
+        }
+
+        std::unique_lock lock(_sleep_mutex);
+        _sleeping++;
+        _sleep_cv.wait(lock, [this] { return _queued.load() > 0 || !_running; });
+        _sleeping--;
+
+        if (!_running && _queued.load() == 0) {
+            break;
+        }
+    }
+
+    t_worker_index = -1;
+    t_owner        = nullptr;
+}
+
+void JobSystem::enqueue(Job* job) {
+    if (_workers.empty()) {
+        execute(job);
+        return;
+    }
+
+    _queued.fetch_add(1);
+
+    const int index = t_owner == this ? t_worker_index : -1;
+
+    if (index < 0 || !_workers[index]->queue.push(job)) {
+        std::lock_guard lock(_injection_mutex);
+        _injection_queue.push_back(job);
+    }
+
+    // Both counters are sequentially consistent: either the worker sees the job or we see it sleeping
+    if (_sleeping.load() > 0) {
+        std::lock_guard lock(_sleep_mutex);
+        _sleep_cv.notify_one();
+    }
+}
+
+Job* JobSystem::find_job(int worker_index) {
+    if (_queued.load(std::memory_order_acquire) <= 0) {
+        return nullptr;
+    }
+
+    Job* job = nullptr;
+
+    if (worker_index >= 0) {
+        job = _workers[worker_index]->queue.pop();
+    }
+
+    if (!job) {
+        std::lock_guard lock(_injection_mutex);
+        if (!_injection_queue.empty()) {
+            job = _injection_queue.front();
+            _injection_queue.pop_front();
+        }
+    }
+
+    if (!job) {
+        const int count = get_worker_count();
+        const int start = worker_index >= 0 ? worker_index + 1 : 0;
+
+        for (int i = 0; i < count && !job; ++i) {
+            const int victim = (start + i) % count;
+            if (victim != worker_index) {
+                job = _workers[victim]->queue.steal();
+            }
+        }
+    }
+
+    if (job) {
+        _queued.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    return job;
+}
+
+void JobSystem::execute(Job* job) {
+    job->fn();
+    finish(job);
+}
+
+void JobSystem::finish(Job* job) {
+    if (JobCounter* counter = job->counter) {
+        std::vector<Job*> released;
+
+        {
+            // Decrement under the lock, `wait` takes it before a counter can be destroyed
+            std::lock_guard lock(counter->_mutex);
+            if (counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                released.swap(counter->_waiting);
+            }
+        }
+
+        for (Job* dependent : released) {
+            enqueue(dependent);
+        }
+    }
+
+    delete job;
+}
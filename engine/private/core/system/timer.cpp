@@ -22,4 +22,33 @@ void Timer::tick() {
     Uint64 freq = SDL_GetPerformanceFrequency();
     delta       = static_cast<double>(now - last) / static_cast<double>(freq);
     elapsed_time += delta;
-}
\ No newline at end of file
+}
+
+void Timer::set_fixed_rate(int steps_per_second) {
+    fixed_delta = steps_per_second > 0 ? 1.0 / static_cast<double>(steps_per_second) : 0.0;
+    accumulator = 0.0;
+    alpha       = 1.0;
+}
+
+int Timer::accumulate_fixed_steps() {
+    if (fixed_delta <= 0.0) {
+        alpha = 1.0;
+        return 0;
+    }
+
+    accumulator += delta;
+
+    int steps = 0;
+    while (accumulator >= fixed_delta && steps < MAX_FIXED_STEPS) {
+        accumulator -= fixed_delta;
+        steps++;
+    }
+
+    // Still behind after MAX_FIXED_STEPS: slow the simulation down instead of spiralling
+    if (accumulator >= fixed_delta) {
+        accumulator = std::fmod(accumulator, fixed_delta);
+    }
+
+    alpha = accumulator / fixed_delta;
+    return steps;
+}
@@ -0,0 +1,291 @@
+#include "core/utility/mesh_cache.h"
+#include "core/utility/hash.h"
+#include "core/io/mapped_file.h"
+
+namespace {
+
+constexpr Uint32 GMESH_MAGIC = 0x48534D47; // "GMSH"
+constexpr size_t BLOB_ALIGN  = 16;
+
+struct GMeshHeader {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 mesh_count;
+    Uint32 material_count;
+    Uint32 texture_count;
+    Uint32 dependency_count;
+    Uint64 file_size;
+};
+
+struct MeshRecord {
+    Uint64 vertex_offset;
+    Uint64 index_offset;
+    Uint64 name_offset;
+    Uint32 vertex_count;
+    Uint32 index_count;
+    Uint32 name_length;
+    Uint32 material;
+    float bounds_center[3];
+    float bounds_radius;
+    Uint32 reserved[2];
+};
+
+struct MaterialRecord {
+    float albedo[3];
+    float metallic;
+    float roughness;
+    float ao;
+    float emissive[3];
+    float emissive_strength;
+    Sint32 textures[6];
+};
+
+struct TextureRecord {
+    Uint32 kind;
+    Uint32 width;
+    Uint32 height;
+    Uint32 reserved;
+    Uint64 data_offset;
+    Uint64 data_size;
+};
+
+struct DependencyRecord {
+    Uint64 path_offset;
+    Uint64 hash;
+    Uint32 path_length;
+    Uint32 reserved;
+};
+
+static_assert(sizeof(GMeshHeader) == 32 && sizeof(MeshRecord) == 64 && sizeof(MaterialRecord) == 64 && sizeof(TextureRecord) == 32
+                  && sizeof(DependencyRecord) == 24,
+              "gmesh records must keep their on-disk size");
+static_assert(sizeof(Vertex) == 32 && std::is_trivially_copyable_v<Vertex>, "gmesh stores Vertex as-is");
+
+size_t align_up(size_t value) {
+    return (value + BLOB_ALIGN - 1) & ~(BLOB_ALIGN - 1);
+}
+
+/// Append `size` bytes at the next aligned offset, returns that offset
+Uint64 append_blob(std::vector<char>& out, const void* data, size_t size) {
+    const size_t offset = align_up(out.size());
+    out.resize(offset + size);
+
+    if (size > 0) {
+        std::memcpy(out.data() + offset, data, size);
+    }
+
+    return offset;
+}
+
+bool is_in_range(std::span<const std::byte> bytes, Uint64 offset, Uint64 size) {
+    return offset <= bytes.size() && size <= bytes.size() - offset;
+}
+
+template <typename T>
+const T* view_records(std::span<const std::byte> bytes, size_t& offset, Uint32 count) {
+    if (!is_in_range(bytes, offset, static_cast<Uint64>(count) * sizeof(T))) {
+        return nullptr;
+    }
+
+    const auto* records = reinterpret_cast<const T*>(bytes.data() + offset);
+    offset += count * sizeof(T);
+    return records;
+}
+
+} // namespace
+
+Uint64 MeshCache::compute_key(std::span<const std::byte> source, Uint32 import_flags) {
+    Uint64 key = hash_fnv1a_64(source.data(), source.size());
+    key        = hash_fnv1a_64(&import_flags, sizeof(import_flags), key);
+    key        = hash_fnv1a_64(&VERSION, sizeof(VERSION), key);
+    return key;
+}
+
+bool MeshCache::has_current_dependencies(const CookedModel& model) {
+    return std::ranges::all_of(model.dependencies, [](const CookedDependency& dependency) {
+        const MappedFile file{std::string(dependency.path)};
+        return file.is_open() && hash_fnv1a_64(file.data(), file.size()) == dependency.hash;
+    });
+}
+
+std::string MeshCache::get_cache_path(Uint64 key) {
+    return "user://cache/meshes/" + hash_to_string(key) + ".gmesh";
+}
+
+std::string MeshCache::get_cooked_path(const std::string& source_path) {
+    return source_path + ".gmesh";
+}
+
+std::vector<char> MeshCache::write(const CookedModel& model) {
+    const GMeshHeader header{GMESH_MAGIC, VERSION, static_cast<Uint32>(model.meshes.size()), static_cast<Uint32>(model.materials.size()),
+                             static_cast<Uint32>(model.textures.size()), static_cast<Uint32>(model.dependencies.size()), 0};
+
+    std::vector<MeshRecord> meshes(model.meshes.size());
+    std::vector<MaterialRecord> materials(model.materials.size());
+    std::vector<TextureRecord> textures(model.textures.size());
+    std::vector<DependencyRecord> dependencies(model.dependencies.size());
+
+    // Records first, their offsets are patched once the blobs are placed
+    std::vector<char> out;
+    append_blob(out, &header, sizeof(header));
+    const size_t mesh_offset       = append_blob(out, meshes.data(), meshes.size() * sizeof(MeshRecord));
+    const size_t material_offset   = append_blob(out, materials.data(), materials.size() * sizeof(MaterialRecord));
+    const size_t texture_offset    = append_blob(out, textures.data(), textures.size() * sizeof(TextureRecord));
+    const size_t dependency_offset = append_blob(out, dependencies.data(), dependencies.size() * sizeof(DependencyRecord));
+
+    for (size_t i = 0; i < model.meshes.size(); ++i) {
+        const auto& mesh = model.meshes[i];
+        auto& record     = meshes[i];
+
+        record.vertex_count  = static_cast<Uint32>(mesh.vertices.size());
+        record.index_count   = static_cast<Uint32>(mesh.indices.size());
+        record.name_length   = static_cast<Uint32>(mesh.name.size());
+        record.material      = mesh.material;
+        record.bounds_radius = mesh.bounds_radius;
+        std::memcpy(record.bounds_center, &mesh.bounds_center.x, sizeof(record.bounds_center));
+
+        record.vertex_offset = append_blob(out, mesh.vertices.data(), mesh.vertices.size_bytes());
+        record.index_offset  = append_blob(out, mesh.indices.data(), mesh.indices.size_bytes());
+        record.name_offset   = append_blob(out, mesh.name.data(), mesh.name.size());
+    }
+
+    for (size_t i = 0; i < model.materials.size(); ++i) {
+        const auto& material = model.materials[i].material;
+        auto& record         = materials[i];
+
+        std::memcpy(record.albedo, &material.albedo.x, sizeof(record.albedo));
+        std::memcpy(record.emissive, &material.emissive.x, sizeof(record.emissive));
+        record.metallic          = material.metallic;
+        record.roughness         = material.roughness;
+        record.ao                = material.ao;
+        record.emissive_strength = material.emissive_strength;
+        std::ranges::copy(model.materials[i].textures, record.textures);
+    }
+
+    for (size_t i = 0; i < model.textures.size(); ++i) {
+        const auto& texture = model.textures[i];
+
+        textures[i] = {static_cast<Uint32>(texture.kind), texture.width, texture.height, 0,
+                       append_blob(out, texture.data.data(), texture.data.size()), texture.data.size()};
+    }
+
+    for (size_t i = 0; i < model.dependencies.size(); ++i) {
+        const auto& dependency = model.dependencies[i];
+
+        dependencies[i] = {append_blob(out, dependency.path.data(), dependency.path.size()), dependency.hash,
+                           static_cast<Uint32>(dependency.path.size()), 0};
+    }
+
+    auto* written_header      = reinterpret_cast<GMeshHeader*>(out.data());
+    written_header->file_size = out.size();
+
+    std::memcpy(out.data() + mesh_offset, meshes.data(), meshes.size() * sizeof(MeshRecord));
+    std::memcpy(out.data() + material_offset, materials.data(), materials.size() * sizeof(MaterialRecord));
+    std::memcpy(out.data() + texture_offset, textures.data(), textures.size() * sizeof(TextureRecord));
+    std::memcpy(out.data() + dependency_offset, dependencies.data(), dependencies.size() * sizeof(DependencyRecord));
+
+    return out;
+}
+
+bool MeshCache::read(std::span<const std::byte> bytes, CookedModel& out) {
+    size_t offset = 0;
+
+    const auto* header = view_records<GMeshHeader>(bytes, offset, 1);
+
+    if (!header || header->magic != GMESH_MAGIC || header->version != VERSION || header->file_size != bytes.size()) {
+        return false;
+    }
+
+    offset             = align_up(offset);
+    const auto* meshes = view_records<MeshRecord>(bytes, offset, header->mesh_count);
+
+    offset                = align_up(offset);
+    const auto* materials = view_records<MaterialRecord>(bytes, offset, header->material_count);
+
+    offset               = align_up(offset);
+    const auto* textures = view_records<TextureRecord>(bytes, offset, header->texture_count);
+
+    offset                   = align_up(offset);
+    const auto* dependencies = view_records<DependencyRecord>(bytes, offset, header->dependency_count);
+
+    if (!meshes || !materials || !textures || !dependencies) {
+        return false;
+    }
+
+    out = {};
+    out.meshes.reserve(header->mesh_count);
+    out.materials.reserve(header->material_count);
+    out.textures.reserve(header->texture_count);
+    out.dependencies.reserve(header->dependency_count);
+
+    const auto* base = reinterpret_cast<const char*>(bytes.data());
+
+    for (Uint32 i = 0; i < header->mesh_count; ++i) {
+        const auto& record = meshes[i];
+
+        if (!is_in_range(bytes, record.vertex_offset, static_cast<Uint64>(record.vertex_count) * sizeof(Vertex))
+            || !is_in_range(bytes, record.index_offset, static_cast<Uint64>(record.index_count) * sizeof(unsigned int))
+            || !is_in_range(bytes, record.name_offset, record.name_length) || record.material >= header->material_count
+            || record.vertex_offset % BLOB_ALIGN != 0 || record.index_offset % BLOB_ALIGN != 0) {
+            return false;
+        }
+
+        CookedMesh mesh;
+        mesh.name          = {base + record.name_offset, record.name_length};
+        mesh.vertices      = {reinterpret_cast<const Vertex*>(base + record.vertex_offset), record.vertex_count};
+        mesh.indices       = {reinterpret_cast<const unsigned int*>(base + record.index_offset), record.index_count};
+        mesh.bounds_center = {record.bounds_center[0], record.bounds_center[1], record.bounds_center[2]};
+        mesh.bounds_radius = record.bounds_radius;
+        mesh.material      = record.material;
+
+        // A corrupted index would read past the vertex buffer on the GPU
+        if (std::ranges::any_of(mesh.indices, [&](unsigned int index) { return index >= record.vertex_count; })) {
+            return false;
+        }
+
+        out.meshes.push_back(mesh);
+    }
+
+    for (Uint32 i = 0; i < header->material_count; ++i) {
+        const auto& record = materials[i];
+
+        CookedMaterial material;
+        material.material.albedo            = {record.albedo[0], record.albedo[1], record.albedo[2]};
+        material.material.metallic          = record.metallic;
+        material.material.roughness         = record.roughness;
+        material.material.ao                = record.ao;
+        material.material.emissive          = {record.emissive[0], record.emissive[1], record.emissive[2]};
+        material.material.emissive_strength = record.emissive_strength;
+
+        for (size_t map = 0; map < material.textures.size(); ++map) {
+            const Sint32 texture   = record.textures[map];
+            material.textures[map] = texture >= 0 && static_cast<Uint32>(texture) < header->texture_count ? texture : -1;
+        }
+
+        out.materials.push_back(material);
+    }
+
+    for (Uint32 i = 0; i < header->texture_count; ++i) {
+        const auto& record = textures[i];
+
+        if (record.kind > static_cast<Uint32>(CookedTextureKind::RAW) || !is_in_range(bytes, record.data_offset, record.data_size)
+            || (record.kind == static_cast<Uint32>(CookedTextureKind::RAW) && record.data_size < static_cast<Uint64>(record.width) * record.height * 4)) {
+            return false;
+        }
+
+        out.textures.push_back({static_cast<CookedTextureKind>(record.kind), record.width, record.height,
+                                {reinterpret_cast<const unsigned char*>(base + record.data_offset), static_cast<size_t>(record.data_size)}});
+    }
+
+    for (Uint32 i = 0; i < header->dependency_count; ++i) {
+        const auto& record = dependencies[i];
+
+        if (!is_in_range(bytes, record.path_offset, record.path_length)) {
+            return false;
+        }
+
+        out.dependencies.push_back({{base + record.path_offset, record.path_length}, record.hash});
+    }
+
+    return true;
+}
@@ -2,6 +2,58 @@
 
 #include "core/engine.h"
 #include "core/io/assimp_io.h"
+#include "core/io/mapped_file.h"
+#include "core/utility/hash.h"
+
+namespace {
+
+struct MaterialMapSlot {
+    aiTextureType type;
+    Uint32 Material::* map;
+    bool Material::* use_map;
+    const char* name;
+};
+
+/// Same order as `CookedMaterial::textures`
+const std::array<MaterialMapSlot, 6> MATERIAL_MAP_SLOTS = {{
+    {aiTextureType_DIFFUSE, &Material::albedo_map, &Material::use_albedo_map, "albedo"},
+    {aiTextureType_METALNESS, &Material::metallic_map, &Material::use_metallic_map, "metallic"},
+    {aiTextureType_DIFFUSE_ROUGHNESS, &Material::roughness_map, &Material::use_roughness_map, "roughness"},
+    {aiTextureType_NORMALS, &Material::normal_map, &Material::use_normal_map, "normal"},
+    {aiTextureType_AMBIENT_OCCLUSION, &Material::ao_map, &Material::use_ao_map, "ao"},
+    {aiTextureType_EMISSIVE, &Material::emissive_map, &Material::use_emissive_map, "emissive"},
+}};
+
+/// Written under a unique name then renamed over `cache_path`: a crash, or another thread or process importing the same model,
+/// never leaves a partial cache for the next run to map
+bool write_mesh_cache(const std::string& cache_path, const std::vector<char>& bytes) {
+    static std::atomic<Uint32> counter = 0;
+
+    const std::string temp_path = fmt::format("{}.{}-{}-{}.tmp", cache_path, SDL_GetTicksNS(),
+                                              std::hash<std::thread::id>{}(std::this_thread::get_id()), counter++);
+    {
+        FileAccess file(temp_path, ModeFlags::WRITE);
+        if (!file.is_open() || !file.store_bytes(bytes)) {
+            file.close();
+
+            std::error_code error;
+            std::filesystem::remove(FileAccess::globalize_path(temp_path), error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(FileAccess::globalize_path(temp_path), FileAccess::globalize_path(cache_path), error);
+
+    if (error) {
+        std::filesystem::remove(FileAccess::globalize_path(temp_path), error);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
 
 MeshInstance3D ObjectLoader::load_mesh(const std::string& path) {
     Model model = load_model(path);
@@ -9,78 +61,179 @@ MeshInstance3D ObjectLoader::load_mesh(const std::string& path) {
 }
 
 Model ObjectLoader::load_model(const std::string& path) {
-    Model model;
-    model.path = path;
+    ImportedModel imported;
 
-    std::string path_str = path;
+    if (!import_model(path, imported)) {
+        Model model;
+        model.path = path;
+        return model;
+    }
 
-    std::size_t pos = path_str.find("//");
-    if (pos != std::string::npos && pos + 2 < path_str.size()) {
-        path_str = path_str.substr(pos + 2);
+    return upload_model(imported);
+}
+
+bool ObjectLoader::import_model(const std::string& path, ImportedModel& out) {
+    out.path      = path;
+    out.directory = get_model_directory(path);
+
+    // Shipped by golias_cook: found by path, the source isn't even read
+    if (map_mesh_cache(MeshCache::get_cooked_path(path), out)) {
+        spdlog::info("Loading model: {} (cooked)", path);
     }
 
-    std::string base_dir = ASSETS_PATH;
+    if (!out.cache) {
+        // Mapped once: hashed for the cache key, then handed to Assimp on a miss
+        MappedFile source(path);
 
-    size_t last_slash = path_str.find_last_of("/\\");
-    if (last_slash != std::string::npos) {
-        base_dir += path_str.substr(0, last_slash + 1);
+        if (!source.is_open()) {
+            spdlog::error("Failed to open model: {}", path);
+            return false;
+        }
+
+        const std::string cache_path = MeshCache::get_cache_path(MeshCache::compute_key(source.bytes(), IMPORT_FLAGS));
+
+        if (map_mesh_cache(cache_path, out) && MeshCache::has_current_dependencies(out.cooked)) {
+            spdlog::info("Loading model: {} (cached: {})", path, cache_path);
+        } else {
+            if (out.cache) {
+                spdlog::info("ObjectLoader::import_model - External files of {} changed, importing it again", path);
+
+                // Unmapped before the new cache is renamed over it
+                out.cache.reset();
+            }
+
+            if (!cook_model(path, source.bytes(), out.cooked_bytes)) {
+                return false;
+            }
+
+            source.close();
+
+            if (!write_mesh_cache(cache_path, out.cooked_bytes)) {
+                spdlog::warn("ObjectLoader::import_model - Failed to write mesh cache {}", cache_path);
+            }
+
+            // The freshly cooked buffer goes through the same path as a cache hit
+            if (!MeshCache::read(std::as_bytes(std::span(out.cooked_bytes)), out.cooked)) {
+                spdlog::error("ObjectLoader::import_model - Cooked {} is unreadable", path);
+                return false;
+            }
+        }
     }
 
-    spdlog::info("Loading model: {} (base_dir: {})", path, base_dir);
+    // Textures decode in parallel, only their upload waits for the main thread
+    out.textures.resize(out.cooked.textures.size());
+
+    GEngine->get_job_system().parallel_for_each(static_cast<int>(out.textures.size()), [&out](int i) {
+        const auto& texture = out.cooked.textures[i];
+
+        // Keyed by model and index, embedded data has no stable address once the cache is unmapped
+        const std::string name = fmt::format("{}#{}", out.path, i);
+
+        switch (texture.kind) {
+        case CookedTextureKind::FILE:
+            out.textures[i] = Renderer::decode_texture_file(out.directory + std::string(reinterpret_cast<const char*>(texture.data.data()), texture.data.size()));
+            break;
+        case CookedTextureKind::ENCODED:
+            out.textures[i] = Renderer::decode_texture_memory(texture.data.data(), texture.data.size(), name);
+            break;
+        case CookedTextureKind::RAW:
+            out.textures[i] = Renderer::wrap_texture_raw(texture.data.data(), static_cast<int>(texture.width), static_cast<int>(texture.height), 4, name);
+            break;
+        }
 
-    auto importer   = std::make_shared<Assimp::Importer>();
-    std::string ext = path_str.substr(path_str.find_last_of('.') + 1);
+        if (!out.textures[i].pixels) {
+            spdlog::error("Failed to decode texture {} of {}", out.textures[i].name, out.path);
+        }
+    });
 
-    auto ioSystem = new SDLIOSystem(base_dir);
-    importer->SetIOHandler(ioSystem);
+    return true;
+}
 
-    constexpr auto ASSIMP_FLAGS = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals
-                                  | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph;
+bool ObjectLoader::cook_model(const std::string& path, std::span<const std::byte> source, std::vector<char>& out, std::vector<std::string>* dependencies) {
+    const std::string directory = get_model_directory(path);
 
-    std::string filename = (last_slash != std::string::npos) ? path_str.substr(last_slash + 1) : path_str;
+    spdlog::info("Loading model: {} (base_dir: {})", path, directory);
 
-    const aiScene* scene = importer->ReadFile(filename, ASSIMP_FLAGS);
+    auto importer   = std::make_shared<Assimp::Importer>();
+    std::string ext = path.substr(path.find_last_of('.') + 1);
 
+    // Only opens the external files (OBJ .mtl, glTF .bin), the model itself is read from `source`
+    auto ioSystem = new MappedIOSystem(directory);
+    importer->SetIOHandler(ioSystem);
+
+    const aiScene* scene = importer->ReadFileFromMemory(source.data(), source.size(), IMPORT_FLAGS, ext.c_str());
+
+    if (!scene) {
+        spdlog::error("Failed to import model {}: {}", path, importer->GetErrorString());
+        return false;
+    }
 
     spdlog::info("  Meshes: {}, Materials: {}, Animations: {}",
                  scene->mNumMeshes, scene->mNumMaterials, scene->mNumAnimations);
 
-    const auto renderer = GEngine->get_renderer();
+    // Hashed now, the `user://` cache is only used while they are unchanged
+    const auto& opened_files = ioSystem->get_opened_files();
+    std::vector<CookedDependency> hashed_files;
+    hashed_files.reserve(opened_files.size());
 
-    if (!renderer) {
-        spdlog::error("Renderer not initialized, cannot load model.");
-        exit(EXIT_FAILURE);
+    for (const auto& file_path : opened_files) {
+        const MappedFile file(file_path);
+        hashed_files.push_back({file_path, file.is_open() ? hash_fnv1a_64(file.data(), file.size()) : 0});
     }
 
+    out = cook(scene, hashed_files);
+
+    if (dependencies) {
+        *dependencies = opened_files;
+    }
+
+    Model skeleton; // Bones and animations are only reported for now
     for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-        aiMesh* aiMesh = scene->mMeshes[i];
-        spdlog::info("  Parsing Mesh({}) - Name {}", i, aiMesh->mName.C_Str());
+        if (scene->mMeshes[i]->HasBones()) {
+            parse_bones(scene->mMeshes[i], skeleton);
+        }
+    }
 
-        MeshInstance3D mesh = create_mesh(aiMesh);
-        mesh.name           = aiMesh->mName.C_Str();
-        model.meshes.push_back(mesh);
+    if (scene->HasAnimations()) {
+        parse_animations(scene, skeleton);
+    }
 
+    return true;
+}
 
+bool ObjectLoader::map_mesh_cache(const std::string& cache_path, ImportedModel& out) {
+    if (!FileAccess::file_exists(cache_path)) {
+        return false;
+    }
 
-        Material material = load_material(scene, aiMesh, base_dir, *renderer);
-        model.materials.push_back(material);
-        spdlog::info("    Material [{}]: Albedo ({:.2f},{:.2f},{:.2f}) | Metallic {:.2f} | Roughness {:.2f} | AO {:.2f}",
-                     aiMesh->mName.C_Str(), material.albedo.r, material.albedo.g, material.albedo.b,
-                     material.metallic, material.roughness, material.ao);
+    out.cache = std::make_unique<MappedFile>(cache_path);
 
-        if (aiMesh->HasBones()) {
-            parse_bones(aiMesh, model);
-        }
+    if (out.cache->is_open() && MeshCache::read(out.cache->bytes(), out.cooked)) {
+        return true;
     }
 
-    if (scene->HasAnimations()) {
-        parse_animations(scene, model);
+    spdlog::warn("ObjectLoader::import_model - Ignoring stale mesh cache {}", cache_path);
+    out.cache.reset();
+    return false;
+}
+
+std::string ObjectLoader::get_model_directory(const std::string& path) {
+    std::string path_str = path;
+
+    std::size_t pos = path_str.find("//");
+    if (pos != std::string::npos && pos + 2 < path_str.size()) {
+        path_str = path_str.substr(pos + 2);
     }
 
-    renderer->_meshes[path] = model.meshes;
-    renderer->_materials[path] = model.materials;
+    // Kept as res:// so side files (.mtl, .bin, textures) resolve through the VFS like the model itself
+    std::string directory = "res://";
 
-    return model;
+    size_t last_slash = path_str.find_last_of("/\\");
+    if (last_slash != std::string::npos) {
+        directory += path_str.substr(0, last_slash + 1);
+    }
+
+    return directory;
 }
 
 std::string ObjectLoader::get_directory(const std::string& path) {
@@ -88,9 +241,10 @@ std::string ObjectLoader::get_directory(const std::string& path) {
     return (found != std::string::npos) ? path.substr(0, found + 1) : "";
 }
 
-MeshInstance3D ObjectLoader::create_mesh(aiMesh* aiMesh) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+MeshGeometry ObjectLoader::create_geometry(const aiMesh* aiMesh) {
+    MeshGeometry geometry;
+    auto& vertices = geometry.vertices;
+    auto& indices  = geometry.indices;
     vertices.reserve(aiMesh->mNumVertices);
 
     for (unsigned int i = 0; i < aiMesh->mNumVertices; ++i) {
@@ -133,16 +287,36 @@ MeshInstance3D ObjectLoader::create_mesh(aiMesh* aiMesh) {
         indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
     }
 
-    MeshInstance3D mesh;
-    mesh.index_count = indices.size();
+    return geometry;
+}
 
-    const auto renderer      = GEngine->get_renderer();
+void ObjectLoader::upload_geometry(MeshInstance3D& mesh) {
+    compute_bounds(mesh.geometry->vertices, mesh.bounds_center, mesh.bounds_radius);
+    upload_buffers(mesh, mesh.geometry->vertices, mesh.geometry->indices);
+}
 
-    mesh.vertex_buffer = renderer->allocate_gpu_buffer(GpuBufferType::VERTEX);
-    mesh.vertex_buffer->upload(vertices.data(), vertices.size() * sizeof(Vertex));
+void ObjectLoader::compute_bounds(std::span<const Vertex> vertices, glm::vec3& center, float& radius) {
+    glm::vec3 min_bounds(std::numeric_limits<float>::max());
+    glm::vec3 max_bounds(std::numeric_limits<float>::lowest());
+    for (const auto& vertex : vertices) {
+        min_bounds = glm::min(min_bounds, vertex.position);
+        max_bounds = glm::max(max_bounds, vertex.position);
+    }
 
-    mesh.index_buffer = renderer->allocate_gpu_buffer(GpuBufferType::INDEX);
-    mesh.index_buffer->upload(indices.data(), indices.size() * sizeof(unsigned int));
+    center = vertices.empty() ? glm::vec3(0.0f) : (min_bounds + max_bounds) * 0.5f;
+
+    float radius_sq = 0.0f;
+    for (const auto& vertex : vertices) {
+        const glm::vec3 offset = vertex.position - center;
+        radius_sq              = std::max(radius_sq, glm::dot(offset, offset));
+    }
+    radius = std::sqrt(radius_sq);
+}
+
+void ObjectLoader::upload_buffers(MeshInstance3D& mesh, std::span<const Vertex> vertices, std::span<const unsigned int> indices) {
+    mesh.index_count = static_cast<int>(indices.size());
+
+    const auto renderer = GEngine->get_renderer();
 
     std::vector<VertexAttribute> attributes = {
         {0, 3, DataType::FLOAT, false, offsetof(Vertex, position)},
@@ -150,26 +324,176 @@ MeshInstance3D ObjectLoader::create_mesh(aiMesh* aiMesh) {
         {2, 2, DataType::FLOAT, false, offsetof(Vertex, uv)}
     };
 
-    mesh.vertex_layout = renderer->create_vertex_layout(
-        mesh.vertex_buffer.get(),
-        mesh.index_buffer.get(),
-        attributes,
-        sizeof(Vertex)
-    );
+    // Buffers and layouts are GPU objects, they must be created where the context is current
+    GEngine->run_on_render_thread([&] {
+        mesh.vertex_buffer = renderer->allocate_gpu_buffer(GpuBufferType::VERTEX);
+        mesh.vertex_buffer->upload(vertices.data(), vertices.size_bytes());
+
+        mesh.index_buffer = renderer->allocate_gpu_buffer(GpuBufferType::INDEX);
+        mesh.index_buffer->upload(indices.data(), indices.size_bytes());
+
+        mesh.vertex_layout = renderer->create_vertex_layout(
+            mesh.vertex_buffer.get(),
+            mesh.index_buffer.get(),
+            attributes,
+            sizeof(Vertex)
+        );
+    });
+}
+
+std::vector<char> ObjectLoader::cook(const aiScene* scene, std::span<const CookedDependency> dependencies) {
+    CookedModel cooked;
+    cooked.dependencies.assign(dependencies.begin(), dependencies.end());
+
+    // Storage the cooked views point into until the model is written
+    std::vector<MeshGeometry> geometries(scene->mNumMeshes);
+    std::deque<std::string> texture_paths;
+
+    std::unordered_map<unsigned int, Uint32> material_indices; // Assimp material -> cooked material
+    std::unordered_map<std::string, Sint32> texture_indices;   // Texture reference -> cooked texture
+
+    auto cook_texture = [&](const aiMaterial* aiMat, aiTextureType type) -> Sint32 {
+        aiString texPath;
+        if (aiMat->GetTextureCount(type) == 0 || aiMat->GetTexture(type, 0, &texPath) != AI_SUCCESS || texPath.length == 0) {
+            return -1;
+        }
+
+        const std::string texStr = texPath.C_Str();
+
+        if (const auto it = texture_indices.find(texStr); it != texture_indices.end()) {
+            return it->second;
+        }
+
+        CookedTexture texture;
+
+        if (texStr[0] == '*') {
+            const int texIndex = std::atoi(texStr.c_str() + 1);
+            if (texIndex < 0 || texIndex >= static_cast<int>(scene->mNumTextures) || !scene->mTextures[texIndex]) {
+                return -1;
+            }
+
+            const aiTexture* embedded = scene->mTextures[texIndex];
+            const auto* data          = reinterpret_cast<const unsigned char*>(embedded->pcData);
+
+            if (embedded->mHeight == 0) {
+                texture.kind = CookedTextureKind::ENCODED;
+                texture.data = {data, embedded->mWidth};
+            } else {
+                texture.kind   = CookedTextureKind::RAW;
+                texture.width  = embedded->mWidth;
+                texture.height = embedded->mHeight;
+                texture.data   = {data, static_cast<size_t>(embedded->mWidth) * embedded->mHeight * sizeof(aiTexel)};
+            }
+        } else {
+            const auto& stored = texture_paths.emplace_back(texStr);
+            texture.kind       = CookedTextureKind::FILE;
+            texture.data       = {reinterpret_cast<const unsigned char*>(stored.data()), stored.size()};
+        }
+
+        cooked.textures.push_back(texture);
+        return texture_indices[texStr] = static_cast<Sint32>(cooked.textures.size() - 1);
+    };
+
+    auto cook_material = [&](unsigned int index) -> Uint32 {
+        if (const auto it = material_indices.find(index); it != material_indices.end()) {
+            return it->second;
+        }
+
+        CookedMaterial material;
+        material.textures.fill(-1);
+
+        if (index < scene->mNumMaterials) {
+            aiMaterial* aiMat = scene->mMaterials[index];
+            load_colors(aiMat, material.material);
+
+            for (size_t slot = 0; slot < MATERIAL_MAP_SLOTS.size(); ++slot) {
+                material.textures[slot] = cook_texture(aiMat, MATERIAL_MAP_SLOTS[slot].type);
+            }
+        }
+
+        cooked.materials.push_back(material);
+        return material_indices[index] = static_cast<Uint32>(cooked.materials.size() - 1);
+    };
+
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh* aiMesh = scene->mMeshes[i];
+        spdlog::info("  Parsing Mesh({}) - Name {}", i, aiMesh->mName.C_Str());
+
+        geometries[i] = create_geometry(aiMesh);
+
+        CookedMesh mesh;
+        mesh.name     = {aiMesh->mName.data, aiMesh->mName.length};
+        mesh.vertices = geometries[i].vertices;
+        mesh.indices  = geometries[i].indices;
+        mesh.material = cook_material(aiMesh->mMaterialIndex);
+        compute_bounds(mesh.vertices, mesh.bounds_center, mesh.bounds_radius);
 
-    spdlog::info("  Mesh created: {} vertices, {} triangles", aiMesh->mNumVertices, indices.size() / 3);
-    return mesh;
+        cooked.meshes.push_back(mesh);
+    }
+
+    return MeshCache::write(cooked);
 }
 
-Material ObjectLoader::load_material(const aiScene* scene, aiMesh* mesh, const std::string& directory, Renderer& renderer) {
-    Material material;
-    if (scene->mNumMaterials <= mesh->mMaterialIndex)
-        return material;
+Model ObjectLoader::upload_model(const ImportedModel& imported) {
+    const auto& cooked = imported.cooked;
+
+    Model model;
+    model.path = imported.path;
+
+    const auto renderer = GEngine->get_renderer();
+
+    if (!renderer) {
+        spdlog::error("Renderer not initialized, cannot load model.");
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<Uint32> textures(imported.textures.size(), 0);
+
+    for (size_t i = 0; i < imported.textures.size(); ++i) {
+        textures[i] = renderer->create_texture(imported.textures[i]);
+    }
+
+    std::vector<Material> materials;
+    materials.reserve(cooked.materials.size());
+
+    for (const auto& cooked_material : cooked.materials) {
+        Material material = cooked_material.material;
+
+        for (size_t slot = 0; slot < MATERIAL_MAP_SLOTS.size(); ++slot) {
+            const Sint32 texture = cooked_material.textures[slot];
+
+            if (texture >= 0 && textures[texture] != 0) {
+                material.*MATERIAL_MAP_SLOTS[slot].map     = textures[texture];
+                material.*MATERIAL_MAP_SLOTS[slot].use_map = true;
+            }
+        }
+
+        materials.push_back(material);
+    }
+
+    for (const auto& cooked_mesh : cooked.meshes) {
+        MeshInstance3D mesh;
+        mesh.name          = std::string(cooked_mesh.name);
+        mesh.bounds_center = cooked_mesh.bounds_center;
+        mesh.bounds_radius = cooked_mesh.bounds_radius;
+
+        // Uploaded from the cooked buffer (the mapped cache on a hit), the CPU copy is kept for static merging
+        upload_buffers(mesh, cooked_mesh.vertices, cooked_mesh.indices);
+        mesh.geometry = std::make_shared<const MeshGeometry>(MeshGeometry{
+            {cooked_mesh.vertices.begin(), cooked_mesh.vertices.end()},
+            {cooked_mesh.indices.begin(), cooked_mesh.indices.end()}
+        });
+
+        const Material& material = materials[cooked_mesh.material];
+        spdlog::info("  Mesh created: {} - {} vertices, {} triangles | Albedo ({:.2f},{:.2f},{:.2f}) | Metallic {:.2f} | Roughness {:.2f}",
+                     mesh.name, cooked_mesh.vertices.size(), mesh.index_count / 3, material.albedo.r, material.albedo.g, material.albedo.b,
+                     material.metallic, material.roughness);
+
+        model.meshes.push_back(std::move(mesh));
+        model.materials.push_back(material);
+    }
 
-    aiMaterial* aiMat = scene->mMaterials[mesh->mMaterialIndex];
-    load_colors(aiMat, material);
-    load_textures(aiMat, scene, directory, renderer, material);
-    return material;
+    return model;
 }
 
 void ObjectLoader::load_colors(aiMaterial* aiMat, Material& mat) {
@@ -186,57 +510,6 @@ void ObjectLoader::load_colors(aiMaterial* aiMat, Material& mat) {
     aiMat->Get(AI_MATKEY_ROUGHNESS_FACTOR, mat.roughness);
 }
 
-void ObjectLoader::load_textures(aiMaterial* aiMat, const aiScene* scene, const std::string& dir, Renderer& renderer, Material& mat) {
-    auto load_tex = [&](aiTextureType type, GLuint& id, bool& flag, const char* name) {
-        if (aiMat->GetTextureCount(type) == 0)
-            return;
-
-        aiString texPath;
-        aiMat->GetTexture(type, 0, &texPath);
-        std::string texStr = texPath.C_Str();
-
-        if (texStr.empty())
-            return;
-
-        if (texStr[0] == '*') {
-            int texIndex = std::atoi(texStr.c_str() + 1);
-            if (texIndex >= 0 && texIndex < (int) scene->mNumTextures) {
-                const aiTexture* embedded = scene->mTextures[texIndex];
-                if (!embedded)
-                    return;
-
-                if (embedded->mHeight == 0) {
-                    id = renderer.load_texture_from_memory(
-                        reinterpret_cast<const unsigned char*>(embedded->pcData),
-                        embedded->mWidth);
-                } else {
-                    id = renderer.load_texture_from_raw_data(
-                        reinterpret_cast<const unsigned char*>(embedded->pcData),
-                        embedded->mWidth, embedded->mHeight);
-                }
-
-                flag = (id != 0);
-                if (flag)
-                    spdlog::info("    Embedded Texture loaded: {}", name);
-                return;
-            }
-        }
-
-        std::string tex_dir = dir + texStr;
-        id                  = renderer.load_texture_from_file(tex_dir);
-        flag                = (id != 0);
-        if (flag)
-            spdlog::info("    Texture loaded [{}]: {}", name, tex_dir);
-    };
-
-    load_tex(aiTextureType_DIFFUSE, mat.albedo_map, mat.use_albedo_map, "albedo");
-    load_tex(aiTextureType_NORMALS, mat.normal_map, mat.use_normal_map, "normal");
-    load_tex(aiTextureType_METALNESS, mat.metallic_map, mat.use_metallic_map, "metallic");
-    load_tex(aiTextureType_DIFFUSE_ROUGHNESS, mat.roughness_map, mat.use_roughness_map, "roughness");
-    load_tex(aiTextureType_AMBIENT_OCCLUSION, mat.ao_map, mat.use_ao_map, "ao");
-    load_tex(aiTextureType_EMISSIVE, mat.emissive_map, mat.use_emissive_map, "emissive");
-}
-
 void ObjectLoader::parse_bones(aiMesh* mesh, Model& model) {
     spdlog::info("    Bones: {}", mesh->mNumBones);
     for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
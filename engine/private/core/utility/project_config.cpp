@@ -45,6 +45,20 @@ bool Viewport::load(const tinyxml2::XMLElement* root) {
 
     viewport_element->QueryFloatAttribute("scale", &scale);
 
+    if (const auto scale_element = viewport_element->FirstChildElement("scale")) {
+        scale_element->QueryFloatText(&scale);
+    }
+
+    if (const auto dynamic_element = viewport_element->FirstChildElement("dynamic_resolution")) {
+        dynamic_element->QueryBoolAttribute("enabled", &dynamic_resolution);
+        dynamic_element->QueryFloatAttribute("min_scale", &min_scale);
+        dynamic_element->QueryFloatAttribute("sharpness", &sharpness);
+    }
+
+    scale     = std::clamp(scale, 0.1f, 1.0f);
+    min_scale = std::clamp(min_scale, 0.1f, scale);
+    sharpness = std::clamp(sharpness, 0.0f, 1.0f);
+
     return true;
 }
 
@@ -145,6 +159,17 @@ bool Application::load(const tinyxml2::XMLElement* root) {
         spdlog::warn("Failed to load Application Config - resizable element is null");
     }
 
+    if (const auto background_fps_element = app_element->FirstChildElement("background_fps")) {
+        background_fps_element->QueryIntText(&background_fps);
+        background_fps = std::max(background_fps, 1);
+    }
+
+    if (const auto on_demand_element = app_element->FirstChildElement("on_demand")) {
+        on_demand_element->QueryBoolText(&is_on_demand);
+    }
+
+    max_fps = std::max(max_fps, 0);
+
     return true;
 }
 
@@ -186,6 +211,26 @@ bool Performance::load(const tinyxml2::XMLElement* root) {
         return false;
     }
 
+    if (const auto affinity_element = performance_element->FirstChildElement("thread_affinity")) {
+        affinity_element->QueryBoolText(&is_thread_affinity);
+    }
+
+    if (const auto io_threads_element = performance_element->FirstChildElement("io_threads")) {
+        io_threads_element->QueryIntText(&io_threads);
+    }
+
+    if (const auto io_uring_element = performance_element->FirstChildElement("io_uring")) {
+        io_uring_element->QueryBoolText(&is_io_uring);
+    }
+
+    if (const auto script_gc_element = performance_element->FirstChildElement("script_gc_ms")) {
+        script_gc_element->QueryFloatText(&script_gc_ms);
+    }
+
+    if (const auto generational_element = performance_element->FirstChildElement("script_gc_generational")) {
+        generational_element->QueryBoolText(&is_script_gc_generational);
+    }
+
     if (const auto physics_fps_element = performance_element->FirstChildElement("physics_fps")) {
         physics_fps_element->QueryIntText(&physics_fps);
     } else {
@@ -199,6 +244,71 @@ bool Performance::load(const tinyxml2::XMLElement* root) {
 // -----------------------------------------------------------------------------
 // RendererDevice
 // -----------------------------------------------------------------------------
+bool Resources::load(const tinyxml2::XMLElement* root) {
+    const auto resources_element = root->FirstChildElement("resources");
+
+    // Optional, without it everything is read from the loose res folder
+    if (!resources_element) {
+        return true;
+    }
+
+    for (auto element = resources_element->FirstChildElement(); element; element = element->NextSiblingElement()) {
+        const char* path = element->GetText();
+
+        if (!path) {
+            spdlog::error("Failed to load Resources Config - {} element has no path", element->Name());
+            return false;
+        }
+
+        if (strcmp(element->Name(), "pack") == 0) {
+            mounts.push_back({true, path});
+        } else if (strcmp(element->Name(), "directory") == 0) {
+            mounts.push_back({false, path});
+        } else {
+            spdlog::error("Unknown resources mount type: {}", element->Name());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool AudioDevice::load(const tinyxml2::XMLElement* root) {
+    const auto audio_element = root->FirstChildElement("audio");
+
+    // Optional, defaults to the system device
+    if (!audio_element) {
+        return true;
+    }
+
+    if (const auto enabled_element = audio_element->FirstChildElement("enabled")) {
+        enabled_element->QueryBoolText(&is_enabled);
+    }
+
+    if (const auto null_device_element = audio_element->FirstChildElement("null_device")) {
+        null_device_element->QueryBoolText(&is_null_device);
+    }
+
+    if (const auto offline_element = audio_element->FirstChildElement("offline")) {
+        offline_element->QueryBoolText(&is_offline);
+    }
+
+    if (const auto max_voices_element = audio_element->FirstChildElement("max_voices")) {
+        max_voices_element->QueryIntText(&max_voices);
+    }
+
+    if (const auto sample_rate_element = audio_element->FirstChildElement("sample_rate")) {
+        sample_rate_element->QueryIntText(&sample_rate);
+    }
+
+    if (max_voices <= 0) {
+        spdlog::error("Failed to load Audio Config - max_voices must be positive");
+        return false;
+    }
+
+    return true;
+}
+
 bool RendererDevice::load(const tinyxml2::XMLElement* root) {
 
     const auto renderer_element = root->FirstChildElement("renderer");
@@ -239,6 +349,11 @@ bool RendererDevice::load(const tinyxml2::XMLElement* root) {
         return false;
     }
 
+    if (const auto budget_element = renderer_element->FirstChildElement("texture_budget_mb")) {
+        budget_element->QueryIntText(&texture_budget_mb);
+        texture_budget_mb = std::max(texture_budget_mb, 0);
+    }
+
     return true;
 }
 
@@ -331,6 +446,16 @@ bool EngineConfig::load() {
         return false;
     }
 
+    if (!_resources.load(config)) {
+        spdlog::error("Failed to load Resources Config");
+        return false;
+    }
+
+    if (!_audio_device.load(config)) {
+        spdlog::error("Failed to load Audio Config");
+        return false;
+    }
+
     return true;
 }
 
@@ -345,6 +470,14 @@ Performance& EngineConfig::get_performance() {
     return _performance;
 }
 
+Resources& EngineConfig::get_resources() {
+    return _resources;
+}
+
+AudioDevice& EngineConfig::get_audio_device() {
+    return _audio_device;
+}
+
 Application& EngineConfig::get_application() {
     return _app;
 }
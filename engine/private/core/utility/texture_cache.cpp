@@ -0,0 +1,59 @@
+#include "core/utility/texture_cache.h"
+
+namespace {
+
+constexpr Uint32 GTEX_MAGIC = 0x58455447; // "GTEX"
+
+struct GTexHeader {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 width;
+    Uint32 height;
+    Uint32 channels;
+    Uint32 reserved[3];
+};
+
+static_assert(sizeof(GTexHeader) == 32, "gtex header must keep its on-disk size");
+
+} // namespace
+
+std::string TextureCache::get_cooked_path(const std::string& source_path) {
+    return source_path + ".gtex";
+}
+
+std::vector<char> TextureCache::write(const unsigned char* pixels, Uint32 width, Uint32 height, Uint32 channels) {
+    const GTexHeader header{GTEX_MAGIC, VERSION, width, height, channels, {}};
+    const size_t size = static_cast<size_t>(width) * height * channels;
+
+    std::vector<char> out(sizeof(header) + size);
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), pixels, size);
+
+    return out;
+}
+
+bool TextureCache::read(std::span<const std::byte> bytes, CookedImage& out) {
+    if (bytes.size() < sizeof(GTexHeader)) {
+        return false;
+    }
+
+    GTexHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (header.magic != GTEX_MAGIC || header.version != VERSION || header.channels == 0 || header.channels > 4) {
+        return false;
+    }
+
+    const Uint64 size = static_cast<Uint64>(header.width) * header.height * header.channels;
+
+    if (size == 0 || size != bytes.size() - sizeof(header)) {
+        return false;
+    }
+
+    out.width    = header.width;
+    out.height   = header.height;
+    out.channels = header.channels;
+    out.pixels   = {reinterpret_cast<const unsigned char*>(bytes.data() + sizeof(header)), static_cast<size_t>(size)};
+
+    return true;
+}
@@ -10,7 +10,11 @@ void create_camera_entity(
     float near_plane          = 0.1f,
     float far_plane           = 1000.0f);
 
-void create_mesh_entity(
+/*!
+    @brief Spawn a drawable entity, add `Static` to the returned entity when it never moves
+    @return The entity, null when the material isn't registered
+*/
+flecs::entity create_mesh_entity(
     const char* name,
     const char* path,
     const glm::vec3& position = glm::vec3(0),
@@ -18,6 +22,23 @@ void create_mesh_entity(
     const glm::vec3& scale    = glm::vec3(1.0f),
     const char* material_tag   = "default_material");
 
+/*!
+    @brief Spawn one drawable per transform, all sharing a mesh and a material
+
+    Every entity is inserted in the same table in one `ecs_bulk_init` call, the mesh and material are resolved once.
+
+    @param is_static Add the `Static` tag (merged into static chunks)
+    @param name_prefix Name entities `<prefix>_<index>`, anonymous when null (each name is a registry insert).
+           Use a prefix per call, entities whose name is already taken stay anonymous
+    @return The created entities, empty when the material isn't registered
+*/
+std::vector<flecs::entity_t> create_mesh_entities(
+    const char* path,
+    std::span<const Transform3D> transforms,
+    const char* material_tag = "default_material",
+    bool is_static           = false,
+    const char* name_prefix  = nullptr);
+
 void create_model_entity(
     const char* name,
     const char* path,
@@ -25,5 +46,46 @@ void create_model_entity(
     const glm::vec3& rotation = glm::vec3(0),
     const glm::vec3& scale    = glm::vec3(1.0f));
 
+/*!
+    @brief Models loading in the background, returned by `load_models_async`
+    @ingroup Engine
+    @version 0.0.5
+*/
+class ModelLoadBatch {
+public:
+    explicit ModelLoadBatch(std::vector<std::string> paths);
+
+    /*!
+        @brief Every model is uploaded (or failed), `create_model_entity` uses them without loading again
+    */
+    [[nodiscard]] bool is_done() const;
+
+    /*!
+        @brief Block until `is_done`, the main thread runs import and upload jobs meanwhile
+        @note Main thread only, uploads are main thread jobs
+    */
+    void wait();
+
+    [[nodiscard]] const std::vector<std::string>& get_paths() const;
+
+    /*!
+        @brief Whether `get_paths()[index]` loaded successfully, valid once `is_done`
+    */
+    [[nodiscard]] bool is_loaded(size_t index) const;
+
+private:
+    friend std::shared_ptr<ModelLoadBatch> load_models_async(const std::vector<std::string>& paths);
+
+    std::vector<std::string> _paths;
+    std::unique_ptr<std::atomic<bool>[]> _loaded;
+    JobCounter _counter;
+};
+
+/*!
+    @brief Load several models at once, each imported on a worker (cache lookup or Assimp, texture decoding)
+    then uploaded on the main thread during `run_main_thread_jobs`. Loading N models takes roughly the time of the slowest.
+    @return The batch to poll or wait on, models already loaded complete immediately
+*/
+std::shared_ptr<ModelLoadBatch> load_models_async(const std::vector<std::string>& paths);
 
 void create_material(const char* name, const Material& material);
\ No newline at end of file
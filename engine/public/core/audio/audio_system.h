@@ -0,0 +1,172 @@
+#pragma once
+#include "stdafx.h"
+#include "core/component/components.h"
+#include "core/io/ma_io.h"
+#include "core/utility/project_config.h"
+
+/*!
+    @brief Mixer state after the last `AudioSystem::update`
+    @ingroup Audio
+    @version 0.0.5
+*/
+struct AudioStats {
+    int sources         = 0; ///< Playing sources, mixed or not
+    int voices          = 0; ///< Sources currently mixed
+    int virtual_sources = 0; ///< Playing sources without a voice, their position still advances
+    int stolen          = 0; ///< Voices taken from a less important source
+    int samples         = 0; ///< Decoded sounds kept in memory
+};
+
+/*!
+    @brief Mixer timings since the last `AudioSystem::reset_mixer_stats`, measured around every device callback or `render` period
+    @ingroup Audio
+    @version 0.0.5
+*/
+struct MixerStats {
+    Uint64 callbacks  = 0;
+    Uint64 frames     = 0;
+    Uint64 underruns  = 0;   ///< Periods that took longer to mix than to play, a device would have glitched
+    double average_ms = 0.0; ///< Mixer CPU time per callback
+    double max_ms     = 0.0;
+};
+
+/*!
+
+   @brief Audio engine driving `AudioSource`/`AudioListener` components
+
+   - miniaudio engine on the system device, its null backend for headless runs, or no device at all: `render` then mixes
+     on the calling thread as fast as it can (deterministic benchmarks, offline bounces)
+   - Files go through `MiniAudio_VFS`, `res://` sounds can come from a mounted pack
+   - Non-streamed sounds are decoded once into a shared sample, voices playing it only hold a cursor
+   - Streamed sources are decoded in chunks by the resource manager thread
+   - At most `max_voices` sources are mixed, ordered by priority then audible volume. A source losing its voice keeps its cursor
+     and resumes where it would be, so hundreds of emitters cost the mixer thread no more than `max_voices`
+
+   @ingroup Audio
+   @version 0.0.5
+*/
+class AudioSystem {
+public:
+    AudioSystem() = default;
+
+    ~AudioSystem();
+
+    AudioSystem(const AudioSystem&) = delete;
+
+    AudioSystem& operator=(const AudioSystem&) = delete;
+
+    bool initialize(const AudioDevice& settings);
+
+    void shutdown();
+
+    [[nodiscard]] bool is_initialized() const;
+
+    /*!
+        @brief Register the observer releasing the voice of removed sources
+    */
+    void setup(flecs::world& world);
+
+    /*!
+        @brief Place the listener, assign voices and update the mixed sources, once per frame after the simulation
+    */
+    void update(float delta);
+
+    /*!
+        @brief Decode a sound ahead of time (level load) so the first play doesn't stall the frame
+    */
+    bool preload(const std::string& path);
+
+    /*!
+        @brief Drop a decoded sample, voices still playing it keep it alive until they stop
+    */
+    void unload(const std::string& path);
+
+    /*!
+        @brief Mix `seconds` of output and append it to `out` (interleaved float), offline device only
+        @param period_frames Frames per mix, the size of the callback a device would ask for
+        @return Frames rendered
+    */
+    Uint64 render(float seconds, std::vector<float>& out, Uint32 period_frames = 480);
+
+    [[nodiscard]] const AudioStats& get_stats() const;
+
+    [[nodiscard]] MixerStats get_mixer_stats() const;
+
+    void reset_mixer_stats();
+
+    [[nodiscard]] ma_engine* get_engine();
+
+private:
+    /// Decoded sound shared by every voice playing it (`ma_sound_init_copy`)
+    struct Sample {
+        ma_sound prototype{};
+    };
+
+    struct Voice {
+        ma_sound sound{};
+        Uint64 entity       = 0;
+        bool is_initialized = false;
+    };
+
+    struct SourceState {
+        int voice      = -1;
+        float cursor   = 0.0f;  ///< Seconds, kept up to date while virtual
+        float length   = -1.0f; ///< Seconds, unknown until the sound was first opened
+        bool is_active = false;
+    };
+
+    struct Candidate {
+        Uint64 entity;
+        AudioSource* source;
+        SourceState* state;
+        glm::vec3 position;
+        float gain;
+    };
+
+    AudioDevice _settings;
+    MiniAudio_VFS _vfs{};
+
+    ma_context _context{};
+    ma_device _device{}; ///< Owned here so every callback can be timed
+    ma_engine _engine{};
+    bool _has_context    = false;
+    bool _has_device     = false;
+    bool _is_initialized = false;
+
+    std::unordered_map<std::string, std::unique_ptr<Sample>> _samples;
+    std::unordered_map<Uint64, SourceState> _sources;
+
+    std::unique_ptr<Voice[]> _voices; ///< `ma_sound` can't move once initialized
+    std::vector<int> _free_voices;
+
+    std::vector<Candidate> _candidates; ///< Reused every update
+
+    std::optional<flecs::query<AudioSource, const Transform3D*>> _source_query;
+    std::optional<flecs::query<const AudioListener, const Transform3D, const Camera3D*>> _listener_query;
+
+    AudioStats _stats;
+
+    // Written by the audio thread, or the `render` caller
+    std::atomic<Uint64> _mix_callbacks{0};
+    std::atomic<Uint64> _mix_frames{0};
+    std::atomic<Uint64> _mix_underruns{0};
+    std::atomic<Uint64> _mix_time_ns{0};
+    std::atomic<Uint64> _mix_max_ns{0};
+
+    static void device_callback(ma_device* device, void* output, const void* input, ma_uint32 frame_count);
+
+    void mix(float* output, Uint32 frame_count);
+
+    Sample* get_sample(const std::string& path);
+
+    bool start_voice(Uint64 entity, const AudioSource& source, SourceState& state);
+
+    void release_voice(SourceState& state);
+
+    static void apply(ma_sound& sound, const AudioSource& source, const glm::vec3& position);
+
+    /*!
+        @brief Same curve as miniaudio's inverse distance model, used to rank sources without a voice
+    */
+    static float compute_attenuation(const AudioSource& source, float distance);
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "stdafx.h"
+#include "core/component/components.h"
+
+/*!
+    @brief Write made by a parallel script outside its own entity, applied on the main thread after the batch
+    @ingroup Scripting
+    @version 0.0.5
+*/
+struct ScriptCommand {
+    enum class Type {
+        SET_POSITION,
+        SET_ROTATION,
+        SET_SCALE,
+        DESTRUCT
+    };
+
+    Type type;
+    flecs::entity_t entity;
+    glm::vec3 value{0.0f};
+};
+
+/*!
+    @brief State shared by the `ecs` functions of one Lua state, the script system points it at the world (or stage) before running scripts
+    @ingroup Scripting
+    @version 0.0.5
+*/
+struct LuaBindingContext {
+    flecs::world_t* world = nullptr;
+
+    flecs::entity_t self                 = 0;       ///< Entity running the current parallel script
+    std::vector<ScriptCommand>* commands = nullptr; ///< Parallel scripts only, writes to other entities and deletes are queued here
+
+    const ecs_query_t* transform_query = nullptr; ///< Every non-static `Transform3D` (read-only term), iterated by `ecs.each_transform`
+    Uint64 view_epoch                  = 0;       ///< Bumped after each view callback, views of an older epoch are stale
+    Uint64 written_epoch               = 0;       ///< Epoch of the last view whose table was marked changed
+    bool is_iterating                  = false;
+};
+
+/*!
+
+   @brief Register the engine types and functions in a Lua state
+
+   - `vec3` and `Transform3D` usertypes, for scripts building values
+   - With a context, the `ecs` table: entities are light userdata (the flecs id), components are read and written in place through
+     plain functions returning numbers, `ecs.get_position(e)` / `ecs.set_position(e, x, y, z)`, so per-entity calls allocate nothing
+   - When the context has a command queue (worker states), only `self` is written in place
+   - With a transform query, bulk views: `ecs.each_transform(fn)` calls `fn(view)` once per table, the view and its `position`,
+     `rotation` and `scale` columns point into the table storage (`col:get(i)` / `col:set(i, x, y, z)`, `view:entity(i)`, `#view`).
+     Structural changes are deferred while `fn` runs and a view used after its callback raises an error, storage can't move under it.
+     Only a `set` marks its table changed, static entities aren't visited.
+     Not available to parallel scripts, a view writes entities other workers may be running
+
+   @param context Must outlive the state, nullptr registers the types only
+
+   @ingroup Scripting
+   @version 0.0.5
+*/
+void generate_bindings(lua_State* L, LuaBindingContext* context = nullptr);
+
+/*!
+    @brief Entity handle passed to scripts
+*/
+inline void push_entity(lua_State* L, flecs::entity_t entity) {
+    lua_pushlightuserdata(L, reinterpret_cast<void*>(static_cast<uintptr_t>(entity)));
+}
@@ -1,6 +1,11 @@
 #pragma once
 #include "stdafx.h"
 #include "core/renderer/base_struct.h"
+#include "core/utility/handle_pool.h"
+
+using MeshHandle     = Handle<struct MeshTag>;
+using MaterialHandle = Handle<struct MaterialTag>;
+using TextureHandle  = Handle<struct TextureTag>;
 
 
 /*!
@@ -13,6 +18,22 @@ struct Transform3D {
     glm::vec3 scale{1.0f};
 
     glm::mat4 get_matrix() const;
+
+    /*!
+        @brief Interpolate between two transforms, rotations take the shortest angle per axis
+    */
+    static Transform3D lerp(const Transform3D& from, const Transform3D& to, float alpha);
+};
+
+/*!
+ * @brief Transform at the start of the last fixed simulation step, used to interpolate rendering.
+ * - Added automatically with `Transform3D`
+ * - `is_valid` is false until the entity went through a fixed step (render the current transform)
+ * @ingroup Components
+ */
+struct PreviousTransform3D {
+    Transform3D value;
+    bool is_valid = false;
 };
 
 /*!
@@ -26,6 +47,20 @@ struct PhysicsBody {
 };
 
 
+/*!
+ * @brief CPU copy of a mesh, kept after upload to bake static geometry.
+ * @ingroup Components
+ */
+struct MeshGeometry {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+/*!
+ * @brief Mesh as produced by the loaders, stored as the cold half of the renderer mesh pool.
+ * - Owns the GPU objects, `MeshDrawData` only points at them
+ * @ingroup Components
+ */
 struct MeshInstance3D {
     std::string name;
 
@@ -33,7 +68,24 @@ struct MeshInstance3D {
     std::shared_ptr<GpuBuffer> index_buffer;
     std::shared_ptr<GpuVertexLayout> vertex_layout;
 
+    std::shared_ptr<const MeshGeometry> geometry; /// Shared by every copy of the mesh, null for GPU only meshes
+
     int index_count = 0;
+
+    glm::vec3 bounds_center{0.0f}; /// Bounding sphere center (model space)
+    float bounds_radius = 1.0f; /// Bounding sphere radius around `bounds_center`
+};
+
+/*!
+ * @brief Hot half of a pooled mesh: everything a draw reads, packed with the other meshes.
+ * @ingroup Components
+ */
+struct MeshDrawData {
+    const GpuVertexLayout* vertex_layout = nullptr; /// Owned by the cold `MeshInstance3D`
+    int index_count = 0;
+
+    glm::vec3 bounds_center{0.0f};
+    float bounds_radius = 1.0f;
 };
 
 class Shader;
@@ -145,10 +197,89 @@ struct Model {
     std::vector<Material> materials;
 };
 
+/*!
+ * @brief Mesh drawn by the entity, resolved through `Renderer::_meshes` (a stale handle draws nothing).
+ * @ingroup Components
+ */
 struct MeshRef {
-    const MeshInstance3D* mesh;
+    MeshHandle mesh;
 };
 
+/*!
+ * @brief Material of the entity, resolved through `Renderer::_materials`.
+ * @ingroup Components
+ */
 struct MaterialRef {
-    const Material* material;
+    MaterialHandle material;
+};
+
+/*!
+ * @brief Tag for drawables that never move after spawn.
+ * - Merged per material into spatial chunks by `StaticGeometry`, drawn and culled per chunk instead of per entity
+ * - Adding/removing the tag, or setting a component of a static drawable, re-bakes the affected chunks
+ * @ingroup Components
+ */
+struct Static {};
+
+/*!
+ * @brief Sound played at the entity's `Transform3D`, mixed by the `AudioSystem`.
+ * - Short sounds are decoded once and shared by every source playing them, `is_streamed` ones (music, ambiences) are read in chunks
+ * - Only the most important sources get a voice, the others keep their playback position and resume when one frees up
+ * - `is_playing` goes back to false when a non-looping sound ends, set it again to restart from the beginning
+ * @ingroup Components
+ */
+struct AudioSource {
+    std::string path; // res:// path, read when playback starts
+
+    float volume       = 1.0f;
+    float pitch        = 1.0f;
+    float min_distance = 1.0f;   // Full volume inside this radius
+    float max_distance = 100.0f; // No more attenuation past this distance
+
+    int priority = 0; // Higher priorities steal voices from lower ones, ties go to the loudest
+
+    bool is_looping  = false;
+    bool is_streamed = false;
+    bool is_spatial  = true; // false: not attenuated nor panned (music, UI), no transform needed
+    bool is_playing  = true;
+};
+
+/*!
+ * @brief Position and orientation of the mix, taken from the entity's `Transform3D` (and `Camera3D` when present).
+ * @note Only the first listener is used.
+ * @ingroup Components
+ */
+struct AudioListener {
+    float volume = 1.0f; // Master volume
+};
+
+/*!
+ * @brief Lua behaviour of an entity, run by the `ScriptSystem`.
+ * - The file is loaded once per path, its `ready(entity)` runs before the first `update(entity, dt)` of each entity
+ * - `entity` is a light userdata, components are accessed through the `ecs` table (`ecs.get_position(entity)`)
+ * - An entity whose script raised an error stops running it, the error is logged once
+ * @ingroup Components
+ */
+struct Script {
+    std::string path; // res:// Lua file
+
+    int prototype  = -1;    // Set by the ScriptSystem on the first update
+    bool is_ready  = false; // `ready` ran
+    bool is_failed = false;
+};
+
+/*!
+ * @brief Singleton with the input gathered by the core loop, read by input systems (OnLoad).
+ * - Mouse motion accumulates until a fixed step consumed it
+ * @ingroup Components
+ */
+struct InputState {
+    const bool* keys       = nullptr; // SDL_GetKeyboardState
+    bool is_mouse_captured = false;
+    float mouse_dx         = 0.0f;
+    float mouse_dy         = 0.0f;
+
+    [[nodiscard]] bool has_mouse_motion() const;
+
+    [[nodiscard]] bool has_camera_input() const;
 };
@@ -1,8 +1,17 @@
 #pragma once
 #include "core/renderer/opengl/ogl_renderer.h"
+#include "core/renderer/render_thread.h"
+#include "core/renderer/static_geometry.h"
+#include "core/renderer/asset_registry.h"
+#include "core/audio/audio_system.h"
+#include "core/script/script_system.h"
 #include "core/system/timer.h"
+#include "core/system/frame_limiter.h"
+#include "core/system/job_system.h"
 #include "core/utility/project_config.h"
 #include "core/utility/obj_loader.h"
+#include "core/io/vfs.h"
+#include "core/io/async_io.h"
 #include "core/api/engine_api.h"
 
 /*!
@@ -30,6 +39,74 @@ public:
 
     flecs::world& get_world();
 
+    FrameLimiter& get_frame_limiter();
+
+    /*!
+        @brief Worker pool shared by engine systems and gameplay code (sized by `<worker_threads>`)
+    */
+    JobSystem& get_job_system();
+
+    /*!
+        @brief Extraction target of the `RenderExtract` systems, handed to the renderer every frame
+    */
+    RenderSnapshot& get_frame_snapshot();
+
+    /*!
+        @brief Merged chunks of every `Static` drawable, pending changes are baked before each extraction
+    */
+    StaticGeometry& get_static_geometry();
+
+    /*!
+        @brief Reference counts and memory accounting of the loaded meshes, materials and textures
+    */
+    AssetRegistry& get_asset_registry();
+
+    /*!
+        @brief Mixer of the `AudioSource` components, muted when the device failed to open
+    */
+    AudioSystem& get_audio();
+
+    /*!
+        @brief Lua state and prototypes of the `Script` components, per-script timings in `get_stats`
+    */
+    ScriptSystem& get_scripts();
+
+    /*!
+        @brief Ask for a new frame in on-demand rendering mode (`<on_demand>` in project.xml)
+
+        @note Input events and component changes (transforms, lights, meshes, materials, cameras) already trigger a redraw.
+    */
+    void request_redraw();
+
+    /*!
+        @brief Pick the limiter rate: `max_fps`, unlimited when vsync already paces at that rate, `background_fps` when hidden
+    */
+    void update_frame_pacing(bool is_background);
+
+    /*!
+        @brief Whether a new frame must be rendered in on-demand mode, clears the pending state
+    */
+    bool consume_redraw();
+
+    /*!
+        @brief Run `command` where the graphics context is current and wait for it
+
+        Inline when rendering on the main thread (`<multithreaded>` disabled).
+        Every GPU resource creation must go through here.
+    */
+    void run_on_render_thread(const std::function<void()>& command);
+
+    /*!
+        @brief Hand the extracted frame to the renderer, drawn inline or by the render thread
+        @param snapshot Receives a recycled snapshot to extract the next frame into
+    */
+    void submit_frame(RenderSnapshot& snapshot);
+
+    /*!
+        @brief Stats of the last rendered frame, safe to call from the main thread
+    */
+    RenderStats get_render_stats() const;
+
     bool is_running = false;
 
     SDL_Event event;
@@ -40,10 +117,24 @@ public:
 private:
     EngineConfig _config = {};
     Timer _timer         = {};
+    RenderSnapshot _frame_snapshot; // Recycled, with a render thread its contents are swapped with the frame just drawn. Outlives `_world`, observers write to it
+    StaticGeometry _static_geometry; // Observers record static entities into it, outlives `_world` too
+    AudioSystem _audio; // Its observer releases voices while `_world` is destroyed, outlives it as well
     flecs::world _world;
     SDL_Window* _window = nullptr;
     Renderer* _renderer = nullptr;
 
+    FrameLimiter _frame_limiter = {};
+    AssetRegistry _asset_registry;
+    JobSystem _job_system;
+    bool _redraw_requested      = true;
+
+    std::unique_ptr<RenderThread> _render_thread = nullptr; // Only with `<multithreaded>`, owns the context while running
+
+    std::vector<flecs::query<>> _change_queries; // Change detection for on-demand rendering, after `_world` so they are destroyed first
+
+    ScriptSystem _scripts; // `RunScripts` points into it, destroyed before `_world` (which never runs systems on teardown)
+
 
 };
 
@@ -59,11 +150,30 @@ void engine_core_loop();
 
 void engine_draw_loop();
 
+/*!
+
+    @brief Run the `RenderExtract` systems into `Engine::get_frame_snapshot` (transforms interpolated with `Timer::alpha`)
+
+    @version 0.0.5
+*/
+void engine_extract_frame();
+
+/*!
+
+    @brief Record and present a snapshot, runs wherever the graphics context is current
+
+    @version 0.0.5
+*/
+void engine_render_frame(const RenderSnapshot& snapshot);
+
 /*!
 
     @brief Sets up the core systems in the provided Flecs world.
 
-    This function registers core systems required for the engine's operation
+    This function registers core systems required for the engine's operation:
+    - OnLoad: transform snapshots for interpolation, camera input
+    - OnUpdate: Lua scripts
+    - RenderExtract (after PreStore): render snapshot extraction, only run by `engine_extract_frame`
 
     @param world Reference to the Flecs world where systems will be registered.
 
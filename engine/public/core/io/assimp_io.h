@@ -7,16 +7,16 @@
 #include <string>
 #include <memory>
 
-class FileAccess;
+class MappedFile;
 
 /*!
- * @brief Custom Assimp IOStream implementation using SDL file access
- * @details Wraps FileAccess to provide Assimp with file reading capabilities
+ * @brief Read-only Assimp IOStream over a memory mapped file
+ * @details The file is mapped once when opened, `Read` copies from the mapping and `Seek`/`Tell`/`FileSize` are O(1)
  */
-class SDLIOStream : public Assimp::IOStream {
+class MappedIOStream : public Assimp::IOStream {
 public:
-    SDLIOStream(const std::string& path, const std::string& mode);
-    ~SDLIOStream() override;
+    explicit MappedIOStream(std::unique_ptr<MappedFile> file);
+    ~MappedIOStream() override;
 
     size_t Read(void* pvBuffer, size_t pSize, size_t pCount) override;
     size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) override;
@@ -25,26 +25,30 @@ public:
     size_t FileSize() const override;
     void Flush() override;
 
-    std::unique_ptr<FileAccess> m_file;
-    std::string m_path;
-    size_t m_position = 0;
+private:
+    std::unique_ptr<MappedFile> _file;
+    size_t _position = 0;
 };
 
 /*!
- * @brief Custom Assimp IOSystem implementation for asset loading
- * @details Allows Assimp to load models with external dependencies (like OBJ+MTL)
- *          through the engine's FileAccess system, supporting both desktop and Android
+ * @brief Assimp IOSystem opening files relative to a model directory through `MappedFile`
+ * @details Allows Assimp to load models with external dependencies (like OBJ+MTL or glTF+bin),
+ *          falls back to a single buffered read where mapping isn't available (Android assets)
  */
-class SDLIOSystem : public Assimp::IOSystem {
+class MappedIOSystem : public Assimp::IOSystem {
 public:
-    explicit SDLIOSystem(const std::string& base_path);
-    ~SDLIOSystem() override;
+    explicit MappedIOSystem(const std::string& base_path);
+    ~MappedIOSystem() override;
 
     bool Exists(const char* pFile) const override;
     char getOsSeparator() const override;
     Assimp::IOStream* Open(const char* pFile, const char* pMode = "rb") override;
     void Close(Assimp::IOStream* pFile) override;
 
+    /// Files opened so far, the external dependencies of the imported model
+    [[nodiscard]] const std::vector<std::string>& get_opened_files() const;
+
 private:
-    std::string m_base_path;
-};
\ No newline at end of file
+    std::string _base_path;
+    std::vector<std::string> _opened_files;
+};
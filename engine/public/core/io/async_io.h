@@ -0,0 +1,198 @@
+#pragma once
+#include "stdafx.h"
+
+/*!
+    @brief Order in which queued reads are started, streaming work should use `LOW`
+    @ingroup FileSystem
+    @version 0.0.5
+*/
+enum class IoPriority {
+    HIGH,
+    NORMAL,
+    LOW
+};
+
+enum class AsyncReadStatus {
+    PENDING,
+    DONE,     ///< `get_bytes_read` can be short of the requested size at the end of the file
+    FAILED,
+    CANCELLED
+};
+
+/*!
+
+   @brief One asynchronous read, shared between the caller and the I/O backend
+
+   - The destination buffer must stay valid until the read is no longer pending, even after `cancel`
+   - The callback runs on an I/O thread once the read is finished, keep it short (schedule a job for the decode)
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class AsyncRead {
+public:
+    using Callback = std::function<void(AsyncRead&)>;
+
+    [[nodiscard]] AsyncReadStatus get_status() const {
+        return _status.load(std::memory_order_acquire);
+    }
+
+    /*!
+        @brief Finished, failed or cancelled, and the callback returned
+    */
+    [[nodiscard]] bool is_done() const {
+        return _is_done.load(std::memory_order_acquire);
+    }
+
+    /*!
+        @brief Block until `is_done`
+    */
+    AsyncReadStatus wait() const;
+
+    /*!
+        @brief Drop the read if not started yet, otherwise ask the backend to abort it
+        @note A read that already completed stays `DONE`.
+    */
+    void cancel();
+
+    [[nodiscard]] size_t get_bytes_read() const {
+        return _bytes_read;
+    }
+
+    /*!
+        @brief The bytes read so far, in the caller buffer or the owned one
+    */
+    [[nodiscard]] std::span<const std::byte> bytes() const {
+        return {_buffer, _bytes_read};
+    }
+
+    [[nodiscard]] const std::string& get_path() const {
+        return _path;
+    }
+
+private:
+    friend class AsyncFileIO;
+
+    std::string _path;
+    Uint64 _offset     = 0;
+    size_t _size       = 0;
+    std::byte* _buffer = nullptr;
+    std::vector<std::byte> _owned; ///< Destination of `read_file`, sized once the file is opened
+
+    IoPriority _priority = IoPriority::NORMAL;
+    Callback _callback;
+
+    size_t _bytes_read   = 0;
+    int _fd              = -1;    ///< io_uring only
+    bool _is_cancel_sent = false; ///< io_uring only
+
+    std::atomic<AsyncReadStatus> _status{AsyncReadStatus::PENDING};
+    std::atomic<bool> _is_cancel_requested{false};
+    std::atomic<bool> _is_done{false}; ///< Set after the callback, so waiters see what it did
+};
+
+using AsyncReadHandle = std::shared_ptr<AsyncRead>;
+
+/*!
+
+   @brief Asynchronous file reads, lets loaders overlap disk I/O with decoding
+
+   - Linux: one io_uring, reads are submitted in batches and completed by a single I/O thread (kernel 5.7+)
+   - Elsewhere, or when io_uring is unavailable (seccomp, old kernel): a small pool of blocking reader threads,
+     kept apart from the job system so its workers never stall on the disk
+   - Queued reads start by priority, at most `QUEUE_DEPTH` are in flight
+   - `res://` files served by a mounted pack are copied (or inflated) from the mapping on the I/O thread
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class AsyncFileIO {
+public:
+    static constexpr Uint32 QUEUE_DEPTH = 64;
+    static constexpr size_t CHUNK_SIZE  = 1 << 20; ///< Thread pool reads are split so cancellation stays responsive
+
+    static AsyncFileIO& get();
+
+    ~AsyncFileIO();
+
+    AsyncFileIO(const AsyncFileIO&) = delete;
+
+    AsyncFileIO& operator=(const AsyncFileIO&) = delete;
+
+    /*!
+        @brief Start the backend, called by the engine, the first read starts it with the defaults otherwise
+        @param thread_count Reader threads of the fallback pool
+        @param use_io_uring Try io_uring first (Linux only)
+    */
+    bool initialize(int thread_count = 2, bool use_io_uring = true);
+
+    /*!
+        @brief Cancel every queued read, wait for the ones in flight and stop the I/O threads
+    */
+    void shutdown();
+
+    [[nodiscard]] bool is_io_uring() const;
+
+    /*!
+        @brief Read `size` bytes at `offset` into `buffer`
+        @param path `res://`, `user://` or a plain path
+    */
+    AsyncReadHandle read(const std::string& path, Uint64 offset, size_t size, void* buffer, IoPriority priority = IoPriority::NORMAL,
+                         AsyncRead::Callback callback = nullptr);
+
+    /*!
+        @brief Read the whole file into a buffer owned by the request
+    */
+    AsyncReadHandle read_file(const std::string& path, IoPriority priority = IoPriority::NORMAL, AsyncRead::Callback callback = nullptr);
+
+    /*!
+        @brief Reads queued or in flight
+    */
+    [[nodiscard]] size_t get_pending_count() const;
+
+private:
+    friend class AsyncRead;
+
+    struct Ring;
+
+    AsyncFileIO() = default;
+
+    std::array<std::deque<AsyncReadHandle>, 3> _queues; ///< One per priority
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+
+    std::vector<std::thread> _threads;
+    std::unique_ptr<Ring> _ring;
+
+    std::atomic<size_t> _pending{0};
+    bool _running    = false;
+    bool _is_started = false; ///< Lazy start only happens before the first `initialize` or `shutdown`
+
+    bool start(int thread_count, bool use_io_uring);
+
+    AsyncReadHandle submit(AsyncReadHandle request);
+
+    AsyncReadHandle pop_next(); ///< `_mutex` held
+
+    void cancel(AsyncRead& request);
+
+    void wake(); ///< `_mutex` held
+
+    void complete(AsyncRead& request, AsyncReadStatus status);
+
+    bool read_from_pack(AsyncRead& request, const std::string& key) const;
+
+    void pool_loop();
+
+    void pool_read(AsyncRead& request);
+
+#if defined(SDL_PLATFORM_LINUX)
+    void ring_loop();
+
+    void ring_start(const AsyncReadHandle& request);
+
+    void ring_queue_read(int slot);
+
+    void ring_finish(Uint64 user_data, int result);
+#endif
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include  "stdafx.h"
+#include "core/io/async_io.h"
 
 /*!
 
@@ -17,6 +18,7 @@ std::string load_assets_file(const std::string& file_path);
 
    @brief Loads a given file from `res` folder into memory
    - The file path is relative to `res` folder
+   - Read through the VirtualFileSystem, mounted packs take priority over loose files
    @ingroup FileSystem
 
    @version 0.0.2
@@ -109,6 +111,30 @@ public:
      */
     static bool file_exists(const std::string& file_path);
 
+    /**
+     * @brief Resolve a res:// or user:// path to its location on the filesystem, other paths are returned as is.
+     * @param file_path Path to resolve
+     * @return Full path, empty if the user directory is unavailable or the file is served by a mounted pack
+     */
+    static std::string globalize_path(const std::string& file_path);
+
+    /**
+     * @brief Read `size` bytes at `offset` into `buffer` without blocking, see `AsyncFileIO`
+     * @param file_path Path to the file (res://, user:// or plain)
+     * @param buffer Must stay valid until the request is done
+     * @param priority Queued requests start in priority order
+     * @param callback Called on an I/O thread once the request is done (optional)
+     * @return Request handle, `wait` on it or poll `is_done` before reading the buffer
+     */
+    static AsyncReadHandle read_async(const std::string& file_path, Uint64 offset, size_t size, void* buffer,
+                                      IoPriority priority = IoPriority::NORMAL, AsyncRead::Callback callback = nullptr);
+
+    /**
+     * @brief Read the whole file without blocking, into a buffer owned by the request (`AsyncRead::bytes`)
+     */
+    static AsyncReadHandle read_file_async(const std::string& file_path, IoPriority priority = IoPriority::NORMAL,
+                                           AsyncRead::Callback callback = nullptr);
+
     /**
      * @brief Read the entire file as a String.
      * @return File contents as String
@@ -0,0 +1,51 @@
+#pragma once
+#include "stdafx.h"
+
+/*!
+
+   @brief Read-only memory mapping of a whole file
+   - Accepts `res://` and `user://` paths, `res://` files stored in a mounted pack are viewed in the pack mapping
+   - Falls back to reading the file into memory where it can't be mapped (Android APK assets, Emscripten)
+   - The view stays valid until the object is closed or destroyed
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& file_path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& file_path);
+
+    void close();
+
+    [[nodiscard]] bool is_open() const;
+
+    [[nodiscard]] const std::byte* data() const;
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const;
+
+private:
+    const std::byte* _data = nullptr;
+    size_t _size           = 0;
+
+    std::vector<char> _fallback; ///< Owned copy when the file could not be mapped
+    bool _is_view = false;       ///< `_data` belongs to a mounted pack
+
+#if defined(SDL_PLATFORM_WINDOWS)
+    void* _file    = nullptr;
+    void* _mapping = nullptr;
+#endif
+
+    bool map(const std::string& path);
+};
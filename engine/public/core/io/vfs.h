@@ -0,0 +1,155 @@
+#pragma once
+#include "core/io/mapped_file.h"
+
+#include <shared_mutex>
+
+/*!
+
+   @brief Read-only archive produced by `tools/pack_content.py`
+   - The whole archive is memory mapped, the index is built once at open (sorted by path hash)
+   - Stored entries are viewed in place, compressed (zlib) entries are inflated on demand
+   - Reads version 2 archives (header, aligned blobs, stored mode) and the original headerless version 1
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class PackArchive {
+public:
+    static constexpr Uint32 MAGIC   = 0x4B415045; // "EPAK"
+    static constexpr Uint32 VERSION = 2;
+
+    enum EntryFlags : Uint32 {
+        ENTRY_STORED = 1 << 0, /// Data is kept as-is, `packed_size == size`
+    };
+
+    struct Entry {
+        Uint64 hash = 0; /// FNV-1a of `path`
+        std::string path;
+        Uint64 offset      = 0;
+        Uint32 packed_size = 0;
+        Uint32 size        = 0;
+        Uint32 flags       = 0;
+
+        [[nodiscard]] bool is_stored() const {
+            return flags & ENTRY_STORED;
+        }
+    };
+
+    struct Source {
+        std::string path; /// Path in the archive, relative to `res`
+        std::string file; /// File on disk
+    };
+
+    /*!
+        @brief Write a version 2 archive with every file stored, the layout `tools/pack_content.py` produces
+        @note Meant for cooked data read in place, use the Python packer to compress source assets
+        @param alignment Of every blob, a power of two (0 is rejected)
+    */
+    static bool write(const std::string& file_path, const std::vector<Source>& files, Uint32 alignment = 16);
+
+    bool open(const std::string& file_path);
+
+    [[nodiscard]] const Entry* find(std::string_view path) const;
+
+    /*!
+        @brief Bytes of `entry` as they are in the archive, the file itself for stored entries
+    */
+    [[nodiscard]] std::span<const std::byte> view(const Entry& entry) const;
+
+    /*!
+        @brief Copy or inflate `entry` into `out`
+        @param out At least `entry.size` bytes
+    */
+    bool read(const Entry& entry, std::span<std::byte> out) const;
+
+    [[nodiscard]] size_t get_entry_count() const;
+
+    [[nodiscard]] const std::string& get_path() const;
+
+private:
+    MappedFile _file;
+    std::string _path;
+    std::vector<Entry> _entries; ///< Sorted by hash, then path
+
+    bool parse_index();
+};
+
+/*!
+
+   @brief Virtual file system serving `res://` paths
+   - Mounts are searched newest first: pack archives and loose directories (development overlays)
+   - Paths found in no mount are read from the loose `res` folder, an engine without mounts behaves as before
+   - Mounting happens at startup (`<resources>` in `project.xml`), reads are thread safe
+   - Views into a pack stay valid until it is unmounted
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class VirtualFileSystem {
+public:
+    static VirtualFileSystem& get();
+
+    bool mount_pack(const std::string& file_path);
+
+    bool mount_directory(const std::string& directory);
+
+    void unmount_all();
+
+    /*!
+        @brief `path` relative to the `res` folder, with or without the `res://` prefix
+    */
+    [[nodiscard]] bool exists(const std::string& path) const;
+
+    [[nodiscard]] bool get_file_size(const std::string& path, size_t& out) const;
+
+    /*!
+        @brief Loose file serving `path`, empty when it comes from a pack
+        - Falls back to the `res` folder location when no mount has the file
+    */
+    [[nodiscard]] std::string get_loose_path(const std::string& path) const;
+
+    /*!
+        @brief Zero-copy view of a stored pack entry, empty for compressed or loose files
+    */
+    [[nodiscard]] std::span<const std::byte> view(const std::string& path) const;
+
+    /*!
+        @brief Read the whole file into `out`
+        @param out At least `get_file_size` bytes, compressed entries are inflated straight into it
+    */
+    bool read(const std::string& path, std::span<std::byte> out) const;
+
+    [[nodiscard]] std::vector<char> read_all(const std::string& path) const;
+
+    /*!
+        @brief Read-only stream over the file, the caller closes it with `SDL_CloseIO`
+        - Stored entries are streamed from the mapping, compressed ones from a buffer owned by the stream
+    */
+    [[nodiscard]] SDL_IOStream* open(const std::string& path) const;
+
+private:
+    struct Mount {
+        std::unique_ptr<PackArchive> pack; ///< Null for a loose directory
+        std::string directory;
+    };
+
+    struct Lookup {
+        const PackArchive* pack         = nullptr;
+        const PackArchive::Entry* entry = nullptr;
+        std::string loose_path;
+    };
+
+    std::vector<Mount> _mounts;
+    mutable std::shared_mutex _mutex;
+
+    [[nodiscard]] Lookup find(const std::string& path) const;
+};
+
+/*!
+
+   @brief `res://` path normalized to its key in the VFS (no prefix, `/` separators, `.` and `..` resolved)
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+std::string normalize_res_path(std::string_view path);
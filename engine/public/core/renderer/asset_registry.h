@@ -0,0 +1,145 @@
+#pragma once
+#include "core/component/components.h"
+
+enum class AssetType : Uint8 {
+    MESH,
+    MATERIAL,
+    TEXTURE
+};
+
+/*!
+
+    @brief Pooled renderer asset: its type and the raw value of its handle
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct AssetId {
+    AssetType type = AssetType::MESH;
+    Uint32 handle  = 0;
+
+    static AssetId mesh(MeshHandle handle) {
+        return {AssetType::MESH, handle.value};
+    }
+
+    static AssetId material(MaterialHandle handle) {
+        return {AssetType::MATERIAL, handle.value};
+    }
+
+    static AssetId texture(TextureHandle handle) {
+        return {AssetType::TEXTURE, handle.value};
+    }
+
+    bool operator==(const AssetId& other) const = default;
+};
+
+struct AssetIdHash {
+    std::size_t operator()(const AssetId& id) const {
+        return std::hash<Uint64>{}(static_cast<Uint64>(id.type) << 32 | id.handle);
+    }
+};
+
+/*!
+
+    @brief Bookkeeping of a registered asset
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct AssetInfo {
+    std::string name;
+    int ref_count    = 0;
+    size_t cpu_bytes = 0; /// System memory kept after upload (CPU geometry copies, material data)
+    size_t gpu_bytes = 0;
+
+    std::vector<AssetId> dependencies; /// Released with the asset (textures of a material)
+
+    Uint64 destroy_frame = 0; /// Frame the asset is destroyed at once unreferenced, 0 = alive
+};
+
+struct AssetMemoryStats {
+    size_t cpu_bytes = 0;
+    size_t gpu_bytes = 0;
+
+    int meshes    = 0;
+    int materials = 0;
+    int textures  = 0;
+
+    int pending_destroy = 0;
+};
+
+using SceneId = Uint32;
+
+/*!
+
+    @brief Reference counted ownership of the renderer pools
+
+    - Assets are referenced per scene, `unload_scene` drops every reference a scene holds
+    - Unreferenced assets are destroyed by `collect` at a frame boundary `DESTROY_DELAY_FRAMES` later,
+      acquiring them again before that cancels the destruction (shared assets survive level transitions)
+    - Materials hold a reference on their textures
+    - Assets never registered here (environment maps, static chunks) are left to their owner
+
+    @note Main thread only.
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+class AssetRegistry {
+public:
+    static constexpr SceneId GLOBAL_SCENE = 0; /// Default scene, for assets that live as long as the engine
+
+    static constexpr Uint64 DESTROY_DELAY_FRAMES = 2; /// One frame extracted ahead, one being drawn
+
+    SceneId create_scene();
+
+    /*!
+        @brief Scene receiving the references taken by the engine API (`create_*_entity`, `create_material`)
+    */
+    void set_active_scene(SceneId scene);
+
+    [[nodiscard]] SceneId get_active_scene() const;
+
+    void register_mesh(MeshHandle handle, const std::string& path);
+
+    /*!
+        @brief Register a material and reference the pooled textures its maps use
+    */
+    void register_material(MaterialHandle handle);
+
+    void register_texture(TextureHandle handle);
+
+    void acquire(AssetId id, SceneId scene);
+
+    void acquire(AssetId id);
+
+    void release(AssetId id, SceneId scene);
+
+    /*!
+        @brief Release every reference held by `scene`, assets only it used are destroyed after the delay
+    */
+    void unload_scene(SceneId scene);
+
+    /*!
+        @brief Destroy the assets whose delay expired, called once per frame by the engine
+        @param force Destroy every unreferenced asset now (shutdown, explicit memory trim)
+    */
+    void collect(bool force = false);
+
+    [[nodiscard]] const AssetInfo* find(AssetId id) const;
+
+    [[nodiscard]] AssetMemoryStats get_memory_stats() const;
+
+private:
+    std::unordered_map<AssetId, AssetInfo, AssetIdHash> _assets;
+    std::unordered_map<SceneId, std::unordered_map<AssetId, int, AssetIdHash>> _scene_refs;
+    std::vector<AssetId> _pending_destroy;
+
+    SceneId _active_scene = GLOBAL_SCENE;
+    SceneId _next_scene   = GLOBAL_SCENE + 1;
+    Uint64 _frame         = 1;
+
+    void unreference(AssetId id, AssetInfo& info, int count);
+
+    void destroy(AssetId id);
+};
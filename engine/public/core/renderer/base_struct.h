@@ -20,7 +20,8 @@ public:
 
     @brief GpuBuffer Abstract class
     - Bind the buffer
-    - Upload data to the buffer
+    - Upload data to the buffer (reallocates)
+    - Update a range of the buffer in place
     - Get buffer size
 
     @version  0.0.5
@@ -51,6 +52,8 @@ public:
 
     virtual void upload(const void* data, size_t size) = 0;
 
+    virtual void update(const void* data, size_t offset, size_t size) = 0;
+
     virtual size_t size() const = 0;
 
     virtual GpuBufferType type() const = 0;
@@ -201,6 +204,11 @@ protected:
 struct WorldEnvironment {
     Uint32 texture = 0;
 
+    Uint32 prefiltered_texture = 0; /// GGX prefiltered specular cubemap, roughness = mip / (prefiltered_mips - 1)
+    int prefiltered_mips       = 0;
+    Uint32 brdf_lut_texture    = 0;
+    std::array<glm::vec3, 9> irradiance_sh{};
+
     glm::vec3 color = glm::vec3(0.2,0.3,0.3);
     std::shared_ptr<GpuBuffer> vertex_buffer = nullptr;
     std::shared_ptr<GpuBuffer> index_buffer  = nullptr;
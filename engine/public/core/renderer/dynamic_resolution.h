@@ -0,0 +1,52 @@
+#pragma once
+#include "stdafx.h"
+
+/*!
+
+    @brief Render scale controller driven by a frame-time target
+
+    - Frame times are averaged over `SAMPLE_WINDOW` frames before every decision
+    - Over budget: the scale drops proportionally to the overshoot (cost ~ scale²)
+    - Under `UPSCALE_THRESHOLD` of the budget: the scale grows by one `SCALE_STEP`
+    - The band between both thresholds is the hysteresis, the scale is kept as is
+    - Scales are quantized to `SCALE_STEP` and clamped to [min_scale, max_scale]
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+class DynamicResolution {
+public:
+    static constexpr int SAMPLE_WINDOW         = 8;
+    static constexpr float SCALE_STEP          = 0.05f;
+    static constexpr float UPSCALE_THRESHOLD   = 0.80f;
+    static constexpr float DOWNSCALE_THRESHOLD = 1.05f;
+
+    /*!
+        @param target_ms Frame time to hold (1000 / max_fps)
+        @param min_scale Lowest render scale
+        @param max_scale Highest render scale (also the initial one)
+    */
+    void configure(float target_ms, float min_scale, float max_scale);
+
+    /*!
+        @brief Feed the last frame time
+        @return true when the scale changed
+    */
+    bool update(float frame_ms);
+
+    [[nodiscard]] float get_scale() const;
+
+    [[nodiscard]] float get_average_ms() const;
+
+    [[nodiscard]] float get_target_ms() const;
+
+private:
+    float _target_ms = 1000.0f / 60.0f;
+    float _min_scale = 0.5f;
+    float _max_scale = 1.0f;
+    float _scale     = 1.0f;
+
+    float _sample_sum  = 0.0f;
+    int _sample_count  = 0;
+    float _average_ms  = 0.0f;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include "core/renderer/base_struct.h"
+
+/*!
+
+    @brief Six RGBA8 cubemap faces in GL order (+X, -X, +Y, -Y, +Z, -Z)
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct CubemapFaces {
+    int size = 0;
+    std::array<std::vector<unsigned char>, 6> faces;
+};
+
+/*!
+
+    @brief Precomputed image based lighting data
+
+    - Skybox faces (RGBA8, source resolution)
+    - Diffuse irradiance as 9 spherical harmonics coefficients (already divided by PI)
+    - GGX prefiltered specular cubemap, one roughness step per mip (linear RGB float)
+    - Split-sum BRDF lookup table (RG float, x = NdotV, y = roughness)
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct BakedEnvironment {
+    CubemapFaces skybox;
+
+    std::array<glm::vec3, 9> irradiance_sh{};
+
+    int specular_size = 0;
+    int specular_mips = 0;
+    std::vector<std::array<std::vector<float>, 6>> specular; /// [mip][face]
+
+    int brdf_lut_size = 0;
+    std::vector<float> brdf_lut;
+};
+
+/*!
+
+    @brief CPU environment baking stage
+
+    Runs entirely on worker threads without a GPU context, so it can be used headless (tools, servers).
+    Results are cached in `user://cache/ibl/` keyed by the source file hash.
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+class EnvironmentBaker {
+public:
+    static constexpr Uint32 CACHE_VERSION  = 1;
+    static constexpr int SPECULAR_SIZE     = 128;
+    static constexpr int SPECULAR_SAMPLES  = 64;
+    static constexpr int IRRADIANCE_SIZE   = 32;
+    static constexpr int BRDF_LUT_SIZE     = 64;
+    static constexpr int BRDF_LUT_SAMPLES  = 128;
+
+    /*!
+        @brief Load the baked environment from cache, or decode + bake + cache the atlas on a miss
+        @param atlas_path Cubemap atlas (horizontal, vertical, 3x2 or 4x3 cross)
+    */
+    static bool load_or_bake(const std::string& atlas_path, CubemapOrientation orient, BakedEnvironment& out);
+
+    /*!
+        @brief Split a cubemap atlas into its six faces
+    */
+    static bool extract_faces(const unsigned char* pixels, int width, int height, CubemapOrientation orient, CubemapFaces& out);
+
+    /*!
+        @brief Bake irradiance SH, the prefiltered specular chain and the BRDF LUT from `faces`
+    */
+    static void bake(const CubemapFaces& faces, BakedEnvironment& out);
+
+    static bool load_cache(const std::string& path, BakedEnvironment& out);
+
+    static bool save_cache(const std::string& path, const BakedEnvironment& environment);
+};
@@ -1,5 +1,8 @@
 #pragma once
 #include  "ogl_struct.h"
+#include  "core/renderer/texture_residency.h"
+#include  "core/renderer/environment_baker.h"
+#include  "core/renderer/dynamic_resolution.h"
 
 class OpenGLRenderer final : public Renderer {
 
@@ -23,6 +26,8 @@ public:
 
     Uint32 load_texture_from_raw_data(const unsigned char* data, int w, int h, int channels = 4, const std::string& name = "") override;
 
+    Uint32 create_texture(const TextureImage& image) override;
+
     void begin_frame() override;
 
     void begin_shadow_pass() override;
@@ -42,12 +47,14 @@ public:
     void end_render_target() override;
 
     void begin_environment_pass() override;
-    void render_environment_pass(const Camera3D& camera) override;
+    void render_environment_pass(const Camera3D& camera, const Transform3D& camera_transform) override;
     void end_environment_pass() override;
 
-    void add_to_render_batch(const Transform3D& transform, const MeshRef& mesh_ref, const MaterialRef& mat_ref) override;
+    void update_render_proxy(Uint64 id, const Transform3D& transform, const MeshRef& mesh_ref, const MaterialRef& mat_ref) override;
+
+    void remove_render_proxy(Uint64 id) override;
 
-    void add_to_shadow_batch(const Transform3D& transform, const MeshRef& mesh_ref) override;
+    void destroy_texture(Uint32 texture) override;
 
     void resize(int w, int h) override;
 
@@ -55,17 +62,66 @@ public:
 
     void swap_chain() override;
 
+    bool acquire_context() override;
+
+    void release_context() override;
+
 private:
     SDL_GLContext _context = nullptr;
 
+    TextureResidency _texture_residency;
+
+    Uint64 _frame_index = 0;
+
+    static constexpr size_t TEXTURE_UPLOAD_BUDGET = 8 * 1024 * 1024; // bytes streamed to the GPU per frame
+
+    static constexpr int GPU_TIMER_QUERIES = 3; // results are read back 2 frames late to avoid stalls
+
+    DynamicResolution _dynamic_resolution;
+
+    bool _dynamic_resolution_enabled = false;
+
+    float _upscale_sharpness = 0.0f;
+
+    std::shared_ptr<OpenGLFramebuffer> _scene_fbo = nullptr; // Main pass target when rendering below window resolution
+
+    std::unique_ptr<Shader> _upscale_shader = nullptr;
+
+    GLuint _upscale_vao = 0;
+
+    std::array<GLuint, GPU_TIMER_QUERIES> _gpu_timer_queries{};
+
+    int _gpu_timer_index = 0;
+
+    Uint64 _last_swap_counter = 0;
+
     GLuint create_gl_texture(const unsigned char* data, int w, int h, int channels);
 
+    GLuint create_streamed_texture(const unsigned char* data, int w, int h, int channels, TextureResidencyEntry entry);
+
+    void upload_texture_levels(GLuint texture, const TextureMipChain& chain);
+
+    void drop_texture_levels(GLuint texture, const TextureResidencyEntry& entry, int base_mip);
+
+    void stream_textures();
+
+    void request_texture_feedback(RenderBatch& batch, const MeshDrawData& mesh, const Material& material,
+                                  const glm::vec3& camera_position, float pixels_per_unit);
+
+    void update_render_size();
+
+    void update_dynamic_resolution();
+
+    void upscale_scene_target();
+
     WorldEnvironment* create_skybox_from_atlas(const std::string& atlas_path,
                                                CubemapOrientation orient = CubemapOrientation::DEFAULT,
                                                float brightness          = 1.0f);
 
 
-    void setup_instance_matrix_attribute(GpuVertexLayout* vao);
+    void setup_instance_matrix_attribute(const GpuVertexLayout* vao, const GpuBuffer* instances);
+
+    void upload_render_proxies();
 
 
     void setup_lights(const std::vector<DirectionalLight>& directional_lights,
@@ -34,6 +34,8 @@ public:
 
     void upload(const void* data, size_t size) override;
 
+    void update(const void* data, size_t offset, size_t size) override;
+
     size_t size() const override;
 
     GpuBufferType type() const override;
@@ -0,0 +1,50 @@
+#pragma once
+#include "core/component/components.h"
+
+/*!
+
+    @brief Creation or update of a retained render proxy (transform already interpolated)
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct RenderProxyUpdate {
+    Uint64 id = 0; /// Entity id
+    Transform3D transform;
+    MeshRef mesh;
+    MaterialRef material;
+};
+
+/*!
+
+    @brief Everything the renderer needs to draw one frame
+
+    Produced by extraction on the simulation thread, then only read by the renderer.
+    The world can be simulated further while a snapshot is being rendered.
+    Drawables are retained by the renderer, a snapshot only carries the proxies that changed since the last one.
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct RenderSnapshot {
+    Camera3D camera;
+    Transform3D camera_transform;
+
+    glm::mat4 light_space_matrix{1.0f};
+    std::vector<DirectionalLight> directional_lights;
+    std::vector<std::pair<Transform3D, SpotLight>> spot_lights;
+
+    std::vector<Uint64> proxy_removals; /// Applied before `proxy_updates`
+    std::vector<RenderProxyUpdate> proxy_updates;
+
+    /// Keeps the allocations, snapshots are recycled every frame
+    void clear() {
+        camera             = Camera3D{};
+        camera_transform   = Transform3D{};
+        light_space_matrix = glm::mat4(1.0f);
+        directional_lights.clear();
+        spot_lights.clear();
+        proxy_removals.clear();
+        proxy_updates.clear();
+    }
+};
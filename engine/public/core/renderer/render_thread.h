@@ -0,0 +1,82 @@
+#pragma once
+#include "core/renderer/renderer.h"
+#include "core/renderer/render_snapshot.h"
+
+/*!
+
+    @brief Render thread owning the graphics context
+
+    - The simulation thread extracts frame N+1 while this thread submits frame N
+    - Snapshots are handed over by swapping, so their allocations are recycled
+    - `execute` marshals work that needs the context (resource creation) and waits for it
+
+    @note The simulation can only run one frame ahead, `submit` blocks until the previous snapshot was picked up.
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+class RenderThread {
+public:
+    using Command     = std::function<void()>;
+    using FrameRender = std::function<void(const RenderSnapshot&)>;
+
+    RenderThread() = default;
+
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /*!
+        @brief Move the graphics context of `renderer` to a new thread
+        @param render_frame Called on the render thread for every submitted snapshot
+    */
+    bool start(Renderer* renderer, FrameRender render_frame);
+
+    /*!
+        @brief Drain pending commands, join and make the context current on the calling thread again
+    */
+    void stop();
+
+    [[nodiscard]] bool is_running() const;
+
+    [[nodiscard]] bool is_render_thread() const;
+
+    /*!
+        @brief Hand a snapshot to the render thread, `snapshot` receives a recycled one (contents undefined)
+    */
+    void submit(RenderSnapshot& snapshot);
+
+    /*!
+        @brief Run `command` on the render thread and wait for it (runs inline on the render thread)
+    */
+    void execute(const Command& command);
+
+    /*!
+        @brief Stats of the last rendered frame
+    */
+    [[nodiscard]] RenderStats get_stats() const;
+
+private:
+    Renderer* _renderer = nullptr;
+    FrameRender _render_frame;
+
+    std::thread _thread;
+    std::thread::id _thread_id;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+
+    RenderSnapshot _pending;
+    RenderSnapshot _current;
+    bool _has_pending = false;
+
+    std::deque<Command> _commands;
+
+    RenderStats _stats;
+
+    bool _running = false;
+
+    void thread_loop();
+};
@@ -1,20 +1,55 @@
 #pragma once
 #include  "core/component/components.h"
 #include "base_struct.h"
+#include "core/renderer/texture_residency.h"
 
+/*!
+
+    @brief Retained instances of one mesh/material pair
+
+    - Slots are packed, removing a proxy moves the last slot into its place
+    - `instance_buffer` keeps the matrices resident, only the dirty slot range is re-uploaded
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
 struct RenderBatch {
-    const MeshInstance3D* mesh;
-    const Material* material;
+    MeshHandle mesh;
+    MaterialHandle material;
     std::vector<glm::mat4> model_matrices;
+    std::vector<Uint64> proxies; /// Proxy id of every slot
+
+    std::shared_ptr<GpuBuffer> instance_buffer = nullptr;
+    size_t gpu_capacity = 0; /// Instances the GPU buffer can hold
+
+    size_t dirty_begin = SIZE_MAX;
+    size_t dirty_end   = 0;
+
+    // Union of the instance bounding spheres and the largest instance radius, read by texture streaming every frame.
+    // Rebuilt only after a slot changed, a batch nothing moved in costs nothing
+    glm::vec4 bounds{0.0f};
+    float max_instance_radius = 0.0f;
+    bool is_bounds_dirty      = true;
+
+    void mark_dirty(size_t slot) {
+        dirty_begin     = std::min(dirty_begin, slot);
+        dirty_end       = std::max(dirty_end, slot + 1);
+        is_bounds_dirty = true;
+    }
 
-    void clear() {
-        model_matrices.clear();
+    [[nodiscard]] bool is_dirty() const {
+        return dirty_begin < dirty_end;
+    }
+
+    void clear_dirty() {
+        dirty_begin = SIZE_MAX;
+        dirty_end   = 0;
     }
 };
 
 struct MeshMaterialKey {
-    const MeshInstance3D* mesh;
-    const Material* material;
+    MeshHandle mesh;
+    MaterialHandle material;
 
     bool operator==(const MeshMaterialKey& other) const {
         return mesh == other.mesh && material == other.material;
@@ -23,12 +58,110 @@ struct MeshMaterialKey {
 
 struct MeshMaterialKeyHash {
     std::size_t operator()(const MeshMaterialKey& key) const {
-        std::size_t h1 = std::hash<const void*>{}(key.mesh);
-        std::size_t h2 = std::hash<const void*>{}(key.material);
-        return h1 ^ (h2 << 1);
+        return std::hash<Uint64>{}(static_cast<Uint64>(key.mesh.value) << 32 | key.material.value);
     }
 };
 
+/*!
+
+    @brief Cold data of a pooled texture
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct TextureInfo {
+    std::string name; /// Path or key
+    size_t gpu_bytes = 0; /// Full mip chain, streamed textures may keep less resident
+};
+
+using MeshPool     = HandlePool<MeshTag, MeshDrawData, MeshInstance3D>;
+using MaterialPool = HandlePool<MaterialTag, Material, std::string>; /// Cold data: registered name
+using TexturePool  = HandlePool<TextureTag, Uint32, TextureInfo>; /// Hot data: texture object
+
+/*!
+
+    @brief Renderer side of a drawable entity: the batch and slot holding its instance data
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct RenderProxy {
+    MeshMaterialKey key;
+    size_t slot = 0;
+};
+
+/*!
+
+    @brief View frustum planes extracted from a view-projection matrix (normals point inside)
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct Frustum {
+    std::array<glm::vec4, 6> planes{};
+
+    static Frustum from_matrix(const glm::mat4& view_projection) {
+        const glm::mat4 m = glm::transpose(view_projection);
+
+        Frustum frustum;
+        frustum.planes = {m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2]};
+
+        for (auto& plane : frustum.planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+
+        return frustum;
+    }
+
+    [[nodiscard]] bool is_sphere_visible(const glm::vec3& center, float radius) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/*!
+
+    @brief Per-frame renderer statistics
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct RenderStats {
+    int draw_calls = 0;
+    int instances  = 0;
+    int instance_uploads = 0; /// Instances re-uploaded this frame (changed proxies)
+    int culled_batches   = 0; /// Single instance batches (static chunks included) outside the view frustum
+
+    int render_width   = 0; /// Main pass resolution (after render scale)
+    int render_height  = 0;
+    float render_scale = 1.0f;
+
+    float frame_ms  = 0.0f; /// Averaged frame time used by dynamic resolution
+    float target_ms = 0.0f;
+};
+
+/*!
+
+    @brief Decoded image waiting for its upload, see `Renderer::decode_texture_*` and `Renderer::create_texture`
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct TextureImage {
+    std::string name; /// Key in `Renderer::_texture_names`
+    TextureSourceType source_type = TextureSourceType::FILE;
+
+    std::span<const unsigned char> encoded;     /// MEMORY: compressed bytes, copied for re-streaming, valid until uploaded
+    std::shared_ptr<const unsigned char> pixels; /// Null when decoding failed, borrowed for RAW
+
+    int width    = 0;
+    int height   = 0;
+    int channels = 0;
+};
 
 class Renderer {
 public:
@@ -50,6 +183,19 @@ public:
     virtual Uint32 load_texture_from_memory(const unsigned char* buffer, size_t size, const std::string& name = "") = 0;
     virtual Uint32 load_texture_from_raw_data(const unsigned char* data, int width, int height, int channels = 4,
                                               const std::string& name                                        = "") = 0;
+
+    /*!
+        @brief Upload a decoded image and register it under `image.name`, the texture already registered under that name wins
+        @note Main thread, decoding (`decode_texture_*`) is thread safe and can run on workers beforehand
+    */
+    virtual Uint32 create_texture(const TextureImage& image) = 0;
+
+    static TextureImage decode_texture_file(const std::string& path);
+
+    static TextureImage decode_texture_memory(const unsigned char* buffer, size_t size, const std::string& name);
+
+    static TextureImage wrap_texture_raw(const unsigned char* data, int width, int height, int channels, const std::string& name);
+
     virtual void begin_frame() = 0;
 
     virtual void begin_shadow_pass() = 0;
@@ -65,23 +211,74 @@ public:
     virtual void end_render_target() = 0;
 
     virtual void begin_environment_pass() =0;
-    virtual void render_environment_pass(const Camera3D& camera) =0;
+    virtual void render_environment_pass(const Camera3D& camera, const Transform3D& camera_transform) =0;
     virtual void end_environment_pass() =0;
 
-    virtual void add_to_render_batch(const Transform3D& transform,
+    /*!
+        @brief Create or update the retained proxy `id`, moved to another batch when the mesh or material changed
+    */
+    virtual void update_render_proxy(Uint64 id, const Transform3D& transform,
                                      const MeshRef& mesh_ref, const MaterialRef& mat_ref) = 0;
 
-    virtual void add_to_shadow_batch(const Transform3D& transform,const MeshRef& mesh_ref) = 0;
+    virtual void remove_render_proxy(Uint64 id) = 0;
+
+    /*!
+        @brief Release a texture object created by one of the `load_texture_*` functions
+    */
+    virtual void destroy_texture(Uint32 texture) = 0;
 
 
     virtual void swap_chain() = 0;
 
-    std::unordered_map<std::string, Uint32> _textures;
-    std::unordered_map<std::string, std::vector<MeshInstance3D>> _meshes;
-    std::unordered_map<std::string, std::vector<Material>> _materials;
+    /*!
+        @brief Make the graphics context current on the calling thread
+    */
+    virtual bool acquire_context() = 0;
 
-    void register_material(const char* name, const Material& material) {
-        _materials[name].push_back(material);
+    /*!
+        @brief Detach the graphics context from the calling thread so another one can acquire it
+    */
+    virtual void release_context() = 0;
+
+    /*!
+        @brief Pools are only mutated on the render thread (through the methods below), they are read while drawing
+    */
+    MeshPool _meshes;
+    MaterialPool _materials;
+    TexturePool _textures;
+
+    std::unordered_map<std::string, std::vector<MeshHandle>> _mesh_paths; /// Every mesh of a loaded file
+    std::unordered_map<std::string, std::vector<MaterialHandle>> _material_names; /// Registered materials, model paths included
+    std::unordered_map<std::string, TextureHandle> _texture_names;
+
+    /*!
+        @brief Move a loaded mesh into the pool, null handle when it has no GPU data
+    */
+    MeshHandle add_mesh(MeshInstance3D mesh);
+
+    void remove_mesh(MeshHandle handle);
+
+    MaterialHandle add_material(const std::string& name, const Material& material);
+
+    void remove_material(MaterialHandle handle);
+
+    TextureHandle add_texture(const std::string& name, Uint32 texture, size_t gpu_bytes = 0);
+
+    void remove_texture(TextureHandle handle);
+
+    MaterialHandle register_material(const char* name, const Material& material) {
+        return add_material(name, material);
+    }
+
+    const RenderStats& get_stats() const {
+        return _stats;
+    }
+
+    /*!
+        @brief Swap interval in use: 0 = immediate, 1 = vsync, -1 = adaptive vsync
+    */
+    int get_swap_interval() const {
+        return _swap_interval;
     }
 
 protected:
@@ -97,12 +294,12 @@ protected:
 
     int width = 0, height = 0;
 
-    std::shared_ptr<GpuBuffer> instance_buffer;
-
     std::unordered_map<MeshMaterialKey, RenderBatch, MeshMaterialKeyHash> _instanced_batches;
 
-    std::unordered_map<const MeshInstance3D*, RenderBatch> shadow_batches;
+    std::unordered_map<Uint64, RenderProxy> _render_proxies;
+
+    RenderStats _stats;
 
-    size_t max_instances = 1000;
+    int _swap_interval = 0;
 
 };
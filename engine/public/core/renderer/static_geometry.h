@@ -0,0 +1,91 @@
+#pragma once
+#include "core/component/components.h"
+
+/*!
+
+    @brief Merged geometry of every `Static` drawable, baked per material and spatial chunk
+
+    - Static entities are pre-transformed into one vertex/index buffer per (chunk cell, material)
+    - Each chunk is a single retained render proxy, frustum culled with its bounds
+    - Observers record which static entities changed, `bake` only rebuilds the chunks they touch
+    - Static entities are never sent as per-entity proxies
+
+    @note Main thread only, GPU work is marshalled with `Engine::run_on_render_thread`.
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+class StaticGeometry {
+public:
+    static constexpr float CHUNK_SIZE = 32.0f; /// World units per chunk cell side
+
+    static constexpr Uint64 PROXY_ID_BIT = 1ull << 63; /// Set on chunk proxy ids, flecs never sets it on entities
+
+    StaticGeometry() = default;
+
+    StaticGeometry(const StaticGeometry&) = delete;
+
+    StaticGeometry& operator=(const StaticGeometry&) = delete;
+
+    /*!
+        @brief Register the observers tracking static drawables
+    */
+    void setup(flecs::world& world);
+
+    /*!
+        @brief Whether static entities changed since the last bake
+    */
+    [[nodiscard]] bool has_pending() const;
+
+    /*!
+        @brief Re-bake the chunks touched by static entities added, changed or removed since the last bake
+    */
+    void bake(const flecs::world& world);
+
+    /*!
+        @brief Re-bake every chunk from scratch (scene load, or after editing static transforms in place)
+    */
+    void rebuild(const flecs::world& world);
+
+    /*!
+        @brief Release every chunk and its proxy, runs where the graphics context is current
+    */
+    void clear(Renderer& renderer);
+
+    [[nodiscard]] size_t get_chunk_count() const;
+
+private:
+    struct ChunkKey {
+        glm::ivec3 cell;
+        MaterialHandle material;
+
+        bool operator==(const ChunkKey& other) const {
+            return cell == other.cell && material == other.material;
+        }
+    };
+
+    struct ChunkKeyHash {
+        std::size_t operator()(const ChunkKey& key) const {
+            std::size_t h = std::hash<Uint32>{}(key.material.value);
+            h ^= std::hash<int>{}(key.cell.x) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<int>{}(key.cell.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<int>{}(key.cell.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    struct Chunk {
+        Uint64 proxy_id = 0;
+        std::vector<Uint64> entities;
+        MeshHandle mesh; /// Null until baked
+        bool is_dirty = true;
+    };
+
+    std::unordered_map<ChunkKey, Chunk, ChunkKeyHash> _chunks;
+    std::unordered_map<Uint64, ChunkKey> _entity_chunks;
+    std::unordered_set<Uint64> _pending; // Written by the observers, consumed by `bake`
+
+    Uint64 _next_proxy_id = 0;
+
+    static ChunkKey get_chunk_key(const Transform3D& transform, const MaterialRef& material);
+};
@@ -0,0 +1,221 @@
+#pragma once
+#include "stdafx.h"
+#include "core/io/async_io.h"
+
+/*!
+
+    @brief Where a streamed texture re-reads its pixels from
+    - FILE   : Re-decoded from disk (path)
+    - MEMORY : Re-decoded from a compressed blob (embedded PNG/JPG)
+    - RAW    : Uncompressed pixels kept in system memory
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+enum class TextureSourceType {
+    FILE,
+    MEMORY,
+    RAW
+};
+
+/*!
+
+    @brief A single decoded mip level
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct TextureMipLevel {
+    int width  = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+/*!
+
+    @brief Decoded mip levels ready to be uploaded, starting at `base_mip`
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct TextureMipChain {
+    Uint32 id     = 0;
+    Uint64 serial = 0; /// Registration the levels were decoded for, GL names are reused once released
+    int base_mip  = 0;
+    int channels = 4;
+    std::vector<TextureMipLevel> levels;
+
+    [[nodiscard]] size_t size_bytes() const;
+};
+
+/*!
+
+    @brief Top mips to drop from a texture, the renderer keeps the levels already on the GPU from `base_mip` down
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct TextureDowngrade {
+    Uint32 id    = 0;
+    int base_mip = 0;
+};
+
+/*!
+
+    @brief Residency state of a streamed texture
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+struct TextureResidencyEntry {
+    Uint32 id     = 0;
+    Uint64 serial = 0; /// Set by `register_texture`, unique per registration
+    std::string name;
+
+    TextureSourceType source_type = TextureSourceType::FILE;
+    std::shared_ptr<const std::vector<unsigned char>> source = nullptr; /// Compressed or raw pixels (MEMORY/RAW)
+
+    int width     = 0;
+    int height    = 0;
+    int channels  = 4;
+    int mip_count = 1;
+
+    int min_mip       = 0; /// Smallest mip always kept resident (fallback while streaming)
+    int resident_mip  = 0; /// Highest resolution level currently on the GPU
+    int target_mip    = 0; /// Level the residency policy wants on the GPU
+    int requested_mip = 0; /// Finest level requested by screen-size feedback this frame
+
+    Uint64 last_used_frame = 0;
+    Uint64 requested_frame = 0;
+
+    size_t resident_bytes = 0;
+    bool in_flight        = false;
+    bool failed           = false; /// Source could not be decoded again, the texture can only drop mips
+};
+
+/*!
+
+    @brief Texture streaming and VRAM budget manager
+
+    - Tracks the resident bytes of every streamed texture
+    - Screen-size feedback (`request_screen_size`) selects the finest mip needed
+    - Least recently used textures drop their top mips when over budget, from the levels already on the GPU
+    - Mip chains are only decoded to raise quality, on a background thread, uploads are done by the renderer
+    - Files are read asynchronously as soon as a job is queued, the next read overlaps the current decode
+
+    @note Texture ids never change while streaming, the renderer re-specifies the levels in place.
+
+    @ingroup Rendering
+    @version 0.0.5
+*/
+class TextureResidency {
+public:
+    static constexpr int MIN_RESIDENT_SIZE   = 64; /// Textures never drop below this size (in texels)
+    static constexpr Uint64 FEEDBACK_WINDOW  = 120; /// Frames without feedback before a texture is considered unused
+    static constexpr int MAX_IN_FLIGHT       = 4;
+
+    TextureResidency() = default;
+
+    ~TextureResidency();
+
+    TextureResidency(const TextureResidency&) = delete;
+
+    TextureResidency& operator=(const TextureResidency&) = delete;
+
+    /*!
+        @brief Start the background decoder
+        @param budget_bytes VRAM budget for streamed textures, 0 disables streaming
+    */
+    void start(size_t budget_bytes);
+
+    void shutdown();
+
+    [[nodiscard]] bool is_enabled() const;
+
+    /*!
+        @brief Register a texture that was just created with `resident_mip` as its top resident level
+    */
+    void register_texture(TextureResidencyEntry entry);
+
+    void unregister_texture(Uint32 id);
+
+    [[nodiscard]] const TextureResidencyEntry* find(Uint32 id) const;
+
+    /*!
+        @brief Screen-size feedback, `pixels` is the on-screen size the texture is stretched over
+    */
+    void request_screen_size(Uint32 id, float pixels, Uint64 frame);
+
+    /*!
+        @brief Run the residency policy (LRU eviction + upgrade scheduling)
+    */
+    void update(Uint64 frame);
+
+    /*!
+        @brief Textures `update` lowered, the renderer drops their top mips then calls `mark_resident`
+    */
+    std::vector<TextureDowngrade> pop_downgrades();
+
+    /*!
+        @brief Pop decoded mip chains, up to `max_bytes` per call (at least one)
+        @note Chains of textures released while decoding are dropped, even when their name was reused since
+    */
+    std::vector<TextureMipChain> pop_ready(size_t max_bytes);
+
+    /*!
+        @brief Called by the renderer once a chain has been uploaded
+    */
+    void mark_resident(Uint32 id, int base_mip, size_t bytes);
+
+    [[nodiscard]] size_t get_resident_bytes() const;
+
+    [[nodiscard]] size_t get_budget() const;
+
+    [[nodiscard]] size_t get_texture_count() const;
+
+    static int compute_mip_count(int width, int height);
+
+    static int compute_min_mip(int width, int height);
+
+    static size_t compute_bytes(int width, int height, int channels, int base_mip, int mip_count);
+
+    /*!
+        @brief Box filter mip generation, returns the levels starting at `base_mip`
+    */
+    static std::vector<TextureMipLevel> build_mip_chain(const unsigned char* pixels, int width, int height, int channels, int base_mip);
+
+private:
+    struct Job {
+        Uint32 id     = 0;
+        Uint64 serial = 0;
+        std::string name;
+        TextureSourceType source_type = TextureSourceType::FILE;
+        std::shared_ptr<const std::vector<unsigned char>> source = nullptr;
+        int width    = 0;
+        int height   = 0;
+        int channels = 4;
+        int base_mip = 0;
+
+        AsyncReadHandle read = nullptr; ///< FILE: started when queued, the decoder only waits for what is left
+        bool is_cooked       = false;   ///< `read` is the `.gtex` next to the source
+    };
+
+    std::unordered_map<Uint32, TextureResidencyEntry> _entries;
+
+    size_t _budget         = 0;
+    size_t _resident_bytes = 0;
+    int _in_flight         = 0;
+    Uint64 _next_serial    = 0;
+
+    std::thread _worker;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<Job> _jobs;
+    std::deque<TextureMipChain> _ready;
+    std::vector<TextureDowngrade> _downgrades;
+    bool _running = false;
+
+    void worker_loop();
+
+    static bool decode_job(const Job& job, TextureMipChain& out);
+};
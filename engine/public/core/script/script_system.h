@@ -0,0 +1,176 @@
+#pragma once
+#include "stdafx.h"
+#include "core/binding/lua.h"
+#include "core/system/job_system.h"
+
+/*!
+    @brief Cost of one script file during the last update, every entity running it together
+    @ingroup Scripting
+    @version 0.0.5
+*/
+struct ScriptStats {
+    std::string path;
+    int instances    = 0;     ///< Entities dispatched
+    int errors       = 0;     ///< Since the script was loaded, a failing entity stops running it
+    double update_ms = 0.0;   ///< `ready` and `update` calls, Lua side included, summed over the workers for parallel scripts
+    bool is_parallel = false;
+};
+
+/*!
+    @brief Lua collector work done in the leftover time of the last frame, every state together
+    @ingroup Scripting
+    @version 0.0.5
+*/
+struct ScriptGcStats {
+    double gc_ms      = 0.0; ///< Steps run by `collect_garbage`, the allocator may still run steps of its own
+    size_t heap_bytes = 0;   ///< After the steps
+    int steps         = 0;
+    int cycles        = 0;   ///< Collection cycles finished by those steps
+};
+
+/*!
+
+   @brief Runs the `Script` components of a world
+
+   - Each file is loaded once into a shared prototype (its own environment, globals fall back to `_G`), the `ready` and `update`
+     functions are resolved at load and kept as handles, the dispatch never looks up a global
+   - Entities are gathered per prototype, then each prototype runs its whole batch with the function pushed once
+   - Entities are light userdata and components are read through the `ecs` table (see `generate_bindings`), nothing is allocated per call
+   - Runs as the `RunScripts` system (OnUpdate), structural changes made by scripts are deferred to the end of the step
+
+   Scripts setting the global `parallel = true` promise to only write their own entity. Their batch is split over the job system,
+   every worker running its own `lua_State` with the same bindings and its own copy of the prototype:
+   - Writes to other entities and deletes are queued and applied on the main thread once the batch is done
+   - Globals are per state, a parallel script can't share Lua values between entities
+   - Reads of other entities may see values another worker is writing in the same batch
+
+   Scripts touching many entities go through `ecs.each_transform` instead, one call per table with views over the column storage.
+
+   Cooked scripts are stripped bytecode next to their source (`get_cooked_path`, see the asset cooker) loaded without the parser.
+   The bytecode is bound to the Lua ABI of the cooking host, a build that rejects its header loads the source instead.
+   The collector of each state is generational when Lua has it (5.4), `collect_garbage` runs its steps in the leftover frame time.
+
+   @ingroup Scripting
+   @version 0.0.5
+*/
+class ScriptSystem {
+public:
+    ScriptSystem();
+
+    ScriptSystem(const ScriptSystem&) = delete;
+
+    ScriptSystem& operator=(const ScriptSystem&) = delete;
+
+    /*!
+        @brief Register the `RunScripts` system
+        @param job_system Runs the parallel scripts, nullptr runs them on the calling thread
+    */
+    void setup(flecs::world& world, JobSystem* job_system = nullptr);
+
+    /*!
+        @brief Load a script ahead of time (level load), later loads of the same path return the same prototype
+        @return Prototype index, -1 when the file is missing or doesn't compile
+    */
+    int load(const std::string& path);
+
+    /*!
+        @brief Bytecode written by the asset cooker for `source_path`, preferred over the source when present
+    */
+    static std::string get_cooked_path(const std::string& source_path);
+
+    /*!
+        @brief Run the batch of every prototype, called by `RunScripts`
+    */
+    void dispatch(flecs::iter& it);
+
+    [[nodiscard]] std::vector<ScriptStats> get_stats() const;
+
+    /*!
+        @brief Collector mode of every state, existing and created later
+        @param is_generational Ignored before Lua 5.4, the collector stays incremental
+        @param budget_ms Upper bound of `collect_garbage`, whatever the leftover time
+    */
+    void set_gc(bool is_generational, float budget_ms);
+
+    /*!
+        @brief Run collector steps until `budget_ns` (capped by `set_gc`) is spent or every state finished a cycle
+        - Incremental: small steps until the budget runs out or the cycle ends
+        - Generational: one young collection per state, a step is a whole collection in this mode
+        Called by the frame loop before the frame limiter sleeps, the automatic collector stays on for frames without leftover time
+    */
+    void collect_garbage(Uint64 budget_ns);
+
+    [[nodiscard]] const ScriptGcStats& get_gc_stats() const;
+
+    /*!
+        @brief Main thread state, runs every script that isn't parallel
+    */
+    [[nodiscard]] sol::state& get_state();
+
+private:
+    struct Instance {
+        flecs::entity_t entity;
+        Script* script; ///< Tables don't move while the system runs
+    };
+
+    struct Prototype {
+        std::string chunk;           ///< Kept to load the prototype in the worker states
+        std::vector<Instance> batch; ///< Reused every update
+        ScriptStats stats;
+    };
+
+    /// Functions of one prototype in one state
+    struct Handles {
+        sol::environment environment;
+        sol::protected_function ready;
+        sol::protected_function update;
+        bool is_loaded = false;
+    };
+
+    /// One per worker plus the main thread (slot 0)
+    struct Vm {
+        sol::state lua;
+        LuaBindingContext context;
+        std::vector<Handles> handles; ///< Indexed like `_prototypes`
+        std::vector<ScriptCommand> commands;
+
+        // Of the prototype being run, only touched by the thread owning the slot until the batch is done
+        Uint64 time_ns = 0;
+        int errors     = 0;
+    };
+
+    JobSystem* _job_system = nullptr;
+
+    flecs::query<const Transform3D> _transform_query; ///< Shared by the `ecs.each_transform` of every state
+
+    bool _is_gc_generational = true;
+    Uint64 _gc_budget_ns     = 1000000;
+    size_t _gc_cursor        = 0; ///< State stepped first, rotated so a busy main state doesn't starve the worker states
+    ScriptGcStats _gc_stats;
+
+    std::vector<std::unique_ptr<Vm>> _vms;
+    std::vector<Prototype> _prototypes;
+    std::unordered_map<std::string, int> _prototype_index; ///< -1 for files that failed, not retried every frame
+
+    std::unique_ptr<Vm> create_vm() const;
+
+    void apply_gc_mode(lua_State* L) const;
+
+    bool load_into(Vm& vm, int index);
+
+    void run_serial(Prototype& prototype, int index, float delta);
+
+    void run_parallel(Prototype& prototype, int index, float delta);
+
+    /*!
+        @brief Call `ready` then `update` for the instances [begin, end) of the batch
+    */
+    static void run_range(Vm& vm, Prototype& prototype, int index, size_t begin, size_t end, float delta);
+
+    /*!
+        @brief Log the error on top of the stack and stop the instance
+    */
+    static void fail(Vm& vm, const Prototype& prototype, Instance& instance);
+
+    static void apply(flecs::world_t* world, const std::vector<ScriptCommand>& commands);
+};
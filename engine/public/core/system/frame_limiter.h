@@ -0,0 +1,44 @@
+#pragma once
+
+#include "stdafx.h"
+
+/*!
+@file frame_limiter.h
+    @brief FrameLimiter class definition.
+
+    Hybrid frame limiter: the OS sleep covers most of the wait and the last
+    `SPIN_THRESHOLD_NS` are spun on `SDL_GetPerformanceCounter`, since sleep
+    granularity (1 ms or worse) is too coarse to hit the deadline precisely.
+    Deadlines advance by a fixed period so the average frame rate does not drift.
+
+    @ingroup Time
+    @version 0.0.5
+
+*/
+class FrameLimiter {
+public:
+    static constexpr Uint64 SPIN_THRESHOLD_NS = 2'000'000;
+
+    /*!
+        @param fps Target frame rate, 0 disables the limiter
+    */
+    void set_target_fps(int fps);
+
+    int get_target_fps() const;
+
+    /*!
+        @brief Block until the next frame deadline
+    */
+    void wait();
+
+    /*!
+        @brief Time left before the next frame deadline, work done in it doesn't lower the frame rate
+        @return 0 when the limiter is disabled, on the first frame or when the frame is late
+    */
+    [[nodiscard]] Uint64 get_remaining_ns() const;
+
+private:
+    int _target_fps  = 0;
+    Uint64 _period   = 0; // performance counter ticks per frame
+    Uint64 _deadline = 0;
+};
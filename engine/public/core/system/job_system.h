@@ -0,0 +1,193 @@
+#pragma once
+
+#include "stdafx.h"
+
+/*!
+@file job_system.h
+    @brief JobSystem class definition.
+
+    Fixed pool of worker threads, each owning a Chase-Lev deque:
+    - The owner pushes and pops at the bottom (LIFO, cache friendly), idle workers steal from the top (FIFO)
+    - Jobs scheduled from other threads go through a shared injection queue
+    - `JobCounter` tracks pending jobs, jobs can wait on a counter before being released (job graphs)
+    - Threads blocked in `wait` keep executing jobs instead of sleeping
+    - Main thread jobs are only run by `run_main_thread_jobs`, use them for GL or window work
+
+    @ingroup System
+    @version 0.0.5
+
+*/
+
+struct Job;
+
+/*!
+
+    @brief Number of pending jobs, doubles as a dependency for other jobs
+
+    @note Must outlive every job scheduled on it.
+
+    @ingroup System
+    @version 0.0.5
+*/
+class JobCounter {
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    [[nodiscard]] bool is_done() const {
+        return _pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int> _pending{0};
+
+    mutable std::mutex _mutex;
+    std::vector<Job*> _waiting; // Released when `_pending` reaches 0
+};
+
+/*!
+
+    @brief Chase-Lev work stealing deque of fixed capacity
+
+    @note `push`/`pop` are owner only, `steal` is safe from any thread.
+
+    @ingroup System
+    @version 0.0.5
+*/
+class WorkStealingQueue {
+public:
+    static constexpr int64_t CAPACITY = 4096;
+
+    bool push(Job* job);
+
+    Job* pop();
+
+    Job* steal();
+
+    [[nodiscard]] bool is_empty() const;
+
+private:
+    static constexpr int64_t MASK = CAPACITY - 1;
+
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+
+    std::array<std::atomic<Job*>, CAPACITY> _buffer{};
+};
+
+class JobSystem {
+public:
+    using JobFn   = std::function<void()>;
+    using RangeFn = std::function<void(int begin, int end)>;
+
+    JobSystem() = default;
+
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /*!
+        @brief Start the workers
+        @param worker_count Number of worker threads, -1 = hardware threads minus `reserved_threads`, 0 = run every job inline
+        @param reserved_threads Threads kept free for the main (and render) thread when auto-detecting
+        @param use_affinity Pin worker N to core N + reserved_threads (Windows, Linux and Android only)
+    */
+    bool initialize(int worker_count, int reserved_threads = 1, bool use_affinity = false);
+
+    /*!
+        @brief Finish every scheduled job and join the workers
+    */
+    void shutdown();
+
+    [[nodiscard]] int get_worker_count() const;
+
+    /*!
+        @brief Worker index of the calling thread, -1 on any other thread
+    */
+    [[nodiscard]] static int get_worker_index();
+
+    /*!
+        @param counter Incremented now, decremented when the job finished (optional)
+        @param dependency The job is held back until this counter is done (optional)
+    */
+    void schedule(JobFn fn, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+    /*!
+        @brief Block until `counter` is done, running jobs meanwhile
+    */
+    void wait(const JobCounter& counter);
+
+    /*!
+        @brief Split [0, count) in chunks over every worker and the calling thread, blocks until done
+
+        Chunks are taken guided: large at first, shrinking with the remaining work down to `min_chunk`,
+        so uneven iterations still balance without paying per index scheduling.
+    */
+    void parallel_for(int count, const RangeFn& fn, int min_chunk = 1);
+
+    /*!
+        @brief `parallel_for` calling `fn(i)` for every index
+    */
+    template <typename Fn>
+    void parallel_for_each(int count, Fn&& fn, int min_chunk = 1) {
+        parallel_for(count, [&fn](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                fn(i);
+            }
+        }, min_chunk);
+    }
+
+    /*!
+        @brief Queue a job that only runs on the main thread, during `run_main_thread_jobs`
+    */
+    void schedule_main_thread(JobFn fn, JobCounter* counter = nullptr);
+
+    /*!
+        @brief Run every queued main thread job, called once per frame by the engine
+    */
+    void run_main_thread_jobs();
+
+private:
+    struct Worker {
+        JobSystem* owner = nullptr;
+        SDL_Thread* thread = nullptr;
+        WorkStealingQueue queue;
+        int index = 0;
+        int core  = -1;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::mutex _injection_mutex;
+    std::deque<Job*> _injection_queue;
+
+    std::mutex _main_thread_mutex;
+    std::deque<Job*> _main_thread_queue;
+
+    std::mutex _sleep_mutex;
+    std::condition_variable _sleep_cv;
+    std::atomic<int> _queued{0}; // Jobs sitting in any queue, workers sleep when 0
+    std::atomic<int> _sleeping{0};
+    std::atomic<bool> _running{false};
+
+    std::thread::id _main_thread_id;
+
+    static int worker_entry(void* data);
+
+    void worker_loop(Worker& worker);
+
+    void enqueue(Job* job);
+
+    Job* find_job(int worker_index);
+
+    void execute(Job* job);
+
+    void finish(Job* job);
+};
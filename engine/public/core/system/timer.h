@@ -13,16 +13,30 @@
 */
 class Timer {
 public:
+    static constexpr int MAX_FIXED_STEPS = 5; /// Spiral-of-death guard, simulation time is dropped past this
+
     double delta;
     double elapsed_time;
 
+    double fixed_delta = 0.0; /// Fixed simulation step (1 / physics_fps), 0 = variable step
+    double alpha       = 1.0; /// Interpolation factor between the last two simulation states
+
     int get_fps() const;
 
     void start();
 
     void tick();
 
+    void set_fixed_rate(int steps_per_second);
+
+    /*!
+        @brief Accumulate the frame delta and return how many fixed steps to simulate this frame
+    */
+    int accumulate_fixed_steps();
+
 private:
     Uint64 now;
     Uint64 last;
+
+    double accumulator = 0.0;
 };
\ No newline at end of file
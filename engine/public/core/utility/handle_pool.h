@@ -0,0 +1,182 @@
+#pragma once
+#include "stdafx.h"
+
+/*!
+
+   @brief 32-bit generational handle: 20 bits slot index, 12 bits generation
+
+   - `0` is the null handle, generations start at 1
+   - A handle whose slot was freed (and maybe reused) no longer validates
+
+   @version 0.0.5
+*/
+template <typename Tag>
+struct Handle {
+    static constexpr Uint32 INDEX_BITS      = 20;
+    static constexpr Uint32 INDEX_MASK      = (1u << INDEX_BITS) - 1;
+    static constexpr Uint32 GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+    Uint32 value = 0;
+
+    static Handle make(Uint32 index, Uint32 generation) {
+        return {(generation << INDEX_BITS) | index};
+    }
+
+    [[nodiscard]] Uint32 index() const {
+        return value & INDEX_MASK;
+    }
+
+    [[nodiscard]] Uint32 generation() const {
+        return value >> INDEX_BITS;
+    }
+
+    [[nodiscard]] bool is_null() const {
+        return value == 0;
+    }
+
+    bool operator==(const Handle& other) const = default;
+};
+
+struct HandleHash {
+    template <typename Tag>
+    std::size_t operator()(const Handle<Tag>& handle) const {
+        return std::hash<Uint32>{}(handle.value);
+    }
+};
+
+/*!
+
+   @brief Slot map storing `Hot` data contiguously and `Cold` data in a parallel array
+
+   - `create`, `destroy` and validated `get` are O(1)
+   - Dense arrays stay packed (swap remove), iterate `hot()` for cache friendly passes
+   - Pointers returned by `get` are invalidated by `create`/`destroy`, keep handles instead
+
+   @note Not thread safe, mutate it where it is read (renderer pools: on the render thread).
+
+   @version 0.0.5
+*/
+template <typename Tag, typename Hot, typename Cold>
+class HandlePool {
+public:
+    using HandleType = Handle<Tag>;
+
+    static constexpr Uint32 MAX_SLOTS = HandleType::INDEX_MASK + 1;
+
+    HandleType create(Hot hot, Cold cold) {
+        Uint32 index = 0;
+
+        if (!_free_slots.empty()) {
+            index = _free_slots.back();
+            _free_slots.pop_back();
+        } else {
+            if (_slots.size() >= MAX_SLOTS) {
+                spdlog::error("HandlePool::create - Out of slots ({})", MAX_SLOTS);
+                return {};
+            }
+
+            index = static_cast<Uint32>(_slots.size());
+            _slots.push_back({});
+        }
+
+        auto& slot = _slots[index];
+        slot.dense = static_cast<Uint32>(_hot.size());
+
+        _hot.push_back(std::move(hot));
+        _cold.push_back(std::move(cold));
+        _dense_slots.push_back(index);
+
+        return HandleType::make(index, slot.generation);
+    }
+
+    bool destroy(HandleType handle) {
+        if (!is_valid(handle)) {
+            return false;
+        }
+
+        auto& slot       = _slots[handle.index()];
+        const Uint32 last = static_cast<Uint32>(_hot.size()) - 1;
+
+        // Keep the dense arrays packed, the last element takes the freed place
+        if (slot.dense != last) {
+            _hot[slot.dense]         = std::move(_hot[last]);
+            _cold[slot.dense]        = std::move(_cold[last]);
+            _dense_slots[slot.dense] = _dense_slots[last];
+            _slots[_dense_slots[slot.dense]].dense = slot.dense;
+        }
+
+        _hot.pop_back();
+        _cold.pop_back();
+        _dense_slots.pop_back();
+
+        // Generation 0 is reserved for the null handle
+        slot.generation = (slot.generation % HandleType::GENERATION_MASK) + 1;
+        _free_slots.push_back(handle.index());
+
+        return true;
+    }
+
+    [[nodiscard]] bool is_valid(HandleType handle) const {
+        return !handle.is_null() && handle.index() < _slots.size() && _slots[handle.index()].generation == handle.generation();
+    }
+
+    Hot* get(HandleType handle) {
+        return is_valid(handle) ? &_hot[_slots[handle.index()].dense] : nullptr;
+    }
+
+    const Hot* get(HandleType handle) const {
+        return is_valid(handle) ? &_hot[_slots[handle.index()].dense] : nullptr;
+    }
+
+    Cold* get_cold(HandleType handle) {
+        return is_valid(handle) ? &_cold[_slots[handle.index()].dense] : nullptr;
+    }
+
+    const Cold* get_cold(HandleType handle) const {
+        return is_valid(handle) ? &_cold[_slots[handle.index()].dense] : nullptr;
+    }
+
+    /*!
+        @brief Call `fn(handle, hot, cold)` for every live element
+    */
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        for (size_t i = 0; i < _hot.size(); ++i) {
+            const Uint32 index = _dense_slots[i];
+            fn(HandleType::make(index, _slots[index].generation), _hot[i], _cold[i]);
+        }
+    }
+
+    std::span<Hot> hot() {
+        return _hot;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return _hot.size();
+    }
+
+    void clear() {
+        for (Uint32 index : _dense_slots) {
+            auto& slot      = _slots[index];
+            slot.generation = (slot.generation % HandleType::GENERATION_MASK) + 1;
+            _free_slots.push_back(index);
+        }
+
+        _hot.clear();
+        _cold.clear();
+        _dense_slots.clear();
+    }
+
+private:
+    struct Slot {
+        Uint32 dense      = 0;
+        Uint32 generation = 1;
+    };
+
+    std::vector<Hot> _hot;
+    std::vector<Cold> _cold;
+    std::vector<Uint32> _dense_slots; // Slot index of every dense element
+
+    std::vector<Slot> _slots;
+    std::vector<Uint32> _free_slots;
+};
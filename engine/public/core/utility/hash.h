@@ -0,0 +1,38 @@
+#pragma once
+#include "stdafx.h"
+
+constexpr Uint64 FNV1A_64_OFFSET = 0xcbf29ce484222325ULL;
+constexpr Uint64 FNV1A_64_PRIME  = 0x100000001b3ULL;
+
+/*!
+
+   @brief 64-bit FNV-1a hash, used to key on-disk caches by source content
+   - Pass a previous result as `seed` to hash several buffers in sequence
+
+   @version 0.0.5
+   @param data Bytes to hash
+   @param size Number of bytes
+   @param seed Initial hash value
+   @return Hash value
+*/
+inline Uint64 hash_fnv1a_64(const void* data, size_t size, Uint64 seed = FNV1A_64_OFFSET) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    Uint64 hash       = seed;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV1A_64_PRIME;
+    }
+
+    return hash;
+}
+
+/*!
+
+   @brief Hash value formatted as a fixed width hex string (cache file names)
+
+   @version 0.0.5
+*/
+inline std::string hash_to_string(Uint64 hash) {
+    return fmt::format("{:016x}", hash);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "core/component/components.h"
+
+enum class CookedTextureKind : Uint32 {
+    FILE,    /// `data` is a path relative to the model directory
+    ENCODED, /// `data` is an encoded image (png, jpg, ...) embedded in the model
+    RAW      /// `data` is `width * height` RGBA8 texels embedded in the model
+};
+
+struct CookedTexture {
+    CookedTextureKind kind = CookedTextureKind::FILE;
+    Uint32 width           = 0;
+    Uint32 height          = 0;
+    std::span<const unsigned char> data;
+};
+
+struct CookedMaterial {
+    Material material;                /// Factors only, the map ids are resolved from `textures`
+    std::array<Sint32, 6> textures{}; /// Index in `CookedModel::textures` per map (albedo, metallic, roughness, normal, ao, emissive), -1 = none
+};
+
+struct CookedMesh {
+    std::string_view name;
+    std::span<const Vertex> vertices;
+    std::span<const unsigned int> indices;
+    glm::vec3 bounds_center{0.0f};
+    float bounds_radius = 0.0f;
+    Uint32 material     = 0; /// Index in `CookedModel::materials`
+};
+
+struct CookedDependency {
+    std::string_view path; /// External file read by the import (OBJ .mtl, glTF .bin), as opened (`res://...`)
+    Uint64 hash = 0;       /// Of its contents when the model was imported
+};
+
+/*!
+
+   @brief Imported model as views over a `.gmesh` buffer (or the importer output while cooking)
+   - Views are only valid while the viewed memory is
+
+   @version 0.0.5
+*/
+struct CookedModel {
+    std::vector<CookedMesh> meshes;
+    std::vector<CookedMaterial> materials;
+    std::vector<CookedTexture> textures;
+    std::vector<CookedDependency> dependencies;
+};
+
+/*!
+
+   @brief `.gmesh` cooked model format, the final import result stored so warm loads skip Assimp
+
+   - Header, then fixed size mesh/material/texture records, then the vertex, index, name and texture blobs
+   - Every blob starts on a 16 bytes boundary, a memory mapped file is read in place (no parsing, no copy before upload)
+   - Files live in `user://cache/meshes/`, named after the hash of the source file and the import settings
+   - The external files the import read are stored with their hash, a cache hit is only used while they are unchanged
+   - `golias_cook` writes them next to the source instead (`model.glb` -> `model.glb.gmesh`), found by path without reading the source
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class MeshCache {
+public:
+    static constexpr Uint32 VERSION = 2;
+
+    /*!
+        @brief Cache key of a source file imported with `import_flags`
+        @note Only the main file is hashed, external references are checked on a hit (`has_current_dependencies`)
+    */
+    static Uint64 compute_key(std::span<const std::byte> source, Uint32 import_flags);
+
+    /*!
+        @brief Whether every external file `model` was imported from still has the hash it was cooked with
+    */
+    static bool has_current_dependencies(const CookedModel& model);
+
+    static std::string get_cache_path(Uint64 key);
+
+    static std::string get_cooked_path(const std::string& source_path);
+
+    /*!
+        @brief Serialize `model` to the `.gmesh` layout
+    */
+    static std::vector<char> write(const CookedModel& model);
+
+    /*!
+        @brief Validate a `.gmesh` buffer and fill `out` with views into it
+        @return false on a stale version or a truncated/corrupted file
+    */
+    static bool read(std::span<const std::byte> bytes, CookedModel& out);
+};
@@ -1,6 +1,22 @@
 #pragma once
 
 #include "core/renderer/renderer.h"
+#include "core/utility/mesh_cache.h"
+#include "core/io/mapped_file.h"
+
+/*!
+ *  @brief CPU side of a model load: cooked geometry and decoded textures, no GPU resource yet
+ */
+struct ImportedModel {
+    std::string path;
+    std::string directory; /// External textures are relative to it
+
+    std::unique_ptr<MappedFile> cache; /// Mapped `.gmesh` on a cache hit
+    std::vector<char> cooked_bytes;    /// Freshly cooked `.gmesh` on a miss
+
+    CookedModel cooked;                 /// Views into `cache` or `cooked_bytes`
+    std::vector<TextureImage> textures; /// Decoded `cooked.textures`
+};
 
 /*!
  *  @brief  Assimp Object Loader
@@ -11,28 +27,68 @@
  */
 class ObjectLoader {
 public:
+    /// Assimp post-processing applied on import, part of the `.gmesh` cache key
+    static constexpr unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices
+                                                 | aiProcess_GenSmoothNormals | aiProcess_OptimizeMeshes | aiProcess_OptimizeGraph;
+
     static MeshInstance3D load_mesh(const std::string& path);
 
+    /*!
+        @brief Load a model, from its `.gmesh` cache when the source, its external files and the import settings didn't change
+        - Cooked: a `.gmesh` shipped next to the source by golias_cook is used first
+        - Cache miss: Assimp import, cooked and written to `user://cache/meshes/` for the next launch
+        - Cache hit: the cache is memory mapped and uploaded as-is, Assimp is not involved
+    */
     static Model load_model(const std::string& path);
 
+    /*!
+        @brief CPU stage of `load_model`: cache lookup or Assimp import, then texture decoding
+        @note Doesn't touch the renderer, safe on worker threads (one importer per call)
+    */
+    static bool import_model(const std::string& path, ImportedModel& out);
+
+    /*!
+        @brief Assimp import of `source` (the content of `path`) cooked to the `.gmesh` layout
+        @param dependencies Filled with the external files the import opened (OBJ .mtl, glTF .bin)
+    */
+    static bool cook_model(const std::string& path, std::span<const std::byte> source, std::vector<char>& out,
+                           std::vector<std::string>* dependencies = nullptr);
+
+    /*!
+        @brief GPU stage of `load_model`: upload buffers and textures of an imported model (main thread)
+    */
+    static Model upload_model(const ImportedModel& imported);
+
+    /*!
+        @brief Compute the bounds of `mesh.geometry` and create its GPU buffers (on the render thread)
+    */
+    static void upload_geometry(MeshInstance3D& mesh);
+
 private:
     static std::string get_directory(const std::string& path);
 
+    /// res:// directory of a model, external files are relative to it
+    static std::string get_model_directory(const std::string& path);
 
-    static MeshInstance3D create_mesh(aiMesh* aiMesh);
+    /// Map a `.gmesh` into `out`, false when missing or stale
+    static bool map_mesh_cache(const std::string& cache_path, ImportedModel& out);
 
-    static Material load_material(const aiScene* scene, aiMesh* mesh,
-                                  const std::string& directory, Renderer& renderer);
+    static MeshGeometry create_geometry(const aiMesh* aiMesh);
 
-    static void load_colors(aiMaterial* aiMat, Material& mat);
+    static void compute_bounds(std::span<const Vertex> vertices, glm::vec3& center, float& radius);
+
+    static void upload_buffers(MeshInstance3D& mesh, std::span<const Vertex> vertices, std::span<const unsigned int> indices);
 
-    static void load_textures(aiMaterial* aiMat, const aiScene* scene,
-                              const std::string& dir, Renderer& renderer, Material& mat);
+    /*!
+        @brief Convert an imported scene to the `.gmesh` layout
+        @param dependencies External files the import read, stored to check a cache hit against
+    */
+    static std::vector<char> cook(const aiScene* scene, std::span<const CookedDependency> dependencies);
+
+    static void load_colors(aiMaterial* aiMat, Material& mat);
 
     static void parse_bones(aiMesh* mesh, Model& model);
 
 
     static void parse_animations(const aiScene* scene, Model& model);
 };
-
-
@@ -92,7 +92,11 @@ enum class TextureFiltering {
 struct Viewport {
     int width   = 640;
     int height  = 320;
-    float scale = 1.0f;
+    float scale = 1.0f; // Render scale of the main pass (upper bound when dynamic resolution is enabled)
+
+    bool dynamic_resolution = false; // Adapt the render scale to hold the Application::max_fps frame time
+    float min_scale         = 0.5f;
+    float sharpness         = 0.25f; // Upscale sharpening strength (0 = plain bilinear)
 
     ViewportMode mode        = ViewportMode::VIEWPORT;
     AspectRatio aspect_ratio = AspectRatio::KEEP;
@@ -120,10 +124,12 @@ struct Application {
     const char* package_name = "com.ember.engine.app"; // identifier
     const char* icon_path    = "res/icon.png";
     const char* description  = "EEngine";
-    int max_fps              = 60;
+    int max_fps              = 60; // 0 = unlimited
+    int background_fps       = 10; // Tick rate while the window is minimized or occluded
 
     bool is_fullscreen = false;
     bool is_resizable  = true;
+    bool is_on_demand  = false; // Only render frames when input, scene changes or Engine::request_redraw() happened
 
     bool load(const tinyxml2::XMLElement* root);
 };
@@ -136,6 +142,27 @@ struct Performance {
     bool is_multithreaded = false;
     int physics_fps       = 60;
     int worker_threads    = -1; // Default to -1 (auto-detect based on CPU cores)
+    bool is_thread_affinity = false; // Pin job system workers to cores
+    int io_threads          = 2;     // Reader threads of the async file I/O fallback
+    bool is_io_uring        = true;  // Linux: async file reads through io_uring
+    float script_gc_ms      = 1.0f;  // Max Lua collector time per frame, taken from the leftover frame time
+    bool is_script_gc_generational = true; // Lua 5.4 generational collector, incremental otherwise
+
+    bool load(const tinyxml2::XMLElement* root);
+};
+
+/*!
+ * @brief Pack archives and loose directories mounted on `res://` at startup, in order (later mounts win).
+ * @note `project.xml` itself is read before anything is mounted and stays a loose file.
+ * @ingroup Configuration
+ */
+struct Resources {
+    struct Mount {
+        bool is_pack = true;
+        std::string path;
+    };
+
+    std::vector<Mount> mounts;
 
     bool load(const tinyxml2::XMLElement* root);
 };
@@ -147,12 +174,27 @@ struct Performance {
 struct RendererDevice {
     Backend backend                    = Backend::AUTO;
     TextureFiltering texture_filtering = TextureFiltering::NEAREST;
+    int texture_budget_mb              = 0; // VRAM budget for streamed textures, 0 = no streaming (full residency)
 
     bool load(const tinyxml2::XMLElement* root);
 
     [[nodiscard]] const char* get_backend_str() const;
 };
 
+/*!
+ * @brief Audio device settings.
+ * @ingroup Configuration
+ */
+struct AudioDevice {
+    bool is_enabled     = true;
+    bool is_null_device = false; // Mix without a sound card (servers, headless tests)
+    bool is_offline     = false; // No device, output is only mixed by AudioSystem::render (benchmarks)
+    int max_voices      = 32;    // Sources mixed at once, the least important ones are virtualized
+    int sample_rate     = 0;     // 0 = device default
+
+    bool load(const tinyxml2::XMLElement* root);
+};
+
 enum class WindowMode { WINDOWED, /// Windowed mode.
     MAXIMIZED, /// Maximized mode.
     MINIMIZED, /// Minimized mode.
@@ -194,6 +236,10 @@ struct EngineConfig {
 
     Performance& get_performance();
 
+    Resources& get_resources();
+
+    AudioDevice& get_audio_device();
+
     Application& get_application();
 
     Environment& get_environment();
@@ -217,6 +263,10 @@ private:
 
     Performance _performance;
 
+    Resources _resources;
+
+    AudioDevice _audio_device;
+
     Window _window;
 
     bool _is_vsync_enabled = true;
@@ -0,0 +1,42 @@
+#pragma once
+#include "stdafx.h"
+
+/*!
+
+   @brief Decoded image as a view over a `.gtex` buffer
+   - `pixels` is only valid while the viewed memory is
+
+   @version 0.0.5
+*/
+struct CookedImage {
+    Uint32 width    = 0;
+    Uint32 height   = 0;
+    Uint32 channels = 0;
+    std::span<const unsigned char> pixels;
+};
+
+/*!
+
+   @brief `.gtex` cooked texture format, written by `golias_cook` next to the source image (`icon.png` -> `icon.png.gtex`)
+
+   - Header, then the base level texels as decoded by stb_image (channel count of the source kept)
+   - Texels start on a 16 bytes boundary, a stored pack entry is uploaded straight from the mapping
+   - Mips are still built at upload, the texture budget decides which ones are resident
+
+   @ingroup FileSystem
+   @version 0.0.5
+*/
+class TextureCache {
+public:
+    static constexpr Uint32 VERSION = 1;
+
+    static std::string get_cooked_path(const std::string& source_path);
+
+    static std::vector<char> write(const unsigned char* pixels, Uint32 width, Uint32 height, Uint32 channels);
+
+    /*!
+        @brief Validate a `.gtex` buffer and fill `out` with a view into it
+        @return false on a stale version or a truncated file
+    */
+    static bool read(std::span<const std::byte> bytes, CookedImage& out);
+};
@@ -13,6 +13,8 @@
 #define EMISSIVE_TEXTURE_UNIT 5
 #define SHADOW_TEXTURE_UNIT 6
 #define ENVIRONMENT_TEXTURE_UNIT 7
+#define PREFILTER_TEXTURE_UNIT 8
+#define BRDF_LUT_TEXTURE_UNIT 9
 
 /*!
 * @defgroup Components
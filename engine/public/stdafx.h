@@ -18,13 +18,18 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <functional>
 #include <mutex>
+#include <thread>
+#include <atomic>
 #include <map>
 #include <deque>
 #include <condition_variable>
+#include <future>
 #include <random>
+#include <span>
 
 #include <glad.h>
 
@@ -527,4 +527,35 @@ BUTTON_MASK = {
 ---@type Scene
 
 ---Current entity (available in entity scripts)
----@type Entity
\ No newline at end of file
+---@type Entity
+
+---Entity handle passed to `ready(entity)` and `update(entity, dt)` of Script components (light userdata)
+---@class EntityHandle
+
+---One vec3 field of every row of a TransformView, over the table storage (rows are 1-based)
+---@class Vec3Column
+---@field get fun(self: Vec3Column, row: integer): number, number, number
+---@field set fun(self: Vec3Column, row: integer, x: number, y: number, z: number)
+
+---Rows of one table with a Transform3D, only valid inside the `ecs.each_transform` callback it was passed to (`#view` rows)
+---@class TransformView
+---@field position Vec3Column
+---@field rotation Vec3Column
+---@field scale Vec3Column
+---@field entity fun(self: TransformView, row: integer): EntityHandle
+
+---Component access of scripted entities, values are read and written in place without allocating
+---@class ecs
+---@field get_position fun(entity: EntityHandle): number, number, number
+---@field set_position fun(entity: EntityHandle, x: number, y: number, z: number)
+---@field get_rotation fun(entity: EntityHandle): number, number, number
+---@field set_rotation fun(entity: EntityHandle, x: number, y: number, z: number)
+---@field get_scale fun(entity: EntityHandle): number, number, number
+---@field set_scale fun(entity: EntityHandle, x: number, y: number, z: number)
+---@field is_alive fun(entity: EntityHandle): boolean
+---@field get_id fun(entity: EntityHandle): integer
+---@field get_name fun(entity: EntityHandle): string?
+---@field lookup fun(name: string): EntityHandle?
+---@field destruct fun(entity: EntityHandle) Deleted at the end of the step
+---@field each_transform fun(fn: fun(view: TransformView)) Calls `fn` once per table of non-static entities, thousands of entities per call (not in parallel scripts)
+ecs = {}
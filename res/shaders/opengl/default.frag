@@ -48,7 +48,13 @@ uniform sampler2D NORMAL_MAP;
 uniform sampler2D AO_MAP;
 uniform sampler2D EMISSIVE_MAP;
 uniform sampler2D SHADOW_MAP;
-uniform samplerCube ENVIRONMENT_MAP; // environment cubemap for reflection/refraction/IBL
+uniform samplerCube ENVIRONMENT_MAP; // environment cubemap for reflection/refraction
+uniform samplerCube PREFILTER_MAP;   // GGX prefiltered environment, roughness = lod / PREFILTER_MAX_LOD
+uniform sampler2D BRDF_LUT;          // split-sum BRDF integration (x = NdotV, y = roughness)
+
+// Baked diffuse irradiance (9 SH coefficients, already convolved and divided by PI)
+uniform vec3 IRRADIANCE_SH[9];
+uniform float PREFILTER_MAX_LOD;
 
 // Usage flags
 uniform bool USE_ALBEDO_MAP;
@@ -233,14 +239,28 @@ vec3 sample_refraction(vec3 I, vec3 N, float eta)
 }
 
 // ============================================================================
-// Image-Based Lighting (IBL) using Environment Map
+// Image-Based Lighting (IBL) using baked environment data
 // ============================================================================
-// Approximates IBL by sampling the environment map at different mip levels
-// Lower mip levels = sharper reflections (low roughness)
-// Higher mip levels = blurrier reflections (high roughness)
+// Diffuse irradiance is evaluated from 9 SH coefficients, specular uses the
+// prefiltered cubemap (one roughness step per mip) and the split-sum BRDF LUT.
+// Everything is baked once on the CPU by EnvironmentBaker and cached on disk.
 // References:
-// - https://learnopengl.com/PBR/IBL/Diffuse-irradiance
+// - Ramamoorthi & Hanrahan, "An Efficient Representation for Irradiance Environment Maps"
+// - Brian Karis, "Real Shading in Unreal Engine 4"
 // - https://learnopengl.com/PBR/IBL/Specular-IBL
+vec3 evaluate_irradiance_sh(vec3 n)
+{
+    return IRRADIANCE_SH[0] * 0.282095
+         + IRRADIANCE_SH[1] * 0.488603 * n.y
+         + IRRADIANCE_SH[2] * 0.488603 * n.z
+         + IRRADIANCE_SH[3] * 0.488603 * n.x
+         + IRRADIANCE_SH[4] * 1.092548 * n.x * n.y
+         + IRRADIANCE_SH[5] * 1.092548 * n.y * n.z
+         + IRRADIANCE_SH[6] * 0.315392 * (3.0 * n.z * n.z - 1.0)
+         + IRRADIANCE_SH[7] * 1.092548 * n.x * n.z
+         + IRRADIANCE_SH[8] * 0.546274 * (n.x * n.x - n.y * n.y);
+}
+
 vec3 calculate_ibl(
     vec3 N,
     vec3 V,
@@ -259,15 +279,12 @@ vec3 calculate_ibl(
     vec3 kS = F;
     vec3 kD = (1.0 - kS) * (1.0 - metallic);
 
-    const float DIFFUSE_MIP = 5.0;
-    vec3 irradiance = textureLod(ENVIRONMENT_MAP, N, DIFFUSE_MIP).rgb;
+    vec3 irradiance = max(evaluate_irradiance_sh(N), vec3(0.0));
     vec3 diffuse = kD * irradiance * albedo;
 
-    const float MAX_REFLECTION_LOD = 7.0;
-    float lod = roughness * MAX_REFLECTION_LOD;
-    vec3 prefilteredColor = textureLod(ENVIRONMENT_MAP, R, lod).rgb;
+    vec3 prefilteredColor = textureLod(PREFILTER_MAP, R, roughness * PREFILTER_MAX_LOD).rgb;
 
-    vec2 envBRDF = vec2(1.0 - roughness, 1.0 - roughness);
+    vec2 envBRDF = texture(BRDF_LUT, vec2(NdotV, roughness)).rg;
     vec3 specular = prefilteredColor * (F * envBRDF.x + envBRDF.y);
 
     return (diffuse + specular) * ao;
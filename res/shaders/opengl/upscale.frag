@@ -0,0 +1,35 @@
+in vec2 UV;
+out vec4 COLOR;
+
+uniform sampler2D TEXTURE;
+uniform vec2 TEXEL_SIZE;  // 1 / offscreen target size
+uniform vec2 UV_MAX;      // last valid texel center of the scaled render
+uniform float SHARPNESS;  // 0 = plain bilinear
+
+vec3 fetch(vec2 uv)
+{
+    return texture(TEXTURE, min(uv, UV_MAX)).rgb;
+}
+
+// Bilinear upscale followed by a clamped cross-shaped sharpen (no ringing:
+// the result never leaves the min/max of its neighbourhood).
+// Reference: AMD FidelityFX CAS (simplified)
+void main()
+{
+    vec3 center = fetch(UV);
+
+    if (SHARPNESS > 0.0) {
+        vec3 north = fetch(UV + vec2(0.0, TEXEL_SIZE.y));
+        vec3 south = fetch(UV - vec2(0.0, TEXEL_SIZE.y));
+        vec3 east  = fetch(UV + vec2(TEXEL_SIZE.x, 0.0));
+        vec3 west  = fetch(UV - vec2(TEXEL_SIZE.x, 0.0));
+
+        vec3 lo = min(center, min(min(north, south), min(east, west)));
+        vec3 hi = max(center, max(max(north, south), max(east, west)));
+
+        vec3 sharpened = center + (4.0 * center - north - south - east - west) * 0.25 * SHARPNESS;
+        center = clamp(sharpened, lo, hi);
+    }
+
+    COLOR = vec4(center, 1.0);
+}
@@ -0,0 +1,11 @@
+out vec2 UV;
+
+// Fraction of the offscreen target covered by the scaled render
+uniform vec2 UV_SCALE;
+
+void main() {
+    // Fullscreen triangle, no vertex buffer needed
+    vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    UV = position * UV_SCALE;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -102,6 +102,8 @@ int main(int argc, char* argv[]) {
                          });
 
     // TODO: create api for lights and camera
+    load_models_async({"res://sprites/obj/DamagedHelmet.glb", "res://sprites/obj/nagonford/Nagonford_Animated.glb"})->wait();
+
     create_model_entity("dmg_helmet", "res://sprites/obj/DamagedHelmet.glb",
                        glm::vec3(10, 0, -5));
 
@@ -110,59 +112,50 @@ int main(int argc, char* argv[]) {
 
     create_mesh_entity("Cylinder", "res://models/cylinder.obj",
                       glm::vec3(0, 0, -15), glm::vec3(0), glm::vec3(1.0f),
-                      "green_metal");
+                      "green_metal").add<Static>();
 
     create_mesh_entity("Torus", "res://models/torus.obj",
                       glm::vec3(0, 0, 5), glm::vec3(0), glm::vec3(1.0f),
-                      "pink_emissive");
+                      "pink_emissive").add<Static>();
 
     create_mesh_entity("Cone", "res://models/cone.obj",
                       glm::vec3(0, 0, 15), glm::vec3(0), glm::vec3(1.0f),
-                      "yellow");
+                      "yellow").add<Static>();
 
     create_mesh_entity("BlenderMonkey", "res://models/blender_monkey.obj",
                       glm::vec3(-10, 0, 10), glm::vec3(0), glm::vec3(1.0f),
-                      "cyan");
+                      "cyan").add<Static>();
 
     create_mesh_entity("Plane", "res://models/plane.obj",
                       glm::vec3(0, -0.5, 0), glm::vec3(0), glm::vec3(10.0f),
-                      "ground_gray");
+                      "ground_gray").add<Static>();
 
     std::mt19937 rng(std::random_device{}());
     std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
 
 
-    for (int i = 0; i < 100; ++i) {
-        float x = 30.0f + dist(rng);
-        float y = 30.0f + dist(rng);
-        float z = 30.0f + dist(rng);
-
-        std::string name = "Cube_" + std::to_string(i);
-        create_mesh_entity(
-            name.c_str(),
-            "res://models/cube.obj",
-            glm::vec3(x, y, z),
-            glm::vec3(0.0f),
-            glm::vec3(1.0f),
-            "blue_metal"
-        );
+    std::vector<Transform3D> cubes(100);
+    for (auto& cube : cubes) {
+        cube.position = glm::vec3(30.0f + dist(rng), 30.0f + dist(rng), 30.0f + dist(rng));
     }
 
+    create_mesh_entities("res://models/cube.obj", cubes, "blue_metal", true, "Cube");
+
     create_mesh_entity("Red Cube", "res://models/cube.obj",
                       glm::vec3(3, 0, 0), glm::vec3(0), glm::vec3(1.5f),
-                      "red_rough");
+                      "red_rough").add<Static>();
 
     create_mesh_entity("Metallic Sphere", "res://models/sphere.obj",
                       glm::vec3(-3, 0, 0), glm::vec3(0), glm::vec3(1.5f),
-                      "green_shiny");
+                      "green_shiny").add<Static>();
 
     create_mesh_entity("SmallCube", "res://models/cube.obj",
                       glm::vec3(-3, 0, 0), glm::vec3(0), glm::vec3(0.5f),
-                      "blue_metal");
+                      "blue_metal").add<Static>();
 
     create_mesh_entity("Ground", "res://models/cube.obj",
                       glm::vec3(0, -2, 0), glm::vec3(0), glm::vec3(1000.0f, 0.1f, 1000.0f),
-                      "dark_metal_ground");
+                      "dark_metal_ground").add<Static>();
 
     GEngine->run();
 
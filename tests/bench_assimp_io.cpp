@@ -0,0 +1,113 @@
+#include "core/engine.h"
+#include "core/io/assimp_io.h"
+#include "core/io/mapped_file.h"
+#include "bench_common.h"
+
+/*
+    Assimp import time of a large glb depending on how the file reaches the importer
+
+    reread: stream re-reading the whole file on every Read/Seek/FileSize (previous SDLIOStream behavior)
+    mapped: MappedIOSystem, the file is mapped once and Read is a memcpy
+    memory: ReadFileFromMemory over the mapping, what ObjectLoader does
+
+    Only reading is measured, post-processing is disabled.
+*/
+
+constexpr const char* MODEL_DIR  = "res/sprites/obj/nagonford/";
+constexpr const char* MODEL_FILE = "Nagonford_Animated.glb";
+constexpr int RUNS               = 3;
+
+class RereadIOStream : public Assimp::IOStream {
+public:
+    explicit RereadIOStream(const std::string& path) : _file(path) {
+    }
+
+    size_t Read(void* buffer, size_t size, size_t count) override {
+        const auto bytes   = _file.get_file_as_bytes();
+        const size_t total = std::min(size * count, bytes.size() - _position);
+        SDL_memcpy(buffer, bytes.data() + _position, total);
+        _position += total;
+        return total / size;
+    }
+
+    size_t Write(const void*, size_t, size_t) override {
+        return 0;
+    }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override {
+        const size_t size = _file.get_file_as_bytes().size();
+        _position         = origin == aiOrigin_SET ? offset : origin == aiOrigin_CUR ? _position + offset : size - offset;
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override {
+        return _position;
+    }
+
+    size_t FileSize() const override {
+        return const_cast<FileAccess&>(_file).get_file_as_bytes().size();
+    }
+
+    void Flush() override {
+    }
+
+    FileAccess _file;
+    size_t _position = 0;
+};
+
+class RereadIOSystem : public Assimp::IOSystem {
+public:
+    bool Exists(const char* file) const override {
+        return FileAccess::file_exists(std::string(MODEL_DIR) + file);
+    }
+
+    char getOsSeparator() const override {
+        return '/';
+    }
+
+    Assimp::IOStream* Open(const char* file, const char*) override {
+        auto* stream = new RereadIOStream(std::string(MODEL_DIR) + file);
+        if (!stream->_file.is_open()) {
+            delete stream;
+            return nullptr;
+        }
+        return stream;
+    }
+
+    void Close(Assimp::IOStream* file) override {
+        delete file;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const MappedFile model(std::string(MODEL_DIR) + MODEL_FILE);
+    if (!model.is_open()) {
+        printf("%s%s not found\n", MODEL_DIR, MODEL_FILE);
+        return -1;
+    }
+
+    const double reread_ms = measure_ms([] {
+        Assimp::Importer importer;
+        importer.SetIOHandler(new RereadIOSystem());
+        importer.ReadFile(MODEL_FILE, 0);
+    }, RUNS);
+
+    const double mapped_ms = measure_ms([] {
+        Assimp::Importer importer;
+        importer.SetIOHandler(new MappedIOSystem(MODEL_DIR));
+        importer.ReadFile(MODEL_FILE, 0);
+    }, RUNS);
+
+    const double memory_ms = measure_ms([&model] {
+        Assimp::Importer importer;
+        importer.SetIOHandler(new MappedIOSystem(MODEL_DIR));
+        importer.ReadFileFromMemory(model.data(), model.size(), 0, "glb");
+    }, RUNS);
+
+    printf("%s%s (%.1f MB)\n", MODEL_DIR, MODEL_FILE, static_cast<double>(model.size()) / (1024.0 * 1024.0));
+    printf("reread stream: %8.2f ms\n", reread_ms);
+    printf("mapped stream: %8.2f ms  x%.1f\n", mapped_ms, reread_ms / mapped_ms);
+    printf("from memory:   %8.2f ms  x%.1f\n", memory_ms, reread_ms / memory_ms);
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "core/engine.h"
+
+#include <fstream>
+
+/*
+    Mixer cost per voice count, rendered offline (no device) so runs are repeatable and faster than real time
+
+    SOURCES looping emitters on a ring around the listener, the audio system mixes the `max_voices` most audible ones.
+    The simulation ticks every 10 ms of audio (one 480 frame period at 48 kHz), like a game frame feeding a device.
+    An underrun is a period that took longer to mix than to play.
+*/
+
+constexpr int SOURCES          = 512;
+constexpr float SECONDS        = 10.0f;
+constexpr Uint32 PERIOD_FRAMES = 480;
+constexpr const char* SOUND    = "bench_audio_mix.wav";
+
+void write_sound() {
+    constexpr Uint32 sample_rate = 48000;
+    constexpr Uint32 data_size   = sample_rate * 2;
+
+    std::ofstream file(SOUND, std::ios::binary);
+
+    const auto put = [&file](auto value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+    file.write("RIFF", 4);
+    put(Uint32{36 + data_size});
+    file.write("WAVEfmt ", 8);
+    put(Uint32{16});
+    put(Uint16{1});
+    put(Uint16{1});
+    put(sample_rate);
+    put(Uint32{sample_rate * 2});
+    put(Uint16{2});
+    put(Uint16{16});
+    file.write("data", 4);
+    put(data_size);
+
+    for (Uint32 i = 0; i < sample_rate; ++i) {
+        put(static_cast<Sint16>(std::sin(static_cast<float>(i) * 0.05f) * 4000.0f));
+    }
+}
+
+void run(int max_voices) {
+    AudioDevice device;
+    device.is_offline  = true;
+    device.max_voices  = max_voices;
+    device.sample_rate = 48000;
+
+    // Outlives the world, `ReleaseAudioVoice` runs on it while the world deletes its entities
+    AudioSystem audio;
+    flecs::world world;
+
+    if (!audio.initialize(device)) {
+        return;
+    }
+
+    audio.setup(world);
+
+    world.entity().set(Transform3D{}).set(AudioListener{});
+
+    for (int i = 0; i < SOURCES; i++) {
+        const float angle  = static_cast<float>(i) / SOURCES * 360.0f;
+        const float radius = 2.0f + static_cast<float>(i % 50);
+
+        AudioSource source;
+        source.path       = SOUND;
+        source.is_looping = true;
+
+        world.entity()
+             .set<Transform3D>({.position = {cos(glm::radians(angle)) * radius, 0.0f, sin(glm::radians(angle)) * radius}})
+             .set<AudioSource>(source);
+    }
+
+    // First update decodes the sample, kept out of the timings
+    audio.update(0.0f);
+    audio.reset_mixer_stats();
+
+    std::vector<float> output;
+    output.reserve(static_cast<size_t>(SECONDS * 48000.0f) * 2);
+
+    constexpr float tick = static_cast<float>(PERIOD_FRAMES) / 48000.0f;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (float time = 0.0f; time < SECONDS; time += tick) {
+        audio.update(tick);
+        audio.render(tick, output, PERIOD_FRAMES);
+    }
+
+    const double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    const MixerStats stats = audio.get_mixer_stats();
+
+    printf("%4d voices: %.4f ms/callback (max %.4f), %llu callbacks, %llu underruns, %.1fx real time\n", audio.get_stats().voices,
+           stats.average_ms, stats.max_ms, static_cast<unsigned long long>(stats.callbacks), static_cast<unsigned long long>(stats.underruns),
+           SECONDS * 1000.0 / wall_ms);
+
+    audio.shutdown();
+}
+
+int main() {
+    write_sound();
+
+    printf("%d sources, %.0f s of audio, %u frames per callback\n", SOURCES, SECONDS, PERIOD_FRAMES);
+
+    for (const int voices : {8, 32, 64, 128, 256}) {
+        run(voices);
+    }
+
+    std::remove(SOUND);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "core/engine.h"
+#include "bench_common.h"
+
+/*
+    Spawning cost of mesh entities
+
+    per entity: create_mesh_entity, mesh/material lookups by string, a named entity and three `set` per entity
+    bulk:       create_mesh_entities, one lookup and a single ecs_bulk_init filling the table columns
+*/
+
+constexpr int PER_ENTITY_COUNT = 100'000;
+constexpr int BULK_COUNT       = 1'000'000;
+
+std::vector<Transform3D> make_transforms(int count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-500.0f, 500.0f);
+
+    std::vector<Transform3D> transforms(count);
+    for (auto& transform : transforms) {
+        transform.position = {dist(rng), dist(rng), dist(rng)};
+    }
+    return transforms;
+}
+
+int main(int argc, char* argv[]) {
+    if (!GEngine->initialize(1280, 720, "Bulk spawn benchmark")) {
+        return -1;
+    }
+
+    create_material("bench", Material{});
+
+    // Loads the mesh once, kept out of the measurements
+    create_mesh_entities("res://models/cube.obj", make_transforms(1), "bench");
+
+    const auto small = make_transforms(PER_ENTITY_COUNT);
+    const auto large = make_transforms(BULK_COUNT);
+
+    const double per_entity_ms = measure_ms([&] {
+        for (int i = 0; i < PER_ENTITY_COUNT; ++i) {
+            const std::string name = "Cube_" + std::to_string(i);
+            create_mesh_entity(name.c_str(), "res://models/cube.obj", small[i].position, small[i].rotation, small[i].scale, "bench");
+        }
+    });
+
+    const double bulk_named_ms = measure_ms([&] {
+        create_mesh_entities("res://models/cube.obj", small, "bench", false, "NamedCube");
+    });
+
+    const double bulk_ms = measure_ms([&] {
+        create_mesh_entities("res://models/cube.obj", large, "bench");
+    });
+
+    const double bulk_static_ms = measure_ms([&] {
+        create_mesh_entities("res://models/cube.obj", large, "bench", true);
+    });
+
+    printf("per entity (%d, named):  %8.2f ms  %6.3f us/entity\n", PER_ENTITY_COUNT, per_entity_ms, per_entity_ms * 1000.0 / PER_ENTITY_COUNT);
+    printf("bulk (%d, named):        %8.2f ms  %6.3f us/entity\n", PER_ENTITY_COUNT, bulk_named_ms, bulk_named_ms * 1000.0 / PER_ENTITY_COUNT);
+    printf("bulk (%d, anonymous):   %8.2f ms  %6.3f us/entity\n", BULK_COUNT, bulk_ms, bulk_ms * 1000.0 / BULK_COUNT);
+    printf("bulk (%d, static):      %8.2f ms  %6.3f us/entity\n", BULK_COUNT, bulk_static_ms, bulk_static_ms * 1000.0 / BULK_COUNT);
+
+    return 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <chrono>
+
+/// Wall time of `fn` in milliseconds, averaged over `runs` calls
+template <typename Fn>
+double measure_ms(Fn&& fn, int runs = 1) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        fn();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / runs;
+}
@@ -0,0 +1,99 @@
+#include "core/engine.h"
+#include "bench_common.h"
+
+/*
+    Per-frame ECS overhead, 10k entities laid out like example_orbit_cubes_3d
+
+    before: camera input and light/camera/drawable gathering with uncached `world.each` / `world.query` every frame
+    after:  registered systems (engine_setup_systems) with cached queries, extraction through the RenderExtract pipeline,
+            only changed tables produce proxy updates (a static scene sends nothing after the first frame)
+*/
+
+constexpr int FRAMES         = 500;
+constexpr int ENTITIES_COUNT = 10000;
+
+void populate(flecs::world& world, MeshHandle mesh, MaterialHandle material) {
+    Camera3D camera;
+    world.entity("MainCamera").set<Camera3D>(camera).set<Transform3D>({.position = {0, 10, 20}});
+    world.entity("Sun").set<Transform3D>({}).set<DirectionalLight>({});
+
+    for (int i = 0; i < ENTITIES_COUNT; i++) {
+        const float angle  = static_cast<float>(i) / ENTITIES_COUNT * 360.0f;
+        const float radius = 50.0f + static_cast<float>(rand() % 100);
+
+        world.entity()
+             .set<Transform3D>({.position = {cos(glm::radians(angle)) * radius, 0.0f, sin(glm::radians(angle)) * radius},
+                                .rotation = {0, static_cast<float>(rand() % 360), 0}})
+             .set<MeshRef>({mesh})
+             .set<MaterialRef>({material});
+    }
+}
+
+void frame_before(flecs::world& world, RenderSnapshot& snapshot, const bool* keys) {
+    snapshot.clear();
+
+    world.each([&](flecs::entity e, Transform3D& transform, Camera3D& camera) {
+        if (keys[SDL_SCANCODE_W]) camera.move_forward(transform, 0.016f);
+    });
+
+    world.progress(1.0f / 60.0f);
+
+    world.each([&](const Camera3D& cam, const Transform3D& transform) {
+        snapshot.camera           = cam;
+        snapshot.camera_transform = transform;
+    });
+
+    world.each([&](flecs::entity e, Transform3D& t, DirectionalLight& light) {
+        snapshot.directional_lights.push_back(light);
+    });
+
+    world.each([&](flecs::entity e, Transform3D& t, SpotLight& light) {
+        snapshot.spot_lights.emplace_back(t, light);
+    });
+
+    world.query<const Transform3D, const MeshRef, const MaterialRef>()
+         .each([&](flecs::entity e, const Transform3D& transform, const MeshRef& mesh, const MaterialRef& material) {
+             snapshot.proxy_updates.push_back({e.id(), transform, mesh, material});
+         });
+}
+
+int main() {
+    // Never resolved, extraction only copies the handles
+    const MeshHandle mesh         = MeshHandle::make(0, 1);
+    const MaterialHandle material = MaterialHandle::make(0, 1);
+    bool keys[SDL_SCANCODE_COUNT] = {};
+
+    double before_ms = 0.0;
+    {
+        flecs::world world;
+        RenderSnapshot snapshot;
+        populate(world, mesh, material);
+
+        before_ms = measure_ms([&] { frame_before(world, snapshot, keys); }, FRAMES);
+    }
+
+    auto run_after = [&](int threads) {
+        auto& world = GEngine->get_world();
+        engine_setup_systems(world);
+        world.get_mut<InputState>().keys = keys;
+        populate(world, mesh, material);
+
+        if (threads > 1) {
+            world.set_threads(threads);
+        }
+
+        return measure_ms([&] {
+            world.progress(1.0f / 60.0f);
+            engine_extract_frame();
+            GEngine->get_frame_snapshot().clear();
+        }, FRAMES);
+    };
+
+    const double after_ms = run_after(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+
+    printf("%d entities, %d frames\n", ENTITIES_COUNT, FRAMES);
+    printf("before (world.each per frame): %.3f ms/frame\n", before_ms);
+    printf("after  (systems + pipeline):   %.3f ms/frame\n", after_ms);
+
+    return 0;
+}
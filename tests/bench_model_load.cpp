@@ -0,0 +1,59 @@
+#include "core/engine.h"
+#include "core/io/mapped_file.h"
+#include "bench_common.h"
+
+/*
+    Model load time with and without the .gmesh cache
+
+    cold: Assimp import + post-processing, cooked and written to user://cache/meshes/
+    warm: the cooked file is memory mapped and uploaded, Assimp is not involved
+
+    sequential: the scene models loaded one after another on the main thread
+    async:      load_models_async, one import job per model, uploads on the main thread
+*/
+
+constexpr const char* MODEL_PATH = "res://sprites/obj/nagonford/Nagonford_Animated.glb";
+constexpr int WARM_RUNS          = 5;
+
+const std::vector<std::string> SCENE_MODELS = {MODEL_PATH, "res://sprites/obj/DamagedHelmet.glb"};
+
+int main(int argc, char* argv[]) {
+    if (!GEngine->initialize(1280, 720, "Model load benchmark")) {
+        return -1;
+    }
+
+    std::string cache_path;
+    {
+        const MappedFile source(MODEL_PATH);
+        cache_path = MeshCache::get_cache_path(MeshCache::compute_key(source.bytes(), ObjectLoader::IMPORT_FLAGS));
+    }
+
+    SDL_RemovePath(FileAccess::globalize_path(cache_path).c_str());
+
+    size_t mesh_count    = 0;
+    const double cold_ms = measure_ms([&] { mesh_count = ObjectLoader::load_model(MODEL_PATH).meshes.size(); });
+
+    double warm_ms = 0.0;
+    for (int i = 0; i < WARM_RUNS; ++i) {
+        warm_ms += measure_ms([&] { ObjectLoader::load_model(MODEL_PATH); });
+    }
+    warm_ms /= WARM_RUNS;
+
+    printf("%s (%zu meshes)\n", MODEL_PATH, mesh_count);
+    printf("cold (assimp + cook): %8.2f ms\n", cold_ms);
+    printf("warm (mapped .gmesh): %8.2f ms  x%.1f\n", warm_ms, cold_ms / warm_ms);
+
+    const double sequential_ms = measure_ms([&] {
+        for (const auto& path : SCENE_MODELS) {
+            ObjectLoader::load_model(path);
+        }
+    });
+
+    // Registers the models in the renderer, measured last
+    const double async_ms = measure_ms([&] { load_models_async(SCENE_MODELS)->wait(); });
+
+    printf("%zu models sequential:  %8.2f ms\n", SCENE_MODELS.size(), sequential_ms);
+    printf("%zu models async:       %8.2f ms  x%.1f\n", SCENE_MODELS.size(), async_ms, sequential_ms / async_ms);
+
+    return 0;
+}
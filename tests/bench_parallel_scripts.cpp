@@ -0,0 +1,115 @@
+#include "core/engine.h"
+#include "bench_common.h"
+
+#include <fstream>
+
+/*
+    Lua scripts on one state vs one state per worker
+
+    ENTITIES entities run the same script, a few dozen math calls and a transform write per update.
+    serial:   the script doesn't declare `parallel`, every entity runs on the main thread state
+    parallel: `parallel = true`, the batch is split over the job system (the main thread takes a share)
+    bulk:     one scripted entity runs the same math over `ecs.each_transform` views, one Lua call per table
+*/
+
+constexpr int FRAMES   = 200;
+constexpr int ENTITIES = 10000;
+
+constexpr const char* SCRIPT_BODY = R"(
+    function update(entity, dt)
+        local x, y, z = ecs.get_position(entity)
+        local angle = 0
+
+        for i = 1, 16 do
+            angle = angle + math.sin(x * i) * math.cos(z * i)
+        end
+
+        ecs.set_position(entity, x + math.cos(angle) * dt, y, z + math.sin(angle) * dt)
+    end
+)";
+
+constexpr const char* BULK_BODY = R"(
+    function update(entity, dt)
+        ecs.each_transform(function(view)
+            -- Methods cached in locals, a per-row `positions:get` would go through the usertype lookup
+            local positions = view.position
+            local get, set  = positions.get, positions.set
+
+            for row = 1, #view do
+                local x, y, z = get(positions, row)
+                local angle = 0
+
+                for i = 1, 16 do
+                    angle = angle + math.sin(x * i) * math.cos(z * i)
+                end
+
+                set(positions, row, x + math.cos(angle) * dt, y, z + math.sin(angle) * dt)
+            end
+        end)
+    end
+)";
+
+double run(const char* path, int workers, bool is_bulk = false) {
+    JobSystem jobs;
+    jobs.initialize(workers);
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world, &jobs);
+
+    for (int i = 0; i < ENTITIES; i++) {
+        auto entity = world.entity().set<Transform3D>({.position = {static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100)}});
+
+        if (!is_bulk) {
+            entity.set<Script>({path});
+        }
+    }
+
+    if (is_bulk) {
+        world.entity().set<Script>({path});
+    }
+
+    // Loads the prototype in every state
+    world.progress(1.0f / 60.0f);
+
+    const double ms = measure_ms([&] {
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            world.progress(1.0f / 60.0f);
+        }
+    });
+
+    jobs.shutdown();
+    return ms / FRAMES;
+}
+
+int main() {
+    std::ofstream("bench_serial.lua") << SCRIPT_BODY;
+    std::ofstream("bench_parallel.lua") << "parallel = true\n" << SCRIPT_BODY;
+    std::ofstream("bench_bulk.lua") << BULK_BODY;
+
+    const int hardware = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
+    printf("%d scripted entities, %d frames\n", ENTITIES, FRAMES);
+
+    const double serial_ms = run("bench_serial.lua", 0);
+    printf("serial (one state):          %.3f ms/frame\n", serial_ms);
+
+    const double bulk_ms = run("bench_bulk.lua", 0, true);
+    printf("bulk (views, one state):     %.3f ms/frame, %.2fx\n", bulk_ms, serial_ms / bulk_ms);
+
+    for (int workers = 1; workers < hardware; workers *= 2) {
+        const double parallel_ms = run("bench_parallel.lua", workers);
+        printf("parallel (%2d workers + main): %.3f ms/frame, %.2fx\n", workers, parallel_ms, serial_ms / parallel_ms);
+    }
+
+    if (hardware > 1) {
+        const double parallel_ms = run("bench_parallel.lua", hardware - 1);
+        printf("parallel (%2d workers + main): %.3f ms/frame, %.2fx\n", hardware - 1, parallel_ms, serial_ms / parallel_ms);
+    }
+
+    std::remove("bench_serial.lua");
+    std::remove("bench_parallel.lua");
+    std::remove("bench_bulk.lua");
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "core/engine.h"
+#include <doctest/doctest.h>
+
+#include <fstream>
+
+namespace {
+
+constexpr const char* FILE_PATH = "test_async_io.bin";
+
+std::string write_test_file(size_t size) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<char>(i * 31 + 7);
+    }
+
+    std::ofstream(FILE_PATH, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+    return data;
+}
+
+void check_reads(const std::string& data) {
+    auto& io = AsyncFileIO::get();
+
+    std::vector<std::byte> range(100);
+    const auto partial = FileAccess::read_async(FILE_PATH, 1000, range.size(), range.data());
+
+    std::atomic<int> callbacks{0};
+    const auto whole = io.read_file(FILE_PATH, IoPriority::HIGH, [&callbacks](AsyncRead& request) {
+        CHECK_EQ(request.get_status(), AsyncReadStatus::DONE);
+        callbacks++;
+    });
+
+    // Past the end of the file: short read, not an error
+    std::vector<std::byte> tail(64);
+    const auto past_end = io.read(FILE_PATH, data.size() - 16, tail.size(), tail.data());
+
+    const auto missing = io.read_file("missing_async_io.bin");
+
+    REQUIRE_EQ(partial->wait(), AsyncReadStatus::DONE);
+    CHECK_EQ(std::memcmp(range.data(), data.data() + 1000, range.size()), 0);
+
+    REQUIRE_EQ(whole->wait(), AsyncReadStatus::DONE);
+    REQUIRE_EQ(whole->bytes().size(), data.size());
+    CHECK_EQ(std::memcmp(whole->bytes().data(), data.data(), data.size()), 0);
+    CHECK_EQ(callbacks.load(), 1);
+
+    REQUIRE_EQ(past_end->wait(), AsyncReadStatus::DONE);
+    CHECK_EQ(past_end->get_bytes_read(), 16);
+
+    CHECK_EQ(missing->wait(), AsyncReadStatus::FAILED);
+
+    // Cancelled reads end up cancelled, or done when they won the race
+    std::vector<AsyncReadHandle> reads;
+    for (int i = 0; i < 256; ++i) {
+        reads.push_back(io.read_file(FILE_PATH, IoPriority::LOW));
+    }
+
+    for (const auto& read : reads) {
+        read->cancel();
+    }
+
+    for (const auto& read : reads) {
+        const auto status = read->wait();
+        CHECK((status == AsyncReadStatus::CANCELLED || status == AsyncReadStatus::DONE));
+    }
+
+    CHECK_EQ(io.get_pending_count(), 0);
+}
+
+} // namespace
+
+TEST_CASE("Async reads through io_uring") {
+    const std::string data = write_test_file(3 * AsyncFileIO::CHUNK_SIZE + 123);
+
+    // Reader threads where io_uring is unavailable
+    REQUIRE(AsyncFileIO::get().initialize(2, true));
+    check_reads(data);
+
+    AsyncFileIO::get().shutdown();
+    std::remove(FILE_PATH);
+}
+
+TEST_CASE("Async reads through the reader threads") {
+    const std::string data = write_test_file(3 * AsyncFileIO::CHUNK_SIZE + 123);
+
+    REQUIRE(AsyncFileIO::get().initialize(2, false));
+    CHECK_FALSE(AsyncFileIO::get().is_io_uring());
+    check_reads(data);
+
+    AsyncFileIO::get().shutdown();
+    std::remove(FILE_PATH);
+}
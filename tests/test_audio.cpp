@@ -0,0 +1,174 @@
+#include "core/engine.h"
+#include <doctest/doctest.h>
+
+#include <fstream>
+
+namespace {
+
+constexpr const char* SOUND_PATH = "test_audio.wav";
+
+/// One second of 16-bit mono sine
+void write_test_sound() {
+    constexpr Uint32 sample_rate = 22050;
+    constexpr Uint32 data_size   = sample_rate * 2;
+
+    std::ofstream file(SOUND_PATH, std::ios::binary);
+
+    const auto put = [&file](auto value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+    file.write("RIFF", 4);
+    put(Uint32{36 + data_size});
+    file.write("WAVEfmt ", 8);
+    put(Uint32{16});
+    put(Uint16{1});
+    put(Uint16{1});
+    put(sample_rate);
+    put(Uint32{sample_rate * 2});
+    put(Uint16{2});
+    put(Uint16{16});
+    file.write("data", 4);
+    put(data_size);
+
+    for (Uint32 i = 0; i < sample_rate; ++i) {
+        put(static_cast<Sint16>(std::sin(static_cast<float>(i) * 0.1f) * 8000.0f));
+    }
+}
+
+AudioDevice null_device(int max_voices) {
+    AudioDevice device;
+    device.is_null_device = true;
+    device.max_voices     = max_voices;
+    return device;
+}
+
+flecs::entity add_source(flecs::world& world, float distance, int priority = 0) {
+    AudioSource source;
+    source.path     = SOUND_PATH;
+    source.priority = priority;
+
+    return world.entity().set(Transform3D{glm::vec3(distance, 0.0f, 0.0f)}).set(source);
+}
+
+} // namespace
+
+TEST_CASE("Audio sources share a fixed voice pool") {
+    write_test_sound();
+
+    // Outlives the world, `ReleaseAudioVoice` runs on it while the world deletes its entities
+    AudioSystem audio;
+    flecs::world world;
+
+    REQUIRE(audio.initialize(null_device(4)));
+    audio.setup(world);
+
+    world.entity().set(Transform3D{}).set(AudioListener{});
+
+    std::vector<flecs::entity> sources;
+    for (int i = 0; i < 10; ++i) {
+        sources.push_back(add_source(world, 1.0f + static_cast<float>(i) * 5.0f));
+    }
+
+    audio.update(0.016f);
+
+    CHECK_EQ(audio.get_stats().sources, 10);
+    CHECK_EQ(audio.get_stats().voices, 4);
+    CHECK_EQ(audio.get_stats().virtual_sources, 6);
+    CHECK_EQ(audio.get_stats().samples, 1);
+
+    // Far away, but more important than every mixed source
+    add_source(world, 500.0f, 10);
+    audio.update(0.016f);
+
+    CHECK_EQ(audio.get_stats().voices, 4);
+    CHECK_EQ(audio.get_stats().stolen, 1);
+
+    // Deleting a mixed source frees its voice for the next loudest
+    sources.front().destruct();
+    audio.update(0.016f);
+
+    CHECK_EQ(audio.get_stats().sources, 10);
+    CHECK_EQ(audio.get_stats().voices, 4);
+    CHECK_EQ(audio.get_stats().stolen, 0);
+
+    audio.shutdown();
+    std::remove(SOUND_PATH);
+}
+
+TEST_CASE("Virtual sources keep playing without a voice") {
+    write_test_sound();
+
+    // Outlives the world, `ReleaseAudioVoice` runs on it while the world deletes its entities
+    AudioSystem audio;
+    flecs::world world;
+
+    REQUIRE(audio.initialize(null_device(1)));
+    audio.setup(world);
+
+    world.entity().set(Transform3D{}).set(AudioListener{});
+
+    add_source(world, 1.0f);
+    const auto far = add_source(world, 50.0f);
+
+    audio.update(0.016f);
+    REQUIRE_EQ(audio.get_stats().virtual_sources, 1);
+
+    // Past the end of the one second sound
+    audio.update(2.0f);
+    CHECK_FALSE(far.get<AudioSource>().is_playing);
+
+    auto& looping      = far.get_mut<AudioSource>();
+    looping.is_looping = true;
+    looping.is_playing = true;
+
+    audio.update(2.0f);
+    audio.update(2.0f);
+    CHECK(far.get<AudioSource>().is_playing);
+
+    audio.shutdown();
+    std::remove(SOUND_PATH);
+}
+
+TEST_CASE("Offline rendering mixes faster than real time") {
+    write_test_sound();
+
+    AudioDevice device;
+    device.is_offline  = true;
+    device.max_voices  = 2;
+    device.sample_rate = 48000;
+
+    // Outlives the world, `ReleaseAudioVoice` runs on it while the world deletes its entities
+    AudioSystem audio;
+    flecs::world world;
+
+    REQUIRE(audio.initialize(device));
+    audio.setup(world);
+
+    world.entity().set(Transform3D{}).set(AudioListener{});
+    add_source(world, 1.0f);
+
+    audio.update(0.0f);
+
+    std::vector<float> output;
+    CHECK_EQ(audio.render(2.0f, output, 480), 96000);
+    REQUIRE_EQ(output.size(), 96000 * 2);
+
+    // The one second sound plays, then silence
+    float peak = 0.0f;
+    for (size_t i = 0; i < 48000 * 2; ++i) {
+        peak = std::max(peak, std::abs(output[i]));
+    }
+
+    CHECK_GT(peak, 0.01f);
+    CHECK_EQ(output.back(), 0.0f);
+
+    const MixerStats stats = audio.get_mixer_stats();
+    CHECK_EQ(stats.callbacks, 200);
+    CHECK_EQ(stats.frames, 96000);
+    CHECK_GE(stats.max_ms, stats.average_ms);
+
+    audio.reset_mixer_stats();
+    CHECK_EQ(audio.get_mixer_stats().callbacks, 0);
+
+    audio.shutdown();
+    std::remove(SOUND_PATH);
+}
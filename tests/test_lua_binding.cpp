@@ -2,19 +2,17 @@
 #include "core/binding/lua.h"
 
 TEST_CASE("Engine Lua Binding - Call Function Error Handling") {
-    Transform2D transform;
-    transform.position = {200, 300};
-    transform.scale    = {1, 1};
-    transform.rotation = 0;
+    Transform3D transform;
+    transform.position = {200, 300, 0};
 
     lua_State* L = luaL_newstate();
     luaL_openlibs(L);
 
     generate_bindings(L);
 
-    auto* ptr = (Transform2D*)lua_newuserdata(L, sizeof(Transform2D));
+    auto* ptr = (Transform3D*)lua_newuserdata(L, sizeof(Transform3D));
     *ptr = transform;
-    luaL_setmetatable(L, "Transform2D");
+    luaL_setmetatable(L, "Transform3D");
     lua_setglobal(L, "transform");
 
     luaL_dostring(L, R"(
@@ -0,0 +1,448 @@
+#include "core/engine.h"
+#include <doctest/doctest.h>
+
+#include <fstream>
+
+namespace {
+
+constexpr const char* MOVER_PATH  = "test_mover.lua";
+constexpr const char* BROKEN_PATH = "test_broken.lua";
+
+void write_scripts() {
+    std::ofstream(MOVER_PATH) << R"(
+        local speed = 2
+
+        function ready(entity)
+            local x, y, z = ecs.get_position(entity)
+            ecs.set_position(entity, x, 10, z)
+        end
+
+        function update(entity, dt)
+            local x, y, z = ecs.get_position(entity)
+            ecs.set_position(entity, x + speed * dt, y, z)
+        end
+    )";
+
+    std::ofstream(BROKEN_PATH) << R"(
+        function update(entity, dt)
+            missing_function()
+        end
+    )";
+}
+
+flecs::entity add_scripted(flecs::world& world, const char* path, float x) {
+    return world.entity().set(Transform3D{glm::vec3(x, 0.0f, 0.0f)}).set(Script{path});
+}
+
+std::string dump_script(const char* source) {
+    lua_State* L = luaL_newstate();
+    std::string bytecode;
+
+    if (luaL_loadstring(L, source) == LUA_OK) {
+        lua_dump(L, [](lua_State*, const void* data, size_t size, void* out) {
+            static_cast<std::string*>(out)->append(static_cast<const char*>(data), size);
+            return 0;
+        }, &bytecode, 1);
+    }
+
+    lua_close(L);
+    return bytecode;
+}
+
+/// Iterating syncs `query`, every table is checked in one pass
+std::vector<const ecs_table_t*> get_changed_tables(const flecs::query<>& query) {
+    std::vector<const ecs_table_t*> tables;
+
+    query.run([&tables](flecs::iter& it) {
+        while (it.next()) {
+            if (it.changed()) {
+                tables.push_back(it.c_ptr()->table);
+            }
+        }
+    });
+
+    return tables;
+}
+
+} // namespace
+
+TEST_CASE("Scripts share one prototype per file") {
+    write_scripts();
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    std::vector<flecs::entity> movers;
+    for (int i = 0; i < 100; ++i) {
+        movers.push_back(add_scripted(world, MOVER_PATH, static_cast<float>(i)));
+    }
+
+    world.progress(0.5f);
+    world.progress(0.5f);
+
+    for (int i = 0; i < 100; ++i) {
+        const auto& transform = movers[i].get<Transform3D>();
+        CHECK_EQ(transform.position.x, static_cast<float>(i) + 2.0f);
+        CHECK_EQ(transform.position.y, 10.0f);
+        CHECK(movers[i].get<Script>().is_ready);
+    }
+
+    CHECK_EQ(scripts.load(MOVER_PATH), movers.front().get<Script>().prototype);
+
+    const auto stats = scripts.get_stats();
+    REQUIRE_EQ(stats.size(), 1);
+    CHECK_EQ(stats[0].instances, 100);
+    CHECK_EQ(stats[0].errors, 0);
+
+    std::remove(MOVER_PATH);
+    std::remove(BROKEN_PATH);
+}
+
+TEST_CASE("A failing script only stops its entity") {
+    write_scripts();
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    const auto mover   = add_scripted(world, MOVER_PATH, 0.0f);
+    const auto broken  = add_scripted(world, BROKEN_PATH, 0.0f);
+    const auto missing = add_scripted(world, "missing_script.lua", 0.0f);
+
+    world.progress(1.0f);
+    world.progress(1.0f);
+
+    CHECK_EQ(mover.get<Transform3D>().position.x, 4.0f);
+    CHECK(broken.get<Script>().is_failed);
+    CHECK(missing.get<Script>().is_failed);
+
+    // Logged once, not every frame
+    const auto stats = scripts.get_stats();
+    REQUIRE_EQ(stats.size(), 2);
+    CHECK_EQ(stats[1].errors, 1);
+    CHECK_EQ(stats[1].instances, 0);
+
+    std::remove(MOVER_PATH);
+    std::remove(BROKEN_PATH);
+}
+
+TEST_CASE("Scripts delete entities at the end of the step") {
+    write_scripts();
+
+    std::ofstream("test_destruct.lua") << R"(
+        function update(entity, dt)
+            ecs.destruct(entity)
+            assert(ecs.is_alive(entity))
+        end
+    )";
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    const auto entity = add_scripted(world, "test_destruct.lua", 0.0f);
+
+    world.progress(1.0f);
+
+    CHECK_FALSE(entity.is_alive());
+
+    std::remove("test_destruct.lua");
+    std::remove(MOVER_PATH);
+    std::remove(BROKEN_PATH);
+}
+
+TEST_CASE("Parallel scripts run on every worker state") {
+    std::ofstream("test_parallel.lua") << R"(
+        parallel = true
+
+        function update(entity, dt)
+            local x, y, z = ecs.get_position(entity)
+            ecs.set_position(entity, x + dt, y, z)
+
+            -- Not their own entity, queued for the main thread
+            if x == 0 then
+                ecs.set_position(ecs.lookup("Target"), 42, 0, 0)
+            elseif x == 1 then
+                ecs.destruct(entity)
+            end
+        end
+    )";
+
+    JobSystem jobs;
+    REQUIRE(jobs.initialize(3));
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world, &jobs);
+
+    const auto target = world.entity("Target").set(Transform3D{});
+
+    std::vector<flecs::entity> entities;
+    for (int i = 0; i < 1000; ++i) {
+        entities.push_back(add_scripted(world, "test_parallel.lua", static_cast<float>(i)));
+    }
+
+    world.progress(0.5f);
+
+    CHECK_EQ(target.get<Transform3D>().position.x, 42.0f);
+    CHECK(entities[0].is_alive());
+    CHECK_FALSE(entities[1].is_alive());
+
+    for (int i = 2; i < 1000; ++i) {
+        CHECK_EQ(entities[i].get<Transform3D>().position.x, static_cast<float>(i) + 0.5f);
+    }
+
+    const auto stats = scripts.get_stats();
+    REQUIRE_EQ(stats.size(), 1);
+    CHECK(stats[0].is_parallel);
+    CHECK_EQ(stats[0].instances, 1000);
+
+    jobs.shutdown();
+    std::remove("test_parallel.lua");
+}
+
+TEST_CASE("Cooked bytecode loads like the source") {
+    // What the asset cooker writes, stripped bytecode next to the source (which would move by 2 * dt)
+    std::ofstream(ScriptSystem::get_cooked_path("test_cooked.lua"), std::ios::binary) << dump_script(R"(
+        function update(entity, dt)
+            local x, y, z = ecs.get_position(entity)
+            ecs.set_position(entity, x + dt, y, z)
+        end
+    )");
+    std::ofstream("test_cooked.lua") << R"(
+        function update(entity, dt)
+            local x, y, z = ecs.get_position(entity)
+            ecs.set_position(entity, x + 2 * dt, y, z)
+        end
+    )";
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    const auto entity = add_scripted(world, "test_cooked.lua", 1.0f);
+
+    world.progress(0.5f);
+
+    CHECK_FALSE(entity.get<Script>().is_failed);
+    CHECK_EQ(entity.get<Transform3D>().position.x, 1.5f);
+
+    std::remove(ScriptSystem::get_cooked_path("test_cooked.lua").c_str());
+    std::remove("test_cooked.lua");
+}
+
+TEST_CASE("Bytecode cooked for another ABI falls back to the source") {
+    std::string bytecode = dump_script("function update(entity, dt) end");
+    REQUIRE_GT(bytecode.size(), 14);
+
+    // Header: signature (4), version, format, LUAC_DATA (6), sizeof(Instruction), then sizeof(lua_Integer) as on a 32-bit target
+    bytecode[13] = static_cast<char>(bytecode[13] == 8 ? 4 : 8);
+
+    std::ofstream(ScriptSystem::get_cooked_path("test_foreign.lua"), std::ios::binary) << bytecode;
+    std::ofstream("test_foreign.lua") << R"(
+        function update(entity, dt)
+            local x, y, z = ecs.get_position(entity)
+            ecs.set_position(entity, x + dt, y, z)
+        end
+    )";
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    const auto entity = add_scripted(world, "test_foreign.lua", 1.0f);
+
+    world.progress(0.5f);
+
+    CHECK_FALSE(entity.get<Script>().is_failed);
+    CHECK_EQ(entity.get<Transform3D>().position.x, 1.5f);
+
+    std::remove(ScriptSystem::get_cooked_path("test_foreign.lua").c_str());
+    std::remove("test_foreign.lua");
+}
+
+TEST_CASE("Garbage collection stays in its budget") {
+    ScriptSystem scripts;
+    scripts.set_gc(false, 1.0f);
+
+    sol::state& lua = scripts.get_state();
+    lua.script("for i = 1, 100000 do local t = {i} end");
+
+    scripts.collect_garbage(0);
+    CHECK_EQ(scripts.get_gc_stats().steps, 0);
+    CHECK_GT(scripts.get_gc_stats().heap_bytes, 0);
+
+    // Enough budget to finish the cycle left by the loop
+    scripts.set_gc(false, 1000.0f);
+    scripts.collect_garbage(1'000'000'000);
+    CHECK_GT(scripts.get_gc_stats().steps, 0);
+    CHECK_EQ(scripts.get_gc_stats().cycles, 1);
+
+    // Generational: a single young collection per frame
+    scripts.set_gc(true, 1.0f);
+    lua.script("for i = 1, 100000 do local t = {i} end");
+    scripts.collect_garbage(1'000'000'000);
+    CHECK_EQ(scripts.get_gc_stats().steps, 1);
+}
+
+TEST_CASE("Bulk views write the table storage") {
+    std::ofstream("test_bulk.lua") << R"(
+        function update(entity, dt)
+            ecs.each_transform(function(view)
+                local positions = view.position
+                for i = 1, #view do
+                    local x, y, z = positions:get(i)
+                    positions:set(i, x + dt, y, z)
+                end
+            end)
+        end
+    )";
+
+    // Keeps the first view it gets, which is stale on the next call
+    std::ofstream("test_stale.lua") << R"(
+        function update(entity, dt)
+            if kept then
+                kept.position:get(1)
+            end
+
+            ecs.each_transform(function(view)
+                kept = kept or view
+            end)
+        end
+    )";
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    const auto manager = world.entity().set(Script{"test_bulk.lua"});
+
+    std::vector<flecs::entity> entities;
+    for (int i = 0; i < 1000; ++i) {
+        // Spread over a few tables
+        auto entity = world.entity().set(Transform3D{glm::vec3(static_cast<float>(i), 0.0f, 0.0f)});
+        if (i % 3 == 0) {
+            entity.add<Static>();
+        }
+        entities.push_back(entity);
+    }
+
+    world.progress(0.5f);
+    world.progress(0.5f);
+
+    CHECK_FALSE(manager.get<Script>().is_failed);
+
+    // Static entities are merged into chunks, views don't reach them
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_EQ(entities[i].get<Transform3D>().position.x, static_cast<float>(i) + (i % 3 == 0 ? 0.0f : 1.0f));
+    }
+
+    const auto stale = world.entity().set(Script{"test_stale.lua"});
+
+    world.progress(0.5f);
+    CHECK_FALSE(stale.get<Script>().is_failed);
+
+    world.progress(0.5f);
+    CHECK(stale.get<Script>().is_failed);
+
+    std::remove("test_bulk.lua");
+    std::remove("test_stale.lua");
+}
+
+TEST_CASE("Writes to other entities mark their table changed") {
+    std::ofstream("test_move_target.lua") << R"(
+        function update(entity, dt)
+            ecs.set_position(ecs.lookup("Target"), 1, 2, 3)
+        end
+    )";
+
+    std::ofstream("test_move_target_parallel.lua") << R"(
+        parallel = true
+
+        function update(entity, dt)
+            ecs.set_position(ecs.lookup("ParallelTarget"), 4, 5, 6)
+        end
+    )";
+
+    JobSystem jobs;
+    REQUIRE(jobs.initialize(2));
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world, &jobs);
+
+    // Neither target has a Script, `RunScripts` doesn't match their tables
+    const auto target          = world.entity("Target").set(Transform3D{});
+    const auto parallel_target = world.entity("ParallelTarget").set(Transform3D{}).add<Static>();
+
+    auto query = world.query_builder().with<Transform3D>().in().cached().detect_changes().build();
+
+    const auto table_of = [&world](flecs::entity entity) { return ecs_get_table(world.c_ptr(), entity.id()); };
+
+    world.entity().set(Script{"test_move_target.lua"});
+    world.entity().set(Script{"test_move_target_parallel.lua"});
+
+    get_changed_tables(query);
+    CHECK(get_changed_tables(query).empty());
+
+    world.progress(0.5f);
+
+    CHECK_EQ(target.get<Transform3D>().position.z, 3.0f);
+    CHECK_EQ(parallel_target.get<Transform3D>().position.z, 6.0f);
+
+    const auto changed = get_changed_tables(query);
+    CHECK(std::ranges::find(changed, table_of(target)) != changed.end());
+    CHECK(std::ranges::find(changed, table_of(parallel_target)) != changed.end());
+
+    jobs.shutdown();
+    std::remove("test_move_target.lua");
+    std::remove("test_move_target_parallel.lua");
+}
+
+TEST_CASE("Bulk views only mark written tables changed") {
+    std::ofstream("test_bulk_read.lua") << R"(
+        function update(entity, dt)
+            ecs.each_transform(function(view)
+                local positions = view.position
+                for i = 1, #view do
+                    local x, y, z = positions:get(i)
+                    if x == 7 then
+                        positions:set(i, x, y + 1, z)
+                    end
+                end
+            end)
+        end
+    )";
+
+    flecs::world world;
+
+    ScriptSystem scripts;
+    scripts.setup(world);
+
+    const auto read_only = world.entity().set(Transform3D{glm::vec3(1.0f, 0.0f, 0.0f)});
+    // Own table, only this one is written
+    const auto written   = world.entity().set(Transform3D{glm::vec3(7.0f, 0.0f, 0.0f)}).add<Camera3D>();
+
+    auto query = world.query_builder().with<Transform3D>().in().cached().detect_changes().build();
+
+    world.entity().set(Script{"test_bulk_read.lua"});
+
+    get_changed_tables(query);
+    world.progress(0.5f);
+
+    const auto changed = get_changed_tables(query);
+    CHECK_EQ(written.get<Transform3D>().position.y, 1.0f);
+    CHECK(std::ranges::find(changed, ecs_get_table(world.c_ptr(), written.id())) != changed.end());
+    CHECK(std::ranges::find(changed, ecs_get_table(world.c_ptr(), read_only.id())) == changed.end());
+
+    std::remove("test_bulk_read.lua");
+}
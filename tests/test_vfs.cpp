@@ -0,0 +1,126 @@
+#include "core/engine.h"
+#include <doctest/doctest.h>
+
+#include <fstream>
+
+namespace {
+
+constexpr const char* PACK_PATH = "test_vfs.pak";
+
+void append_u32(std::string& out, Uint32 value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append_u64(std::string& out, Uint64 value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// zlib stream made of a single uncompressed deflate block, enough to exercise the inflate path
+std::string zlib_store(const std::string& data) {
+    std::string out = "\x78\x01";
+    out += '\x01';
+
+    const Uint16 length = static_cast<Uint16>(data.size());
+    const Uint16 nlength = ~length;
+    out.append(reinterpret_cast<const char*>(&length), 2);
+    out.append(reinterpret_cast<const char*>(&nlength), 2);
+    out += data;
+
+    Uint32 a = 1, b = 0;
+    for (const unsigned char c : data) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+
+    const Uint32 adler = (b << 16) | a;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out += static_cast<char>((adler >> shift) & 0xFF);
+    }
+
+    return out;
+}
+
+/// Same layout as tools/pack_content.py
+void write_pack(const std::vector<std::tuple<std::string, std::string, bool>>& files) {
+    constexpr Uint32 alignment = 16;
+
+    std::vector<std::string> blobs;
+    size_t index_size = 16;
+    for (const auto& [path, data, is_stored] : files) {
+        blobs.push_back(is_stored ? data : zlib_store(data));
+        index_size += 4 + path.size() + 4 + 8 + 4 + 4;
+    }
+
+    std::string out;
+    append_u32(out, PackArchive::MAGIC);
+    append_u32(out, PackArchive::VERSION);
+    append_u32(out, static_cast<Uint32>(files.size()));
+    append_u32(out, alignment);
+
+    size_t offset = (index_size + alignment - 1) / alignment * alignment;
+    std::vector<size_t> offsets;
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& [path, data, is_stored] = files[i];
+
+        append_u32(out, static_cast<Uint32>(path.size()));
+        out += path;
+        append_u32(out, is_stored ? static_cast<Uint32>(PackArchive::ENTRY_STORED) : 0);
+        append_u64(out, offset);
+        append_u32(out, static_cast<Uint32>(blobs[i].size()));
+        append_u32(out, static_cast<Uint32>(data.size()));
+
+        offsets.push_back(offset);
+        offset = (offset + blobs[i].size() + alignment - 1) / alignment * alignment;
+    }
+
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        out.resize(offsets[i], '\0');
+        out += blobs[i];
+    }
+
+    std::ofstream(PACK_PATH, std::ios::binary).write(out.data(), static_cast<std::streamsize>(out.size()));
+}
+
+} // namespace
+
+TEST_CASE("Normalize res paths") {
+    CHECK_EQ(normalize_res_path("res://sprites/obj/../icon.png"), "sprites/icon.png");
+    CHECK_EQ(normalize_res_path("sprites\\./obj//model.glb"), "sprites/obj/model.glb");
+}
+
+TEST_CASE("Read stored and compressed entries from a pack") {
+    write_pack({{"data/stored.txt", "stored entry", true}, {"data/packed.txt", "compressed entry", false}});
+
+    auto& vfs = VirtualFileSystem::get();
+    REQUIRE(vfs.mount_pack(PACK_PATH));
+
+    CHECK(vfs.exists("res://data/stored.txt"));
+    CHECK(FileAccess::file_exists("res://data/packed.txt"));
+    CHECK_FALSE(vfs.exists("res://data/missing.txt"));
+
+    // Stored entries are viewed in place, aligned in the archive
+    const auto view = vfs.view("res://data/stored.txt");
+    REQUIRE_EQ(view.size(), 12);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(view.data()) % 16, 0);
+    CHECK(vfs.view("res://data/packed.txt").empty());
+
+    const auto packed = vfs.read_all("res://data/packed.txt");
+    CHECK_EQ(std::string(packed.begin(), packed.end()), "compressed entry");
+
+    FileAccess file("res://data/packed.txt");
+    REQUIRE(file.is_open());
+    CHECK_EQ(file.get_file_as_str(), "compressed entry");
+
+    const MappedFile mapped("res://data/stored.txt");
+    CHECK_EQ(mapped.data(), view.data());
+
+    vfs.unmount_all();
+    std::remove(PACK_PATH);
+}
+
+TEST_CASE("Packs are only written with power of two alignments") {
+    CHECK_FALSE(PackArchive::write(PACK_PATH, {}, 0));
+    CHECK_FALSE(PackArchive::write(PACK_PATH, {}, 24));
+    CHECK_FALSE(FileAccess::file_exists(PACK_PATH));
+}
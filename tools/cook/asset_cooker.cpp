@@ -0,0 +1,545 @@
+#include "asset_cooker.h"
+#include "core/utility/hash.h"
+#include "core/utility/texture_cache.h"
+
+namespace {
+
+constexpr const char* MANIFEST_FILE   = "cook_manifest.json";
+constexpr const char* DEPENDENCY_FILE = "dependencies.dot";
+
+/// Bumped when a cooker output changes without its format version changing
+constexpr Uint32 SHADER_COOK_VERSION = 1;
+constexpr Uint32 SCRIPT_COOK_VERSION = 3;
+
+std::string get_extension(const std::string& path) {
+    const size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || path.find('/', dot) != std::string::npos) {
+        return {};
+    }
+
+    std::string ext = path.substr(dot + 1);
+    std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext;
+}
+
+Uint32 get_cook_version(CookType type) {
+    switch (type) {
+    case CookType::TEXTURE:
+        return TextureCache::VERSION;
+    case CookType::MESH:
+        return MeshCache::VERSION ^ ObjectLoader::IMPORT_FLAGS;
+    case CookType::SHADER:
+        return SHADER_COOK_VERSION;
+    case CookType::SCRIPT:
+        return SCRIPT_COOK_VERSION;
+    default:
+        return 0;
+    }
+}
+
+/// Comments and indentation removed, line structure kept so preprocessor directives stay intact
+std::string strip_glsl(std::string_view source) {
+    std::string out;
+    out.reserve(source.size());
+
+    std::string line;
+    bool is_block_comment = false;
+
+    const auto flush_line = [&] {
+        const size_t begin = line.find_first_not_of(" \t\r");
+        const size_t end   = line.find_last_not_of(" \t\r");
+
+        if (begin != std::string::npos) {
+            out.append(line, begin, end - begin + 1);
+            out += '\n';
+        }
+
+        line.clear();
+    };
+
+    for (size_t i = 0; i < source.size(); ++i) {
+        const char c    = source[i];
+        const char next = i + 1 < source.size() ? source[i + 1] : '\0';
+
+        if (is_block_comment) {
+            if (c == '*' && next == '/') {
+                is_block_comment = false;
+                ++i;
+            } else if (c == '\n') {
+                flush_line();
+            }
+        } else if (c == '/' && next == '*') {
+            is_block_comment = true;
+            ++i;
+        } else if (c == '/' && next == '/') {
+            while (i < source.size() && source[i] != '\n') {
+                ++i;
+            }
+            flush_line();
+        } else if (c == '\n') {
+            flush_line();
+        } else {
+            line += c;
+        }
+    }
+
+    flush_line();
+    return out;
+}
+
+} // namespace
+
+AssetCooker::AssetCooker(CookSettings settings) : _settings(std::move(settings)) {
+}
+
+bool AssetCooker::run() {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    if (!std::filesystem::is_directory(_settings.source_dir)) {
+        spdlog::error("AssetCooker::run - Source folder {} not found", _settings.source_dir.string());
+        return false;
+    }
+
+    // res:// resolves to the source folder, Assimp side files go through the VFS like at runtime
+    VirtualFileSystem::get().mount_directory(_settings.source_dir.generic_string());
+
+    scan();
+
+    if (!_settings.is_forced) {
+        load_manifest();
+    }
+
+    hash_sources();
+
+    // Unchanged assets keep their outputs, the rest is cooked in parallel
+    std::vector<std::pair<const std::string, CookRecord>*> dirty;
+
+    for (auto& entry : _assets) {
+        auto& [path, record] = entry;
+        const auto previous  = _previous.find(path);
+
+        if (previous != _previous.end() && previous->second.type == record.type) {
+            record.dependencies = previous->second.dependencies;
+            record.outputs      = previous->second.outputs;
+            record.key          = compute_key(record);
+
+            const bool is_up_to_date = record.key == previous->second.key && std::ranges::all_of(record.outputs, [this](const std::string& output) {
+                return std::filesystem::exists(_settings.output_dir / output);
+            });
+
+            if (is_up_to_date) {
+                continue;
+            }
+        }
+
+        dirty.push_back(&entry);
+    }
+
+    GEngine->get_job_system().parallel_for_each(static_cast<int>(dirty.size()), [this, &dirty](int i) {
+        auto& [path, record] = *dirty[i];
+
+        record.outputs.clear();
+        record.dependencies.clear();
+        record.is_cooked = true;
+        record.is_failed = !cook(path, record);
+
+        // Dependencies are only known once cooked, their hashes are final by now
+        record.key = record.is_failed ? 0 : compute_key(record);
+    });
+
+    remove_stale_outputs();
+
+    const bool is_saved = save_manifest() && save_dependency_graph();
+    const bool has_changes = !dirty.empty() || _assets.size() != _previous.size();
+
+    // The pack only changes with its content
+    bool is_packed = true;
+    if (!_settings.pack_path.empty() && (has_changes || _settings.is_forced || !std::filesystem::exists(_settings.pack_path))) {
+        is_packed = write_pack();
+    }
+
+    const auto failed = std::ranges::count_if(_assets, [](const auto& entry) { return entry.second.is_failed; });
+    const double ms   = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    spdlog::info("Cooked {} assets, {} up to date, {} failed in {:.1f} ms", dirty.size() - failed, _assets.size() - dirty.size(), failed, ms);
+
+    return failed == 0 && is_saved && is_packed;
+}
+
+void AssetCooker::scan() {
+    std::error_code error;
+
+    for (auto it = std::filesystem::recursive_directory_iterator(_settings.source_dir, error); !error && it != std::filesystem::recursive_directory_iterator();
+         it.increment(error)) {
+        if (!it->is_regular_file()) {
+            continue;
+        }
+
+        const std::string path = std::filesystem::relative(it->path(), _settings.source_dir).generic_string();
+
+        CookRecord record;
+        record.type  = get_cook_type(path);
+        record.size  = it->file_size();
+        record.mtime = it->last_write_time().time_since_epoch().count();
+
+        _assets.emplace(path, std::move(record));
+    }
+
+    if (error) {
+        spdlog::error("AssetCooker::scan - {}", error.message());
+    }
+}
+
+void AssetCooker::load_manifest() {
+    const std::string manifest_path = (_settings.output_dir / MANIFEST_FILE).generic_string();
+    if (!FileAccess::file_exists(manifest_path)) {
+        return;
+    }
+
+    FileAccess file(manifest_path, ModeFlags::READ);
+    if (!file.is_open()) {
+        return;
+    }
+
+    const Json manifest = Json::parse(file.get_file_as_str(), nullptr, false);
+
+    // Hand-edited or damaged: json type errors and `stoull` throw, nothing from this manifest is trusted then
+    try {
+        if (manifest.is_discarded() || manifest.value("version", 0u) != MANIFEST_VERSION || !manifest.contains("assets")) {
+            spdlog::warn("AssetCooker::load_manifest - Ignoring an outdated manifest, cooking everything");
+            return;
+        }
+
+        for (const auto& [path, entry] : manifest["assets"].items()) {
+            CookRecord record;
+            record.type         = static_cast<CookType>(entry.value("type", static_cast<int>(CookType::COPY)));
+            record.size         = entry.value("size", Uint64{0});
+            record.mtime        = entry.value("mtime", Sint64{0});
+            record.hash         = std::stoull(entry.value("hash", std::string("0")), nullptr, 16);
+            record.key          = std::stoull(entry.value("key", std::string("0")), nullptr, 16);
+            record.outputs      = entry.value("outputs", std::vector<std::string>{});
+            record.dependencies = entry.value("dependencies", std::vector<std::string>{});
+
+            _previous.emplace(path, std::move(record));
+        }
+    } catch (const std::exception& exception) {
+        spdlog::warn("AssetCooker::load_manifest - Ignoring a malformed manifest ({}), cooking everything", exception.what());
+        _previous.clear();
+    }
+}
+
+void AssetCooker::hash_sources() {
+    std::vector<std::pair<const std::string, CookRecord>*> entries;
+    entries.reserve(_assets.size());
+
+    for (auto& entry : _assets) {
+        entries.push_back(&entry);
+    }
+
+    GEngine->get_job_system().parallel_for_each(static_cast<int>(entries.size()), [this, &entries](int i) {
+        auto& [path, record] = *entries[i];
+
+        // Same size and modification time: trusted like make does, the file isn't read
+        if (const auto previous = _previous.find(path);
+            previous != _previous.end() && previous->second.size == record.size && previous->second.mtime == record.mtime) {
+            record.hash = previous->second.hash;
+            return;
+        }
+
+        const MappedFile file((_settings.source_dir / path).generic_string());
+        record.hash = hash_fnv1a_64(file.data(), file.size());
+    });
+}
+
+Uint64 AssetCooker::compute_key(const CookRecord& record) const {
+    const Uint32 version = get_cook_version(record.type);
+
+    Uint64 key = hash_fnv1a_64(&record.hash, sizeof(record.hash));
+    key        = hash_fnv1a_64(&record.type, sizeof(record.type), key);
+    key        = hash_fnv1a_64(&version, sizeof(version), key);
+
+    for (const auto& dependency : record.dependencies) {
+        const auto it           = _assets.find(dependency);
+        const Uint64 dependency_hash = it != _assets.end() ? it->second.hash : 0;
+
+        key = hash_fnv1a_64(dependency.data(), dependency.size(), key);
+        key = hash_fnv1a_64(&dependency_hash, sizeof(dependency_hash), key);
+    }
+
+    return key;
+}
+
+bool AssetCooker::cook(const std::string& path, CookRecord& record) const {
+    switch (record.type) {
+    case CookType::TEXTURE:
+        return cook_texture(path, record);
+    case CookType::MESH:
+        return cook_mesh(path, record);
+    case CookType::SHADER:
+        return cook_shader(path, record);
+    case CookType::SCRIPT:
+        return cook_script(path, record);
+    default:
+        return copy(path, record);
+    }
+}
+
+bool AssetCooker::cook_texture(const std::string& path, CookRecord& record) const {
+    const MappedFile source((_settings.source_dir / path).generic_string());
+
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(source.data()), static_cast<int>(source.size()), &width, &height, &channels, 0);
+
+    if (!pixels) {
+        spdlog::error("AssetCooker::cook_texture - Failed to decode {}: {}", path, stbi_failure_reason());
+        return false;
+    }
+
+    const auto cooked = TextureCache::write(pixels, width, height, channels);
+    stbi_image_free(pixels);
+
+    // The source stays in the pack too, images are also read directly (UI, environment atlas)
+    record.outputs = {TextureCache::get_cooked_path(path), path};
+    return write_output(record.outputs[0], cooked) && copy(path, record);
+}
+
+bool AssetCooker::cook_mesh(const std::string& path, CookRecord& record) const {
+    const MappedFile source((_settings.source_dir / path).generic_string());
+
+    std::vector<char> bytes;
+    std::vector<std::string> dependencies;
+
+    if (!source.is_open() || !ObjectLoader::cook_model("res://" + path, source.bytes(), bytes, &dependencies)) {
+        spdlog::error("AssetCooker::cook_mesh - Failed to import {}", path);
+        return false;
+    }
+
+    for (const auto& dependency : dependencies) {
+        record.dependencies.push_back(normalize_res_path(dependency));
+    }
+
+    // Embedded textures are stored decoded, loading the model doesn't run the png/jpg decoder anymore
+    CookedModel model;
+    if (!MeshCache::read(std::as_bytes(std::span(bytes)), model)) {
+        spdlog::error("AssetCooker::cook_mesh - Cooked {} doesn't read back", path);
+        return false;
+    }
+
+    std::vector<std::unique_ptr<unsigned char, decltype(&stbi_image_free)>> decoded;
+
+    for (auto& texture : model.textures) {
+        if (texture.kind != CookedTextureKind::ENCODED) {
+            continue;
+        }
+
+        int width = 0, height = 0, channels = 0;
+        unsigned char* pixels = stbi_load_from_memory(texture.data.data(), static_cast<int>(texture.data.size()), &width, &height, &channels, 4);
+
+        // Left encoded, the runtime reports it the same way
+        if (!pixels) {
+            continue;
+        }
+
+        decoded.emplace_back(pixels, stbi_image_free);
+        texture = {CookedTextureKind::RAW, static_cast<Uint32>(width), static_cast<Uint32>(height), {pixels, static_cast<size_t>(width) * height * 4}};
+    }
+
+    if (!decoded.empty()) {
+        bytes = MeshCache::write(model);
+    }
+
+    record.outputs = {MeshCache::get_cooked_path(path)};
+    return write_output(record.outputs[0], bytes);
+}
+
+bool AssetCooker::cook_shader(const std::string& path, CookRecord& record) const {
+    const MappedFile source((_settings.source_dir / path).generic_string());
+
+    if (!source.is_open()) {
+        spdlog::error("AssetCooker::cook_shader - Failed to open {}", path);
+        return false;
+    }
+
+    const std::string stripped = strip_glsl({reinterpret_cast<const char*>(source.data()), source.size()});
+
+    record.outputs = {path};
+    return write_output(path, stripped);
+}
+
+bool AssetCooker::cook_script(const std::string& path, CookRecord& record) const {
+    const MappedFile source((_settings.source_dir / path).generic_string());
+
+    if (!source.is_open()) {
+        spdlog::error("AssetCooker::cook_script - Failed to open {}", path);
+        return false;
+    }
+
+    // Syntax errors surface at cook time rather than when the script first runs
+    lua_State* state = luaL_newstate();
+    const std::string chunk_name = "@" + path;
+    const int status = luaL_loadbufferx(state, reinterpret_cast<const char*>(source.data()), source.size(), chunk_name.c_str(), "t");
+
+    // Stripped bytecode, the runtime skips the parser (errors report no line numbers, develop against the sources).
+    // Its header is bound to this host's Lua ABI (size_t, lua_Integer, lua_Number, endianness): the source ships along,
+    // a target that rejects the header loads it instead
+    std::string bytecode;
+
+    if (status != LUA_OK) {
+        spdlog::error("AssetCooker::cook_script - {}", lua_tostring(state, -1));
+    } else {
+        lua_dump(state, [](lua_State*, const void* data, size_t size, void* out) {
+            static_cast<std::string*>(out)->append(static_cast<const char*>(data), size);
+            return 0;
+        }, &bytecode, 1);
+    }
+
+    lua_close(state);
+
+    if (status != LUA_OK) {
+        return false;
+    }
+
+    record.outputs = {ScriptSystem::get_cooked_path(path), path};
+    return write_output(record.outputs[0], bytecode) && copy(path, record);
+}
+
+bool AssetCooker::copy(const std::string& path, CookRecord& record) const {
+    const std::filesystem::path output = _settings.output_dir / path;
+    std::error_code error;
+
+    std::filesystem::create_directories(output.parent_path(), error);
+    std::filesystem::copy_file(_settings.source_dir / path, output, std::filesystem::copy_options::overwrite_existing, error);
+
+    if (error) {
+        spdlog::error("AssetCooker::copy - Failed to copy {}: {}", path, error.message());
+        return false;
+    }
+
+    if (record.outputs.empty()) {
+        record.outputs = {path};
+    }
+
+    return true;
+}
+
+bool AssetCooker::write_output(const std::string& path, std::span<const char> bytes) const {
+    const std::filesystem::path output = _settings.output_dir / path;
+    std::error_code error;
+
+    std::filesystem::create_directories(output.parent_path(), error);
+
+    if (error || !SDL_SaveFile(output.generic_string().c_str(), bytes.data(), bytes.size())) {
+        spdlog::error("AssetCooker::write_output - Failed to write {}: {}", output.generic_string(), error ? error.message() : SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+void AssetCooker::remove_stale_outputs() const {
+    std::unordered_set<std::string> outputs;
+    for (const auto& [path, record] : _assets) {
+        outputs.insert(record.outputs.begin(), record.outputs.end());
+    }
+
+    // Outputs of deleted sources, or an asset that now cooks to other files
+    for (const auto& [path, record] : _previous) {
+        for (const auto& output : record.outputs) {
+            if (!outputs.contains(output)) {
+                std::error_code error;
+                std::filesystem::remove(_settings.output_dir / output, error);
+            }
+        }
+    }
+}
+
+bool AssetCooker::save_manifest() const {
+    Json assets = Json::object();
+
+    for (const auto& [path, record] : _assets) {
+        // Failed assets are left out, the next run retries them
+        if (record.is_failed) {
+            continue;
+        }
+
+        assets[path] = {
+            {"type", static_cast<int>(record.type)},
+            {"size", record.size},
+            {"mtime", record.mtime},
+            {"hash", hash_to_string(record.hash)},
+            {"key", hash_to_string(record.key)},
+            {"outputs", record.outputs},
+            {"dependencies", record.dependencies},
+        };
+    }
+
+    const Json manifest = {{"version", MANIFEST_VERSION}, {"assets", assets}};
+
+    return write_output(MANIFEST_FILE, manifest.dump(2));
+}
+
+bool AssetCooker::save_dependency_graph() const {
+    std::string graph = "digraph cook {\n    rankdir=LR;\n";
+
+    for (const auto& [path, record] : _assets) {
+        graph += fmt::format("    \"{}\" [label=\"{}\\n{}\"];\n", path, path, get_cook_type_str(record.type));
+
+        for (const auto& dependency : record.dependencies) {
+            graph += fmt::format("    \"{}\" -> \"{}\";\n", path, dependency);
+        }
+
+        for (const auto& output : record.outputs) {
+            if (output != path) {
+                graph += fmt::format("    \"{}\" -> \"{}\" [style=dashed];\n", path, output);
+            }
+        }
+    }
+
+    graph += "}\n";
+
+    return write_output(DEPENDENCY_FILE, graph);
+}
+
+bool AssetCooker::write_pack() const {
+    std::vector<PackArchive::Source> files;
+
+    for (const auto& [path, record] : _assets) {
+        for (const auto& output : record.outputs) {
+            files.push_back({output, (_settings.output_dir / output).generic_string()});
+        }
+    }
+
+    if (!PackArchive::write(_settings.pack_path, files)) {
+        return false;
+    }
+
+    spdlog::info("Packed {} files into {}", files.size(), _settings.pack_path);
+    return true;
+}
+
+CookType AssetCooker::get_cook_type(const std::string& path) {
+    static const std::unordered_map<std::string, CookType> types = {
+        {"png", CookType::TEXTURE}, {"jpg", CookType::TEXTURE}, {"jpeg", CookType::TEXTURE}, {"tga", CookType::TEXTURE},
+        {"bmp", CookType::TEXTURE}, {"obj", CookType::MESH},    {"glb", CookType::MESH},     {"gltf", CookType::MESH},
+        {"fbx", CookType::MESH},    {"dae", CookType::MESH},    {"vert", CookType::SHADER},  {"frag", CookType::SHADER},
+        {"glsl", CookType::SHADER}, {"lua", CookType::SCRIPT},
+    };
+
+    const auto it = types.find(get_extension(path));
+    return it != types.end() ? it->second : CookType::COPY;
+}
+
+const char* AssetCooker::get_cook_type_str(CookType type) {
+    switch (type) {
+    case CookType::TEXTURE:
+        return "texture";
+    case CookType::MESH:
+        return "mesh";
+    case CookType::SHADER:
+        return "shader";
+    case CookType::SCRIPT:
+        return "script";
+    default:
+        return "copy";
+    }
+}
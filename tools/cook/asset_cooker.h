@@ -0,0 +1,103 @@
+#pragma once
+#include "core/engine.h"
+
+enum class CookType {
+    TEXTURE, /// png, jpg, ... -> `.gtex` next to the source (the source is kept, UI and environment code read images directly)
+    MESH,    /// obj, glb, ... -> `.gmesh` next to the source, embedded textures pre-decoded
+    SHADER,  /// GLSL, comments and indentation stripped, same path
+    SCRIPT,  /// Lua -> stripped bytecode `.luac` next to the source (the source is kept, targets with another Lua ABI load it)
+    COPY     /// Anything else, copied as-is
+};
+
+struct CookSettings {
+    std::filesystem::path source_dir = "res";
+    std::filesystem::path output_dir = "cooked";
+    std::string pack_path            = "data.pak"; /// Empty to skip the pack
+    int worker_threads               = -1;         /// -1 = one per core
+    bool is_forced                   = false;      /// Ignore the manifest, cook everything
+};
+
+/*!
+
+   @brief Manifest record of one source asset
+   - `key` hashes the source, its dependencies and the cooker version, an unchanged key skips the asset
+
+   @version 0.0.5
+*/
+struct CookRecord {
+    CookType type = CookType::COPY;
+
+    Uint64 size  = 0;
+    Sint64 mtime = 0;
+    Uint64 hash  = 0; /// Content hash, only recomputed when size or mtime changed
+    Uint64 key   = 0;
+
+    std::vector<std::string> outputs;      /// Relative to the output folder, same as their `res://` path
+    std::vector<std::string> dependencies; /// Other source assets read while cooking (OBJ .mtl, glTF .bin)
+
+    bool is_cooked = false; /// Cooked by this run, false when skipped
+    bool is_failed = false;
+};
+
+/*!
+
+   @brief Offline asset cooker behind the `golias_cook` tool
+
+   - Walks the source folder, hashes and cooks every asset on the job system workers
+   - `cook_manifest.json` in the output folder keeps hashes, outputs and dependencies, unchanged assets are skipped on re-runs
+   - Writes the dependency graph (`dependencies.dot`) and a stored pack of the output folder, mountable on `res://`
+
+   @version 0.0.5
+*/
+class AssetCooker {
+public:
+    static constexpr Uint32 MANIFEST_VERSION = 1;
+
+    explicit AssetCooker(CookSettings settings);
+
+    /*!
+        @brief Cook, then write the manifest, the dependency graph and the pack
+        @return false when an asset failed to cook, the others are still written
+    */
+    bool run();
+
+private:
+    CookSettings _settings;
+
+    std::map<std::string, CookRecord> _assets;   ///< Sorted, the pack layout is deterministic
+    std::map<std::string, CookRecord> _previous; ///< Manifest of the last run
+
+    void scan();
+
+    void load_manifest();
+
+    void hash_sources();
+
+    [[nodiscard]] Uint64 compute_key(const CookRecord& record) const;
+
+    bool cook(const std::string& path, CookRecord& record) const;
+
+    bool cook_texture(const std::string& path, CookRecord& record) const;
+
+    bool cook_mesh(const std::string& path, CookRecord& record) const;
+
+    bool cook_shader(const std::string& path, CookRecord& record) const;
+
+    bool cook_script(const std::string& path, CookRecord& record) const;
+
+    bool copy(const std::string& path, CookRecord& record) const;
+
+    bool write_output(const std::string& path, std::span<const char> bytes) const;
+
+    void remove_stale_outputs() const;
+
+    bool save_manifest() const;
+
+    bool save_dependency_graph() const;
+
+    bool write_pack() const;
+
+    static CookType get_cook_type(const std::string& path);
+
+    static const char* get_cook_type_str(CookType type);
+};
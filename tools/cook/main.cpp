@@ -0,0 +1,54 @@
+#include "asset_cooker.h"
+
+/*
+    golias_cook - cooks res/ into runtime formats and packs them
+
+    usage: golias_cook [--res <dir>] [--out <dir>] [--pack <file>|--no-pack] [--jobs <n>] [--force]
+
+    Mount the pack (or the output folder) in project.xml:
+        <resources><pack>data.pak</pack></resources>
+*/
+
+void print_usage() {
+    printf("usage: golias_cook [--res <dir>] [--out <dir>] [--pack <file>|--no-pack] [--jobs <n>] [--force]\n");
+    printf("  --res      source assets folder (default: res)\n");
+    printf("  --out      cooked output folder, holds the manifest (default: cooked)\n");
+    printf("  --pack     pack written from the output folder (default: data.pak)\n");
+    printf("  --no-pack  only write the output folder\n");
+    printf("  --jobs     worker threads, -1 = one per core (default: -1)\n");
+    printf("  --force    ignore the manifest and cook everything\n");
+}
+
+int main(int argc, char* argv[]) {
+    CookSettings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value       = i + 1 < argc;
+
+        if (arg == "--res" && has_value) {
+            settings.source_dir = argv[++i];
+        } else if (arg == "--out" && has_value) {
+            settings.output_dir = argv[++i];
+        } else if (arg == "--pack" && has_value) {
+            settings.pack_path = argv[++i];
+        } else if (arg == "--no-pack") {
+            settings.pack_path.clear();
+        } else if (arg == "--jobs" && has_value) {
+            settings.worker_threads = std::atoi(argv[++i]);
+        } else if (arg == "--force") {
+            settings.is_forced = true;
+        } else {
+            print_usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (!GEngine->get_job_system().initialize(settings.worker_threads)) {
+        spdlog::error("Failed to start the job system");
+        return 1;
+    }
+
+    AssetCooker cooker(settings);
+    return cooker.run() ? 0 : 1;
+}
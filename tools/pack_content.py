@@ -1,27 +1,77 @@
-import os, sys, zlib, struct
+import os, sys, zlib, struct, argparse
 
-def pack(folder, out_file):
+# Version 2 layout, read by PackArchive (engine/public/core/io/vfs.h)
+#   header: magic "EPAK", version, file_count, alignment
+#   index:  path_length, path, flags, offset, packed_size, size (per file)
+#   data:   one blob per file, each starting on an `alignment` boundary
+# Stored entries are kept uncompressed so the engine reads them in place from the mapped archive
+PACK_MAGIC = 0x4B415045
+PACK_VERSION = 2
+ENTRY_STORED = 1
+
+# Already compressed formats, zlib gains nothing on them
+DEFAULT_STORED = "png,jpg,jpeg,ogg,mp3,glb,gmesh,ttf,otf"
+
+def align_up(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def pack(folder, out_file, alignment=16, stored_exts=(), min_ratio=0.9):
     files = []
     for root, _, fs in os.walk(folder):
         for f in fs:
             path = os.path.join(root, f)
             rel = os.path.relpath(path, folder).replace("\\", "/")
             files.append(rel)
+    files.sort()
+
+    entries = []
+    for rel in files:
+        data = open(os.path.join(folder, rel), "rb").read()
+        ext = os.path.splitext(rel)[1][1:].lower()
+
+        flags, blob = ENTRY_STORED, data
+        if ext not in stored_exts:
+            comp = zlib.compress(data, 9)
+            # Not worth inflating at runtime when it barely shrinks
+            if len(comp) < len(data) * min_ratio:
+                flags, blob = 0, comp
+
+        entries.append((rel.encode(), flags, blob, len(data)))
+
+    index_size = 16 + sum(4 + len(path) + 4 + 8 + 4 + 4 for path, _, _, _ in entries)
+
+    offsets = []
+    offset = align_up(index_size, alignment)
+    for _, _, blob, _ in entries:
+        offsets.append(offset)
+        offset = align_up(offset + len(blob), alignment)
 
     with open(out_file, "wb") as out:
-        out.write(struct.pack("<I", len(files)))  # file_count
-        for rel in files:
-            path = os.path.join(folder, rel)
-            data = open(path, "rb").read()
-            comp = zlib.compress(data)
-            out.write(struct.pack("<I", len(rel))) # path_length
-            out.write(rel.encode())
-            out.write(struct.pack("<II", len(comp), len(data))) # comp_size, orig_size
-            out.write(comp)
-
-    print(f"✅ Packed {len(files)} files into {out_file}")
+        out.write(struct.pack("<IIII", PACK_MAGIC, PACK_VERSION, len(entries), alignment))
+        for (path, flags, blob, size), blob_offset in zip(entries, offsets):
+            out.write(struct.pack("<I", len(path))) # path_length
+            out.write(path)
+            out.write(struct.pack("<IQII", flags, blob_offset, len(blob), size)) # flags, offset, packed_size, size
+
+        for (_, _, blob, _), blob_offset in zip(entries, offsets):
+            out.write(b"\0" * (blob_offset - out.tell()))
+            out.write(blob)
+
+    stored = sum(1 for _, flags, _, _ in entries if flags & ENTRY_STORED)
+    print(f"✅ Packed {len(entries)} files into {out_file} ({stored} stored, {len(entries) - stored} compressed)")
     print(f"✅ Source folder: {folder}")
     print(f"✅ Output file: {out_file}")
 
 if __name__ == "__main__":
-    pack(sys.argv[1], sys.argv[2])
\ No newline at end of file
+    parser = argparse.ArgumentParser(description="Pack a folder into an archive mountable on res://")
+    parser.add_argument("folder")
+    parser.add_argument("out_file")
+    parser.add_argument("--align", type=int, default=16, help="blob alignment in bytes (power of two)")
+    parser.add_argument("--store", default=DEFAULT_STORED, help="comma separated extensions kept uncompressed")
+    parser.add_argument("--min-ratio", type=float, default=0.9, help="store files compressing above this ratio")
+    args = parser.parse_args()
+
+    if args.align <= 0 or args.align & (args.align - 1):
+        sys.exit("--align must be a power of two")
+
+    pack(args.folder, args.out_file, args.align, {e.strip().lower() for e in args.store.split(",") if e.strip()}, args.min_ratio)